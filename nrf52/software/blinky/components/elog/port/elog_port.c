@@ -27,6 +27,7 @@
  */
 
 #include "elog.h"
+#include <elog_flash.h>
 #include <stdio.h>
 #include <nrf.h>
 #include <nrf_drv_uart.h>
@@ -52,6 +53,10 @@ ElogErrCode elog_port_init(void) {
     nrf_drv_uart_uninit(&uart_dev);
     nrf_drv_uart_init(&uart_dev, &uart_config, NULL);
 
+#ifdef ELOG_FLASH_ENABLE
+    /* initialize flash log plugin, the log will not be saved when it's failed */
+    elog_flash_init();
+#endif
 
     return result;
 }
@@ -65,9 +70,25 @@ ElogErrCode elog_port_init(void) {
 void elog_port_output(const char *log, size_t size) {
     /* output to uart port */
     nrf_drv_uart_tx(&uart_dev, (uint8_t *)log, size);
-    //TODO output to flash
+#ifdef ELOG_FLASH_ENABLE
+    /* output to flash */
+    elog_flash_write(log, size);
+#endif
 }
 
+#ifdef ELOG_FLASH_ENABLE
+/**
+ * output flash saved log port interface
+ * @note It's here because it shares the UART instance with EasyLogger output.
+ *
+ * @param log flash saved log, it must be in RAM for UART EasyDMA
+ * @param size log size
+ */
+void elog_flash_port_output(const char *log, size_t size) {
+    nrf_drv_uart_tx(&uart_dev, (uint8_t *)log, size);
+}
+#endif /* ELOG_FLASH_ENABLE */
+
 /**
  * output lock
  */
@@ -44,6 +44,9 @@
  * 2012-06-02     lgnq         add list_memheap
  * 2012-10-22     Bernard      add MS VC++ patch.
  * 2016-06-02     armink       beautify the list_thread command
+ * 2026-10-17     agent        show the longest interrupt disabled window of timer in list_timer
+ * 2026-10-17     agent        add list_rwlock
+ * 2026-10-17     agent        complete the function by the sorted index of system call table
  */
 
 #include <rtthread.h>
@@ -387,6 +390,57 @@ FINSH_FUNCTION_EXPORT(list_msgqueue, list message queue in system);
 MSH_CMD_EXPORT(list_msgqueue, list message queue in system);
 #endif
 
+#ifdef RT_USING_RWLOCK
+static long _list_rwlock(struct rt_list_node *list)
+{
+    int maxlen;
+    struct rt_rwlock *m;
+    struct rt_list_node *node;
+    int item_title_len;
+    const char *item_title = "rwlock";
+
+    item_title_len = rt_strlen(item_title);
+    maxlen = object_name_maxlen(list);
+    if(maxlen < item_title_len) maxlen = item_title_len;
+
+    rt_kprintf("%-*.s   owner  hold readers writer reader\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " -------- ---- ------- ------ ------\n");
+    for (node = list->next; node != list; node = node->next)
+    {
+        m = (struct rt_rwlock *)(rt_list_entry(node, struct rt_object, list));
+        rt_kprintf("%-*.*s %-8.*s %04d %04d    %-6d %d",
+                   maxlen, RT_NAME_MAX,
+                   m->parent.parent.name,
+                   RT_NAME_MAX,
+                   m->owner != RT_NULL ? m->owner->name : "-",
+                   m->hold,
+                   m->readers,
+                   rt_list_len(&m->parent.suspend_thread),
+                   rt_list_len(&m->suspend_reader_thread));
+        if (!rt_list_isempty(&m->parent.suspend_thread))
+        {
+            rt_kprintf(" writer:");
+            show_wait_queue(&(m->parent.suspend_thread));
+        }
+        if (!rt_list_isempty(&m->suspend_reader_thread))
+        {
+            rt_kprintf(" reader:");
+            show_wait_queue(&(m->suspend_reader_thread));
+        }
+        rt_kprintf("\n");
+    }
+
+    return 0;
+}
+
+long list_rwlock(void)
+{
+    return _list_rwlock(&rt_object_container[RT_Object_Class_RWLock].object_list);
+}
+FINSH_FUNCTION_EXPORT(list_rwlock, list reader/writer lock in system);
+MSH_CMD_EXPORT(list_rwlock, list reader/writer lock in system);
+#endif
+
 #ifdef RT_USING_MEMHEAP
 static long _list_memheap(struct rt_list_node *list)
 {
@@ -495,6 +549,9 @@ static long _list_timer(struct rt_list_node *list)
     }
 
     rt_kprintf("current tick:0x%08x\n", rt_tick_get());
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+    rt_kprintf("max irq off :%d cycles\n", rt_timer_irqoff_max(RT_FALSE));
+#endif
 
     return 0;
 }
@@ -661,6 +718,11 @@ int list_mod_detail(const char *name)
             tlist = &module->module_object[RT_Object_Class_MessageQueue].object_list;
             if (!rt_list_isempty(tlist)) _list_msgqueue(tlist);
 #endif
+#ifdef RT_USING_RWLOCK
+            /* list reader/writer lock in module */
+            tlist = &module->module_object[RT_Object_Class_RWLock].object_list;
+            if (!rt_list_isempty(tlist)) _list_rwlock(tlist);
+#endif
 #ifdef RT_USING_MEMHEAP
             /* list memory heap in module */
             tlist = &module->module_object[RT_Object_Class_MemHeap].object_list;
@@ -789,6 +851,41 @@ static int str_common(const char *str1, const char *str2)
     return (str - str1);
 }
 
+static void list_prefix_syscall(const char *prefix, struct finsh_syscall *index,
+                                rt_uint16_t *func_cnt, const char **name_ptr, int *min_length)
+{
+    int length;
+
+    if (*func_cnt == 0)
+    {
+        rt_kprintf("--function:\n");
+
+        if (*prefix != 0)
+        {
+            /* set name_ptr */
+            *name_ptr = index->name;
+
+            /* set initial length */
+            *min_length = strlen(*name_ptr);
+        }
+    }
+
+    (*func_cnt) ++;
+
+    if (*prefix != 0)
+    {
+        length = str_common(*name_ptr, index->name);
+        if (length < *min_length)
+            *min_length = length;
+    }
+
+#ifdef FINSH_USING_DESCRIPTION
+    rt_kprintf("%-16s -- %s\n", index->name, index->desc);
+#else
+    rt_kprintf("%s\n", index->name);
+#endif
+}
+
 void list_prefix(char *prefix)
 {
     struct finsh_syscall_item *syscall_item;
@@ -803,6 +900,28 @@ void list_prefix(char *prefix)
     name_ptr = RT_NULL;
 
     /* checks in system function call */
+#ifdef FINSH_USING_SYMTAB_INDEX
+    if (_syscall_index != RT_NULL)
+    {
+        struct finsh_syscall *index;
+        rt_size_t position;
+
+        /* the functions which start with prefix are adjacent in the sorted index */
+        for (position = finsh_syscall_index_lower("", prefix, strlen(prefix));
+                position < _syscall_index_count;
+                position ++)
+        {
+            index = _syscall_index[position];
+            if (str_is_prefix(prefix, index->name) != 0) break;
+
+            /* skip internal command */
+            if (str_is_prefix("__", index->name) == 0) continue;
+
+            list_prefix_syscall(prefix, index, &func_cnt, &name_ptr, &min_length);
+        }
+    }
+    else
+#endif
     {
         struct finsh_syscall *index;
         for (index = _syscall_table_begin;
@@ -813,36 +932,7 @@ void list_prefix(char *prefix)
             if (str_is_prefix("__", index->name) == 0) continue;
 
             if (str_is_prefix(prefix, index->name) == 0)
-            {
-                if (func_cnt == 0)
-                {
-                    rt_kprintf("--function:\n");
-
-                    if (*prefix != 0)
-                    {
-                        /* set name_ptr */
-                        name_ptr = index->name;
-
-                        /* set initial length */
-                        min_length = strlen(name_ptr);
-                    }
-                }
-
-                func_cnt ++;
-
-                if (*prefix != 0)
-                {
-                    length = str_common(name_ptr, index->name);
-                    if (length < min_length)
-                        min_length = length;
-                }
-
-#ifdef FINSH_USING_DESCRIPTION
-                rt_kprintf("%-16s -- %s\n", index->name, index->desc);
-#else
-                rt_kprintf("%s\n", index->name);
-#endif
-            }
+                list_prefix_syscall(prefix, index, &func_cnt, &name_ptr, &min_length);
         }
     }
 
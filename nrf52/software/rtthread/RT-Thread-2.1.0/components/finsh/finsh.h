@@ -10,6 +10,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2010-03-22     Bernard      first version
+ * 2026-10-17     agent        add the sorted index of system call table
  */
 #ifndef __FINSH_H__
 #define __FINSH_H__
@@ -137,6 +138,20 @@ extern struct finsh_syscall_item *global_syscall_list;
 /* find out system call, which should be implemented in user program */
 struct finsh_syscall* finsh_syscall_lookup(const char* name);
 
+#ifdef FINSH_USING_SYMTAB_INDEX
+#ifndef RT_USING_HEAP
+#error "the FINSH_USING_SYMTAB_INDEX needs RT_USING_HEAP"
+#endif
+
+/* the system calls sorted by name, it's RT_NULL when there is no memory for it */
+extern struct finsh_syscall **_syscall_index;
+extern rt_size_t _syscall_index_count;
+
+rt_size_t finsh_syscall_index_lower(const char *prefix, const char *name, rt_size_t size);
+struct finsh_syscall *finsh_syscall_index_find(const char *prefix, const char *name, rt_size_t size);
+int finsh_syscall_index_match(struct finsh_syscall *call, const char *prefix, const char *name, rt_size_t size);
+#endif
+
 /* system variable table */
 struct finsh_sysvar
 {
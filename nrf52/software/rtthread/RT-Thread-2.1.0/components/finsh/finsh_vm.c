@@ -25,6 +25,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2010-03-22     Bernard      first version
+ * 2026-10-17     agent        lookup the system call by the sorted index
  */
 #include <finsh.h>
 
@@ -124,6 +125,15 @@ struct finsh_syscall* finsh_syscall_lookup(const char* name)
 	struct finsh_syscall* index;
 	struct finsh_syscall_item* item;
 
+#ifdef FINSH_USING_SYMTAB_INDEX
+	if (_syscall_index != RT_NULL)
+	{
+		index = finsh_syscall_index_find("", name, strlen(name));
+		if (index != NULL)
+			return index;
+	}
+	else
+#endif
 	for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
 	{
 		if (strcmp(index->name, name) == 0)
@@ -26,6 +26,8 @@
  * Date           Author       Notes
  * 2013-03-30     Bernard      the first verion for finsh
  * 2014-01-03     Bernard      msh can execute module.
+ * 2026-10-17     agent        find and complete the command by the sorted index of system call table.
+ * 2026-10-17     agent        hide the internal command which starts with "__" from help and completion.
  */
 
 #include "msh.h"
@@ -37,6 +39,8 @@
 #endif
 
 #define RT_FINSH_ARG_MAX    10
+/* the internal command, such as the helper of bench, is executable but hidden from help and completion */
+#define MSH_CMD_IS_INTERNAL(name)   (strncmp(name, "__", 2) == 0)
 typedef int (*cmd_function_t)(int argc, char **argv);
 
 #ifdef FINSH_USING_MSH
@@ -85,6 +89,8 @@ int msh_help(int argc, char **argv)
                 FINSH_NEXT_SYSCALL(index))
         {
             if (strncmp(index->name, "__cmd_", 6) != 0) continue;
+            /* skip the internal command */
+            if (MSH_CMD_IS_INTERNAL(&index->name[6])) continue;
 #if defined(FINSH_USING_DESCRIPTION) && defined(FINSH_USING_SYMTAB)
             rt_kprintf("%-16s - %s\n", &index->name[6], index->desc);
 #else
@@ -160,6 +166,17 @@ static cmd_function_t msh_get_cmd(char *cmd, int size)
     struct finsh_syscall *index;
     cmd_function_t cmd_func = RT_NULL;
 
+#ifdef FINSH_USING_SYMTAB_INDEX
+    if (_syscall_index != RT_NULL)
+    {
+        index = finsh_syscall_index_find("__cmd_", cmd, size);
+        if (index != RT_NULL)
+            cmd_func = (cmd_function_t)index->func;
+
+        return cmd_func;
+    }
+#endif
+
     for (index = _syscall_table_begin;
             index < _syscall_table_end;
             FINSH_NEXT_SYSCALL(index))
@@ -486,9 +503,28 @@ void msh_auto_complete_path(char *path)
 }
 #endif
 
+static void msh_auto_complete_cmd(const char *cmd_name, const char **name_ptr, int *min_length)
+{
+    int length;
+
+    if (*min_length == 0)
+    {
+        /* set name_ptr */
+        *name_ptr = cmd_name;
+        /* set initial length */
+        *min_length = strlen(*name_ptr);
+    }
+
+    length = str_common(*name_ptr, cmd_name);
+    if (length < *min_length)
+        *min_length = length;
+
+    rt_kprintf("%s\n", cmd_name);
+}
+
 void msh_auto_complete(char *prefix)
 {
-    int length, min_length;
+    int min_length;
     const char *name_ptr, *cmd_name;
     struct finsh_syscall *index;
 
@@ -530,6 +566,28 @@ void msh_auto_complete(char *prefix)
 #endif
 
     /* checks in internal command */
+#ifdef FINSH_USING_SYMTAB_INDEX
+    if (_syscall_index != RT_NULL)
+    {
+        rt_size_t position, prefix_length = strlen(prefix);
+
+        /* the commands which start with prefix are adjacent in the sorted index */
+        for (position = finsh_syscall_index_lower("__cmd_", prefix, prefix_length);
+                position < _syscall_index_count;
+                position ++)
+        {
+            index = _syscall_index[position];
+            if (strncmp(index->name, "__cmd_", 6) != 0 ||
+                    strncmp(&index->name[6], prefix, prefix_length) != 0)
+                break;
+            /* skip the internal command */
+            if (MSH_CMD_IS_INTERNAL(&index->name[6])) continue;
+
+            msh_auto_complete_cmd((const char *) &index->name[6], &name_ptr, &min_length);
+        }
+    }
+    else
+#endif
     {
         for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
         {
@@ -537,22 +595,10 @@ void msh_auto_complete(char *prefix)
             if (strncmp(index->name, "__cmd_", 6) != 0) continue;
 
             cmd_name = (const char *) &index->name[6];
+            /* skip the internal command */
+            if (MSH_CMD_IS_INTERNAL(cmd_name)) continue;
             if (strncmp(prefix, cmd_name, strlen(prefix)) == 0)
-            {
-                if (min_length == 0)
-                {
-                    /* set name_ptr */
-                    name_ptr = cmd_name;
-                    /* set initial length */
-                    min_length = strlen(name_ptr);
-                }
-
-                length = str_common(name_ptr, cmd_name);
-                if (length < min_length)
-                    min_length = length;
-
-                rt_kprintf("%s\n", cmd_name);
-            }
+                msh_auto_complete_cmd(cmd_name, &name_ptr, &min_length);
         }
     }
 
@@ -34,6 +34,11 @@
  * 2011-02-23     Bernard      fix variable section end issue of finsh shell
  *                             initialization when use GNU GCC compiler.
  * 2016-11-26     armink       add password authentication
+ * 2026-10-17     agent        receive by DMA when the shell device supports it
+ * 2026-10-17     agent        set the rx indicate before open the shell device
+ * 2026-10-17     agent        sort the system call table by name for msh dispatch and completion
+ * 2026-10-17     agent        add the script mode, the CRC framed lines are read in bulk and executed without echo
+ * 2026-10-17     agent        read the device until it's empty after a line, the DMA RX indicates a block once
  */
 
 #include <rthw.h>
@@ -49,6 +54,9 @@
 #include <stdio.h> /* for putchar */
 #endif
 
+/* the shell device receives by DMA when it's supported, so the pasted script won't be dropped */
+#define FINSH_DEVICE_RX_FLAG(dev)      (((dev)->flag & RT_DEVICE_FLAG_DMA_RX) ? RT_DEVICE_FLAG_DMA_RX : RT_DEVICE_FLAG_INT_RX)
+
 /* finsh thread */
 static struct rt_thread finsh_thread;
 ALIGN(RT_ALIGN_SIZE)
@@ -113,8 +121,10 @@ void finsh_set_device(const char *device_name)
 
     /* check whether it's a same device */
     if (dev == shell->device) return;
+    /* the data maybe received when device is opening, so set the rx indicate first */
+    rt_device_set_rx_indicate(dev, finsh_rx_ind);
     /* open this device and set the new device in finsh shell */
-    if (rt_device_open(dev, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX | \
+    if (rt_device_open(dev, RT_DEVICE_OFLAG_RDWR | FINSH_DEVICE_RX_FLAG(dev) | \
                        RT_DEVICE_FLAG_STREAM) == RT_EOK)
     {
         if (shell->device != RT_NULL)
@@ -129,7 +139,10 @@ void finsh_set_device(const char *device_name)
         shell->line_curpos = shell->line_position = 0;
 
         shell->device = dev;
-        rt_device_set_rx_indicate(dev, finsh_rx_ind);
+    }
+    else
+    {
+        rt_device_set_rx_indicate(dev, RT_NULL);
     }
 }
 
@@ -380,6 +393,181 @@ static void shell_push_history(struct finsh_shell *shell)
 }
 #endif
 
+#ifdef FINSH_USING_SCRIPT
+/* CRC-16/CCITT-FALSE, poly 0x1021 and init 0xFFFF */
+static rt_uint16_t finsh_script_crc16(const char *data, rt_size_t size)
+{
+    rt_uint16_t crc = 0xFFFF;
+    rt_size_t i, bit;
+
+    for (i = 0; i < size; i++)
+    {
+        crc ^= (rt_uint16_t)((rt_uint8_t)data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (rt_uint16_t)((crc << 1) ^ 0x1021) : (rt_uint16_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+/* the frame is '<command>#<CRC-16 of command in 4 hex digits>', it returns the length of command or -1 */
+static int finsh_script_unframe(const char *line, rt_size_t length)
+{
+    rt_uint16_t crc = 0;
+    rt_size_t i;
+    char ch;
+
+    if (length < 5 || line[length - 5] != '#')
+        return -1;
+
+    for (i = length - 4; i < length; i++)
+    {
+        ch = line[i];
+        if (ch >= '0' && ch <= '9') crc = (crc << 4) | (ch - '0');
+        else if (ch >= 'A' && ch <= 'F') crc = (crc << 4) | (ch - 'A' + 10);
+        else if (ch >= 'a' && ch <= 'f') crc = (crc << 4) | (ch - 'a' + 10);
+        else return -1;
+    }
+
+    if (finsh_script_crc16(line, length - 5) != crc)
+        return -1;
+
+    return length - 5;
+}
+
+static void finsh_script_end(void)
+{
+    rt_tick_t tick = rt_tick_get() - shell->script_tick;
+
+    rt_kprintf("#end %d lines %d errors %d ms\n", shell->script_lines, shell->script_errors,
+               tick * 1000 / RT_TICK_PER_SECOND);
+    shell->script_mode = 0;
+    rt_kprintf(FINSH_PROMPT);
+}
+
+/* execute a line of script, the result of command is streamed back, only the failed line is reported */
+static void finsh_script_line(char *line, rt_size_t length)
+{
+    int cmd_length;
+
+    if (length == 0)
+        return;
+
+    if (length == 10 && strncmp(line, "script end", 10) == 0)
+    {
+        finsh_script_end();
+        return;
+    }
+
+    shell->script_lines ++;
+
+    cmd_length = finsh_script_unframe(line, length);
+    if (cmd_length < 0)
+    {
+        shell->script_errors ++;
+        rt_kprintf("#%d crc error\n", shell->script_lines);
+        return;
+    }
+
+    line[cmd_length] = '\0';
+    msh_exec(line, cmd_length);
+}
+
+/* read the script in bulk, there is no echo, history and line editing */
+static void finsh_script_rx(void)
+{
+    rt_size_t size;
+    char ch;
+
+    /* the rx semaphore is released for every received byte (or every DMA block), the device is read
+     * until it's empty, so the count of the data which has been read is dropped */
+    rt_sem_control(&shell->rx_sem, RT_IPC_CMD_RESET, 0);
+
+    while (shell->script_mode)
+    {
+        if (shell->script_get == shell->script_size)
+        {
+            size = rt_device_read(shell->device, 0, shell->script_buf, sizeof(shell->script_buf));
+            if (size == 0)
+                break;
+
+            shell->script_get = 0;
+            shell->script_size = size;
+        }
+
+        ch = shell->script_buf[shell->script_get++];
+        if (ch == '\r' || ch == '\n')
+        {
+            if (shell->line_position < FINSH_CMD_SIZE)
+                finsh_script_line(shell->line, shell->line_position);
+            else
+            {
+                shell->script_lines ++;
+                shell->script_errors ++;
+                rt_kprintf("#%d too long\n", shell->script_lines);
+            }
+
+            memset(shell->line, 0, sizeof(shell->line));
+            shell->line_position = 0;
+        }
+        else if (ch == 0x03)
+        {
+            /* Ctrl+C, abort the script */
+            memset(shell->line, 0, sizeof(shell->line));
+            shell->line_position = 0;
+            finsh_script_end();
+        }
+        else if (shell->line_position < FINSH_CMD_SIZE)
+        {
+            shell->line[shell->line_position++] = ch;
+        }
+        else
+        {
+            /* it's a long line, it will be discarded at the end of line */
+            shell->line_position = FINSH_CMD_SIZE;
+        }
+    }
+
+    /* wake up the shell for the rest after the end of script */
+    if (shell->script_get < shell->script_size)
+        rt_sem_release(&shell->rx_sem);
+}
+
+static int finsh_script(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "begin") == 0)
+    {
+        shell->script_mode = 1;
+        shell->script_lines = 0;
+        shell->script_errors = 0;
+        shell->script_tick = rt_tick_get();
+
+        return 0;
+    }
+
+    rt_kprintf("Usage: script begin\n");
+    rt_kprintf("The following lines are '<command>#<CRC-16/CCITT-FALSE of command in 4 hex digits>',\n");
+    rt_kprintf("they are executed without echo until 'script end' or Ctrl+C.\n");
+
+    return -1;
+}
+FINSH_FUNCTION_EXPORT_ALIAS(finsh_script, __cmd_script, Execute the CRC framed command lines without echo);
+#endif /* FINSH_USING_SCRIPT */
+
+/* read one character, the rest of script buffer is read first */
+static rt_size_t finsh_getchar(char *ch)
+{
+#ifdef FINSH_USING_SCRIPT
+    if (shell->script_get < shell->script_size)
+    {
+        *ch = shell->script_buf[shell->script_get++];
+        return 1;
+    }
+#endif
+
+    return rt_device_read(shell->device, 0, ch, 1);
+}
+
 #ifndef RT_USING_HEAP
 struct finsh_shell _shell;
 #endif
@@ -401,7 +589,7 @@ void finsh_thread_entry(void *parameter)
         shell->device = rt_console_get_device();
         RT_ASSERT(shell->device);
         rt_device_set_rx_indicate(shell->device, finsh_rx_ind);
-        rt_device_open(shell->device, (RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_STREAM | RT_DEVICE_FLAG_INT_RX));
+        rt_device_open(shell->device, (RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_STREAM | FINSH_DEVICE_RX_FLAG(shell->device)));
 #else
         RT_ASSERT(shell->device);
 #endif
@@ -422,8 +610,16 @@ void finsh_thread_entry(void *parameter)
         /* wait receive */
         if (rt_sem_take(&shell->rx_sem, RT_WAITING_FOREVER) != RT_EOK) continue;
 
+#ifdef FINSH_USING_SCRIPT
+        if (shell->script_mode)
+        {
+            finsh_script_rx();
+            continue;
+        }
+#endif
+
         /* read one character from device */
-        while (rt_device_read(shell->device, 0, &ch, 1) == 1)
+        while (finsh_getchar(&ch) == 1)
         {
             /*
              * handle control key
@@ -521,7 +717,7 @@ void finsh_thread_entry(void *parameter)
             {
                 char next;
 
-                if (rt_device_read(shell->device, 0, &next, 1) == 1)
+                if (finsh_getchar(&next) == 1)
                 {
                     if (next == '\0') ch = '\r'; /* linux telnet will issue '\0' */
                     else ch = next;
@@ -604,10 +800,22 @@ void finsh_thread_entry(void *parameter)
 #endif
                 }
 
+#ifdef FINSH_USING_SCRIPT
+                /* the prompt is shown at the end of script */
+                if (!shell->script_mode)
+#endif
                 rt_kprintf(FINSH_PROMPT);
                 memset(shell->line, 0, sizeof(shell->line));
                 shell->line_curpos = shell->line_position = 0;
-                break;
+
+#ifdef FINSH_USING_SCRIPT
+                /* the following lines are the script */
+                if (shell->script_mode)
+                    break;
+#endif
+                /* the rx semaphore is released once for a DMA block, which may have more lines, so the
+                 * device is read until it's empty before waiting for the semaphore */
+                continue;
             }
 
             /* it's a large line, discard it */
@@ -647,13 +855,143 @@ void finsh_thread_entry(void *parameter)
                 shell->line_curpos = 0;
             }
         } /* end of device read */
+
+#ifdef FINSH_USING_SCRIPT
+        /* the rest of received data is read in script mode without waiting for the rx semaphore */
+        if (shell->script_mode)
+            finsh_script_rx();
+#endif
     }
 }
 
+#ifdef FINSH_USING_SYMTAB_INDEX
+struct finsh_syscall **_syscall_index = RT_NULL;
+rt_size_t _syscall_index_count = 0;
+
+/**
+ * This function will compare the name of system call with the key, which is
+ * the prefix followed by the first size characters of name.
+ *
+ * @param call the system call
+ * @param prefix the prefix of key
+ * @param name the name of key, it's not terminated by '\0'
+ * @param size the length of name
+ *
+ * @return <0 if the name of system call is before the key, 0 if it's the key,
+ * >0 if it's after the key or it's the key followed by more characters.
+ */
+int finsh_syscall_index_match(struct finsh_syscall *call, const char *prefix, const char *name, rt_size_t size)
+{
+    const char *call_name = call->name;
+    rt_size_t length;
+    int result;
+
+    length = strlen(prefix);
+    result = strncmp(call_name, prefix, length);
+    if (result != 0)
+        return result;
+
+    call_name += length;
+    result = strncmp(call_name, name, size);
+    if (result != 0)
+        return result;
+
+    return call_name[size] != '\0';
+}
+
+/**
+ * This function will search the first system call in the sorted index whose
+ * name isn't before the key, the calls whose name starts with the key follow it.
+ *
+ * @param prefix the prefix of key, such as "__cmd_" of msh command
+ * @param name the name of key, it's not terminated by '\0'
+ * @param size the length of name
+ *
+ * @return the position in index, _syscall_index_count if all are before the key.
+ */
+rt_size_t finsh_syscall_index_lower(const char *prefix, const char *name, rt_size_t size)
+{
+    rt_size_t low = 0, high = _syscall_index_count, middle;
+
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (finsh_syscall_index_match(_syscall_index[middle], prefix, name, size) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/**
+ * This function will find the system call whose name is the prefix followed
+ * by the first size characters of name.
+ *
+ * @param prefix the prefix of name, such as "__cmd_" of msh command
+ * @param name the name, it's not terminated by '\0'
+ * @param size the length of name
+ *
+ * @return the system call or RT_NULL if it's not found.
+ */
+struct finsh_syscall *finsh_syscall_index_find(const char *prefix, const char *name, rt_size_t size)
+{
+    rt_size_t position;
+
+    position = finsh_syscall_index_lower(prefix, name, size);
+    if (position < _syscall_index_count &&
+            finsh_syscall_index_match(_syscall_index[position], prefix, name, size) == 0)
+        return _syscall_index[position];
+
+    return RT_NULL;
+}
+
+static void finsh_syscall_index_init(void)
+{
+    struct finsh_syscall *index;
+    rt_size_t count = 0, position;
+
+    if (_syscall_index != RT_NULL)
+    {
+        rt_free(_syscall_index);
+        _syscall_index = RT_NULL;
+        _syscall_index_count = 0;
+    }
+
+    for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
+        count ++;
+    if (count == 0)
+        return;
+
+    /* the system calls are searched in table without index */
+    _syscall_index = (struct finsh_syscall **)rt_malloc(count * sizeof(struct finsh_syscall *));
+    if (_syscall_index == RT_NULL)
+        return;
+
+    /* insertion sort, the table is sorted once in initialization */
+    for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
+    {
+        for (position = _syscall_index_count;
+                position > 0 && strcmp(_syscall_index[position - 1]->name, index->name) > 0;
+                position --)
+        {
+            _syscall_index[position] = _syscall_index[position - 1];
+        }
+        _syscall_index[position] = index;
+        _syscall_index_count ++;
+    }
+}
+#endif
+
 void finsh_system_function_init(const void *begin, const void *end)
 {
     _syscall_table_begin = (struct finsh_syscall *) begin;
     _syscall_table_end = (struct finsh_syscall *) end;
+
+#ifdef FINSH_USING_SYMTAB_INDEX
+    finsh_syscall_index_init();
+#endif
 }
 
 void finsh_system_var_init(const void *begin, const void *end)
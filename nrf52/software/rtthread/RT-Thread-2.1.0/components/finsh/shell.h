@@ -25,6 +25,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2011-06-02     Bernard      Add finsh_get_prompt function declaration
+ * 2026-10-17     agent        add the script mode, the framed lines are executed without echo
  */
 
 #ifndef __SHELL_H__
@@ -80,6 +81,16 @@ const char* finsh_get_prompt(void);
     #endif
 #endif /* FINSH_USING_AUTH */
 
+#ifdef FINSH_USING_SCRIPT
+    #ifndef FINSH_USING_MSH
+        #error "the FINSH_USING_SCRIPT needs FINSH_USING_MSH"
+    #endif
+    /* the bytes of one bulk read from shell device in script mode */
+    #ifndef FINSH_SCRIPT_READ_SIZE
+        #define FINSH_SCRIPT_READ_SIZE 64
+    #endif
+#endif /* FINSH_USING_SCRIPT */
+
 enum input_stat
 {
 	WAIT_NORMAL,
@@ -114,6 +125,16 @@ struct finsh_shell
 #ifdef FINSH_USING_AUTH
 	char password[FINSH_PASSWORD_MAX];
 #endif
+
+#ifdef FINSH_USING_SCRIPT
+	rt_uint8_t script_mode;
+	rt_uint32_t script_lines;
+	rt_uint32_t script_errors;
+	rt_tick_t script_tick;
+	/* the bulk read buffer, the rest after the end of script is read by shell */
+	char script_buf[FINSH_SCRIPT_READ_SIZE];
+	rt_uint16_t script_get, script_size;
+#endif
 };
 
 void finsh_set_echo(rt_uint32_t echo);
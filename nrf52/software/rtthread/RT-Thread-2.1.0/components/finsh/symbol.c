@@ -38,6 +38,7 @@ long list_fevent(void);
 long list_event(void);
 long list_mailbox(void);
 long list_msgqueue(void);
+long list_rwlock(void);
 long list_mempool(void);
 long list_timer(void);
 
@@ -71,6 +72,9 @@ struct finsh_syscall _syscall_table[] =
 #ifdef RT_USING_MESSAGEQUEUE
 	{"list_mq", list_msgqueue},
 #endif
+#ifdef RT_USING_RWLOCK
+	{"list_rwlock", list_rwlock},
+#endif
 #ifdef RT_USING_MEMPOOL
 	{"list_memp", list_mempool},
 #endif
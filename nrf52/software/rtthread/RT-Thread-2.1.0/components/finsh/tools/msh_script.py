@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+#
+# This file is part of RT-Thread RTOS.
+#
+# Function: Frame the msh command script for the script mode of finsh (FINSH_USING_SCRIPT). Every
+#           command line is followed by '#' and the CRC-16/CCITT-FALSE of it in 4 hex digits, the
+#           script is wrapped by 'script begin' and 'script end'. The empty lines and the lines
+#           which start with '#' are skipped.
+#
+# Usage: msh_script.py [script, default is stdin] > /dev/ttyACM0
+#
+
+import sys
+
+FINSH_CMD_SIZE = 80
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, same as finsh_script_crc16 in shell.c"""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frame(line):
+    data = line.encode()
+    return data + b'#%04X' % crc16(data)
+
+
+def main():
+    script = open(sys.argv[1], 'r') if len(sys.argv) > 1 else sys.stdin
+    out = sys.stdout.buffer
+
+    out.write(b'script begin\n')
+    for number, line in enumerate(script, 1):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        framed = frame(line)
+        if len(framed) >= FINSH_CMD_SIZE:
+            sys.stderr.write('line %d is longer than %d characters after framed\n' % (number, FINSH_CMD_SIZE - 1))
+            return 1
+        out.write(framed + b'\n')
+    out.write(b'script end\n')
+    out.flush()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
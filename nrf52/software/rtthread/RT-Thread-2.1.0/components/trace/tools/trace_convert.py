@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+#
+# This file is part of RT-Thread RTOS.
+#
+# Function: Convert the dump of RT-Thread trace recorder (the trace dump command) to the Chrome trace
+#           JSON, which is opened by chrome://tracing or https://ui.perfetto.dev. The console log
+#           can be mixed with other output, the last dump in it is converted.
+#
+# Usage: trace_convert.py [console log, default is stdin] > trace.json
+#
+
+import json
+import re
+import sys
+
+# same as enum rt_trace_type in trace.h
+TRACE_SWITCH = 1
+TRACE_IRQ_ENTER = 2
+TRACE_IRQ_LEAVE = 3
+TRACE_TIMER = 4
+TRACE_TRYTAKE = 5
+TRACE_TAKE = 6
+TRACE_RELEASE = 7
+TRACE_MALLOC = 8
+TRACE_FREE = 9
+TRACE_USER = 10
+
+TRACE_LINE = re.compile(r'trace (begin|name|event|end)\b(.*)')
+
+PID = 0
+IRQ_TID = 0
+
+
+class Dump(object):
+    """the last complete dump in console log"""
+
+    def __init__(self, stream):
+        self.frequency = 0
+        self.lost = 0
+        self.names = {}
+        self.events = []
+        dump = None
+        for line in stream:
+            match = TRACE_LINE.search(line)
+            if match is None:
+                continue
+            kind, fields = match.group(1), match.group(2).split()
+            if kind == 'begin':
+                dump = {'frequency': int(fields[0]), 'lost': int(fields[2]), 'names': {}, 'events': []}
+            elif dump is None:
+                continue
+            elif kind == 'name':
+                # the name maybe empty or has spaces
+                dump['names'][int(fields[0], 16)] = (int(fields[1]), ' '.join(fields[2:]))
+            elif kind == 'event':
+                timestamp, object_addr, arg = int(fields[0], 16), int(fields[4], 16), int(fields[5], 16)
+                dump['events'].append((timestamp, int(fields[1]), int(fields[2]), int(fields[3]), object_addr, arg))
+            elif kind == 'end':
+                self.frequency, self.lost = dump['frequency'], dump['lost']
+                self.names, self.events = dump['names'], dump['events']
+                dump = None
+        if self.frequency == 0:
+            raise ValueError('no complete trace dump is found')
+
+    def name(self, addr):
+        if addr in self.names:
+            return self.names[addr][1]
+        return '0x%08x' % addr
+
+
+class Converter(object):
+    def __init__(self, dump):
+        self.dump = dump
+        self.output = []
+        self.tids = {}
+        self.running = None
+        self.pending_take = {}
+        self.heap = {}
+        self.heap_used = 0
+
+    def tid(self, thread):
+        if thread not in self.tids:
+            self.tids[thread] = len(self.tids) + 1
+        return self.tids[thread]
+
+    def emit(self, ph, name, ts, tid, **kwargs):
+        event = {'ph': ph, 'name': name, 'ts': ts, 'pid': PID, 'tid': tid}
+        event.update(kwargs)
+        self.output.append(event)
+
+    def timestamps(self):
+        """the 32-bit timestamp is unwrapped, the events which are preempted in recording maybe a little earlier"""
+        last = None
+        ticks = 0
+        for event in self.dump.events:
+            timestamp = event[0] & 0xFFFFFFFF
+            if last is not None:
+                delta = (timestamp - last) & 0xFFFFFFFF
+                ticks += delta - (1 << 32) if delta & 0x80000000 else delta
+            last = timestamp
+            yield (ticks * 1000000.0 / self.dump.frequency, event)
+
+    def convert(self):
+        ts = 0
+        for ts, (_, kind, irq_nest, value, object_addr, arg) in self.timestamps():
+            # the events in interrupt are shown on interrupt track
+            tid = IRQ_TID if irq_nest > 0 or self.running is None else self.tid(self.running)
+            name = self.dump.name(object_addr)
+            if kind == TRACE_SWITCH:
+                if self.running is not None:
+                    self.emit('E', 'running', ts, self.tid(self.running))
+                self.running = object_addr
+                self.emit('B', 'running', ts, self.tid(object_addr), args={'priority': value})
+            elif kind == TRACE_IRQ_ENTER:
+                self.emit('B', 'interrupt', ts, IRQ_TID, args={'nest': irq_nest})
+            elif kind == TRACE_IRQ_LEAVE:
+                self.emit('E', 'interrupt', ts, IRQ_TID)
+            elif kind == TRACE_TIMER:
+                self.emit('i', 'timer ' + name, ts, tid, s='t', args={'timeout': '0x%08x' % arg})
+            elif kind == TRACE_TRYTAKE:
+                self.pending_take[(tid, object_addr)] = ts
+            elif kind == TRACE_TAKE:
+                start = self.pending_take.pop((tid, object_addr), ts)
+                self.emit('X', 'take ' + name, start, tid, dur=ts - start, args={'class': value})
+            elif kind == TRACE_RELEASE:
+                self.emit('i', 'release ' + name, ts, tid, s='t', args={'class': value})
+            elif kind == TRACE_MALLOC:
+                self.heap[object_addr] = arg
+                self.heap_used += arg
+                self.emit('i', 'malloc', ts, tid, s='t', args={'ptr': '0x%08x' % object_addr, 'size': arg})
+                self.emit('C', 'heap', ts, IRQ_TID, args={'traced bytes': self.heap_used})
+            elif kind == TRACE_FREE:
+                self.heap_used -= self.heap.pop(object_addr, 0)
+                self.emit('i', 'free', ts, tid, s='t', args={'ptr': '0x%08x' % object_addr})
+                self.emit('C', 'heap', ts, IRQ_TID, args={'traced bytes': self.heap_used})
+            elif kind == TRACE_USER:
+                self.emit('i', 'user %d' % value, ts, tid, s='t',
+                          args={'object': '0x%08x' % object_addr, 'arg': arg})
+
+        # the take which is not finished (timeout or still waiting) at the end of trace
+        for (tid, object_addr), start in self.pending_take.items():
+            self.emit('X', 'wait ' + self.dump.name(object_addr), start, tid, dur=ts - start)
+        if self.running is not None:
+            self.emit('E', 'running', ts, self.tid(self.running))
+
+        self.output.append({'ph': 'M', 'name': 'process_name', 'pid': PID, 'args': {'name': 'rt-thread'}})
+        self.output.append({'ph': 'M', 'name': 'thread_name', 'pid': PID, 'tid': IRQ_TID,
+                            'args': {'name': 'interrupt'}})
+        for thread, tid in self.tids.items():
+            self.output.append({'ph': 'M', 'name': 'thread_name', 'pid': PID, 'tid': tid,
+                                'args': {'name': self.dump.name(thread)}})
+
+        return {'traceEvents': self.output, 'displayTimeUnit': 'ns',
+                'otherData': {'events': len(self.dump.events), 'lost events': self.dump.lost,
+                              'timestamp frequency': self.dump.frequency}}
+
+
+def main():
+    if len(sys.argv) > 2:
+        sys.stderr.write('Usage: %s [console log]\n' % sys.argv[0])
+        return 1
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], 'r', errors='replace') as stream:
+            dump = Dump(stream)
+    else:
+        dump = Dump(sys.stdin)
+    json.dump(Converter(dump).convert(), sys.stdout, indent=1)
+    sys.stdout.write('\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
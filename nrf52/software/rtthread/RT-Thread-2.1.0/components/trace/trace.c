@@ -0,0 +1,332 @@
+/*
+ * File      : trace.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, kernel event trace recorder
+ * 2026-10-17     agent        restore the hooks of others at stop, lock the scheduler in the object list walk
+ */
+
+/*
+ * The trace recorder is installed on the kernel hooks (scheduler, interrupt,
+ * timer, IPC object and heap), so these hooks are taken by it when it's
+ * started, and the hooks which are set before are restored when it's stopped,
+ * they aren't invoked while it's started. The events are saved in a ring buffer, the oldest events are
+ * overwritten when it's full, so the events before a missed deadline are
+ * kept until the trace is stopped or dumped.
+ *
+ * The slot of event is reserved by the atomic compare and swap, so it's
+ * recorded without disabling interrupt. The interrupt which preempts the
+ * recording reserves the next slot.
+ *
+ * The dump is converted to Chrome trace (Perfetto) JSON by tools/trace_convert.py.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include "trace.h"
+
+#ifdef RT_USING_TRACE
+
+#ifndef RT_USING_HOOK
+#error "the RT_USING_TRACE is installed on the kernel hooks, the RT_USING_HOOK must be used"
+#endif
+
+#if RT_TRACE_BUFFER_SIZE & (RT_TRACE_BUFFER_SIZE - 1)
+#error "the RT_TRACE_BUFFER_SIZE must be power of 2"
+#endif
+
+#define TRACE_ADDR(ptr)                ((rt_uint32_t)(rt_ubase_t)(ptr))
+
+extern void (*rt_scheduler_hook)(struct rt_thread *from, struct rt_thread *to);
+extern void (*rt_interrupt_enter_hook)(void);
+extern void (*rt_interrupt_leave_hook)(void);
+extern void (*rt_timer_timeout_hook)(struct rt_timer *timer);
+extern void (*rt_object_trytake_hook)(struct rt_object *object);
+extern void (*rt_object_take_hook)(struct rt_object *object);
+extern void (*rt_object_put_hook)(struct rt_object *object);
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+extern void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+extern void (*rt_free_hook)(void *ptr);
+#endif
+
+/* the kernel hooks which are set before the trace is started, they are restored when it's stopped */
+static struct
+{
+    rt_bool_t started;
+    void (*scheduler)(struct rt_thread *from, struct rt_thread *to);
+    void (*interrupt_enter)(void);
+    void (*interrupt_leave)(void);
+    void (*timer_timeout)(struct rt_timer *timer);
+    void (*object_trytake)(struct rt_object *object);
+    void (*object_take)(struct rt_object *object);
+    void (*object_put)(struct rt_object *object);
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+    void (*malloc)(void *ptr, rt_size_t size);
+    void (*free)(void *ptr);
+#endif
+} trace_saved_hook;
+
+static struct rt_trace_event trace_buffer[RT_TRACE_BUFFER_SIZE];
+/* the count of reserved events, the event is saved at (index % RT_TRACE_BUFFER_SIZE) */
+static volatile rt_ubase_t trace_index;
+static volatile rt_bool_t trace_recording;
+
+static void _rt_trace_switch(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_trace_record(RT_TRACE_SWITCH, to->current_priority, TRACE_ADDR(to), TRACE_ADDR(from));
+}
+
+static void _rt_trace_irq_enter(void)
+{
+    rt_trace_record(RT_TRACE_IRQ_ENTER, 0, 0, 0);
+}
+
+static void _rt_trace_irq_leave(void)
+{
+    rt_trace_record(RT_TRACE_IRQ_LEAVE, 0, 0, 0);
+}
+
+static void _rt_trace_timer(struct rt_timer *timer)
+{
+    rt_trace_record(RT_TRACE_TIMER, 0, TRACE_ADDR(timer), TRACE_ADDR(timer->timeout_func));
+}
+
+static void _rt_trace_trytake(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_TRYTAKE, object->type & ~RT_Object_Class_Static, TRACE_ADDR(object), 0);
+}
+
+static void _rt_trace_take(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_TAKE, object->type & ~RT_Object_Class_Static, TRACE_ADDR(object), 0);
+}
+
+static void _rt_trace_release(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_RELEASE, object->type & ~RT_Object_Class_Static, TRACE_ADDR(object), 0);
+}
+
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+static void _rt_trace_malloc(void *ptr, rt_uint32_t size)
+{
+    rt_trace_record(RT_TRACE_MALLOC, 0, TRACE_ADDR(ptr), size);
+}
+
+static void _rt_trace_free(void *ptr)
+{
+    rt_trace_record(RT_TRACE_FREE, 0, TRACE_ADDR(ptr), 0);
+}
+#endif
+
+/**
+ * This function will clear the trace buffer and start recording the kernel
+ * events. The scheduler, interrupt, timer timeout, IPC object and heap hooks
+ * are saved and set to the trace recorder.
+ */
+void rt_trace_start(void)
+{
+    struct rt_thread *thread;
+
+    trace_recording = RT_FALSE;
+    trace_index = 0;
+
+    /* the hooks are saved once, the trace may be started again without stop */
+    if (!trace_saved_hook.started)
+    {
+        trace_saved_hook.scheduler       = rt_scheduler_hook;
+        trace_saved_hook.interrupt_enter = rt_interrupt_enter_hook;
+        trace_saved_hook.interrupt_leave = rt_interrupt_leave_hook;
+        trace_saved_hook.timer_timeout   = rt_timer_timeout_hook;
+        trace_saved_hook.object_trytake  = rt_object_trytake_hook;
+        trace_saved_hook.object_take     = rt_object_take_hook;
+        trace_saved_hook.object_put      = rt_object_put_hook;
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+        trace_saved_hook.malloc          = rt_malloc_hook;
+        trace_saved_hook.free            = rt_free_hook;
+#endif
+        trace_saved_hook.started = RT_TRUE;
+    }
+
+    rt_scheduler_sethook(_rt_trace_switch);
+    rt_interrupt_enter_sethook(_rt_trace_irq_enter);
+    rt_interrupt_leave_sethook(_rt_trace_irq_leave);
+    rt_timer_timeout_sethook(_rt_trace_timer);
+    rt_object_trytake_sethook(_rt_trace_trytake);
+    rt_object_take_sethook(_rt_trace_take);
+    rt_object_put_sethook(_rt_trace_release);
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+    rt_malloc_sethook(_rt_trace_malloc);
+    rt_free_sethook(_rt_trace_free);
+#endif
+
+    trace_recording = RT_TRUE;
+
+    /* the running thread, which the first events belong to */
+    thread = rt_thread_self();
+    rt_trace_record(RT_TRACE_SWITCH, thread->current_priority, TRACE_ADDR(thread), 0);
+}
+RTM_EXPORT(rt_trace_start);
+
+/**
+ * This function will stop recording and restore the kernel hooks which are
+ * saved when the trace is started, the recorded events are kept until the
+ * trace is started again.
+ */
+void rt_trace_stop(void)
+{
+    trace_recording = RT_FALSE;
+
+    if (!trace_saved_hook.started)
+        return;
+
+    rt_scheduler_sethook(trace_saved_hook.scheduler);
+    rt_interrupt_enter_sethook(trace_saved_hook.interrupt_enter);
+    rt_interrupt_leave_sethook(trace_saved_hook.interrupt_leave);
+    rt_timer_timeout_sethook(trace_saved_hook.timer_timeout);
+    rt_object_trytake_sethook(trace_saved_hook.object_trytake);
+    rt_object_take_sethook(trace_saved_hook.object_take);
+    rt_object_put_sethook(trace_saved_hook.object_put);
+#if defined (RT_USING_HEAP) && !defined (RT_USING_MEMHEAP_AS_HEAP)
+    rt_malloc_sethook(trace_saved_hook.malloc);
+    rt_free_sethook(trace_saved_hook.free);
+#endif
+    trace_saved_hook.started = RT_FALSE;
+}
+RTM_EXPORT(rt_trace_stop);
+
+/**
+ * This function will record an event to the trace buffer, it's invoked by the
+ * kernel hooks, and by application with RT_TRACE_USER type. It can be invoked
+ * in interrupt.
+ *
+ * @param type the type of event
+ * @param value the priority or object class
+ * @param object the address of thread, object or memory
+ * @param arg the argument of event
+ */
+void rt_trace_record(rt_uint8_t type, rt_uint16_t value, rt_uint32_t object, rt_uint32_t arg)
+{
+    volatile struct rt_trace_event *event;
+    rt_ubase_t index;
+
+    if (!trace_recording)
+        return;
+
+    do
+    {
+        index = trace_index;
+    } while (!rt_hw_atomic_cas(&trace_index, index, index + 1));
+
+    /* the type is written at last, so the event which is not written completely is skipped by dump */
+    event = &trace_buffer[index & (RT_TRACE_BUFFER_SIZE - 1)];
+    event->type      = RT_TRACE_NONE;
+    event->timestamp = rt_hw_trace_timestamp();
+    event->irq_nest  = rt_interrupt_get_nest();
+    event->value     = value;
+    event->object    = object;
+    event->arg       = arg;
+    event->type      = type;
+}
+RTM_EXPORT(rt_trace_record);
+
+/**
+ * This function will print the names of kernel objects and the events in the
+ * trace buffer from the oldest one. The recording is paused in dump.
+ */
+void rt_trace_dump(void)
+{
+    extern struct rt_object_information rt_object_container[];
+    struct rt_trace_event *event;
+    struct rt_list_node *list, *node;
+    struct rt_object *object;
+    rt_ubase_t index, first, count;
+    rt_bool_t recording;
+    int type;
+
+    recording = trace_recording;
+    trace_recording = RT_FALSE;
+
+    count = trace_index;
+    first = count > RT_TRACE_BUFFER_SIZE ? count - RT_TRACE_BUFFER_SIZE : 0;
+
+    /* the frequency of timestamp, the dumped events and the overwritten events */
+    rt_kprintf("trace begin %d %d %d\n", rt_hw_trace_frequency(), count - first, first);
+
+    /* the object which is printed isn't deleted by other threads */
+    rt_enter_critical();
+    for (type = 0; type < RT_Object_Class_Unknown; type ++)
+    {
+        list = &rt_object_container[type].object_list;
+        for (node = list->next; node != list; node = node->next)
+        {
+            object = rt_list_entry(node, struct rt_object, list);
+            rt_kprintf("trace name %08x %d %.*s\n", TRACE_ADDR(object), type, RT_NAME_MAX, object->name);
+        }
+    }
+    rt_exit_critical();
+
+    for (index = first; index < count; index ++)
+    {
+        event = &trace_buffer[index & (RT_TRACE_BUFFER_SIZE - 1)];
+        if (event->type == RT_TRACE_NONE)
+            continue;
+
+        rt_kprintf("trace event %08x %d %d %d %08x %08x\n", event->timestamp, event->type, event->irq_nest,
+                   event->value, event->object, event->arg);
+    }
+
+    rt_kprintf("trace end\n");
+
+    trace_recording = recording;
+}
+RTM_EXPORT(rt_trace_dump);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int cmd_trace(int argc, char **argv)
+{
+    if (argc == 2 && rt_strcmp(argv[1], "start") == 0)
+    {
+        rt_trace_start();
+    }
+    else if (argc == 2 && rt_strcmp(argv[1], "stop") == 0)
+    {
+        rt_trace_stop();
+    }
+    else if (argc == 2 && rt_strcmp(argv[1], "dump") == 0)
+    {
+        rt_trace_dump();
+    }
+    else
+    {
+        rt_kprintf("Usage: trace start|stop|dump\n");
+        rt_kprintf("trace is %s, %d events recorded, the buffer is %d events.\n",
+                   trace_recording ? "recording" : "stopped", trace_index, RT_TRACE_BUFFER_SIZE);
+        return -1;
+    }
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT_ALIAS(cmd_trace, __cmd_trace, Record the kernel events: trace start|stop|dump);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_TRACE */
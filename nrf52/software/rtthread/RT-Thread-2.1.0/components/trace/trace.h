@@ -0,0 +1,79 @@
+/*
+ * File      : trace.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, kernel event trace recorder
+ */
+
+#ifndef __RT_TRACE_H__
+#define __RT_TRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the events in ring buffer, it must be power of 2 */
+#ifndef RT_TRACE_BUFFER_SIZE
+#define RT_TRACE_BUFFER_SIZE           256
+#endif
+
+/**
+ * trace event type
+ */
+enum rt_trace_type
+{
+    RT_TRACE_NONE = 0,                                  /**< The event is not recorded completely. */
+    RT_TRACE_SWITCH,                                    /**< Thread switch, object is to, arg is from thread. */
+    RT_TRACE_IRQ_ENTER,                                 /**< Interrupt enter. */
+    RT_TRACE_IRQ_LEAVE,                                 /**< Interrupt leave. */
+    RT_TRACE_TIMER,                                     /**< Timer timeout, object is the timer. */
+    RT_TRACE_TRYTAKE,                                   /**< Try to take an IPC object, value is the class. */
+    RT_TRACE_TAKE,                                      /**< An IPC object is taken, value is the class. */
+    RT_TRACE_RELEASE,                                   /**< An IPC object is released, value is the class. */
+    RT_TRACE_MALLOC,                                    /**< Memory is allocated, arg is the size. */
+    RT_TRACE_FREE,                                      /**< Memory is freed. */
+    RT_TRACE_USER,                                      /**< The event of application. */
+};
+
+/**
+ * trace event, it's 16 bytes on 32-bit CPU
+ */
+struct rt_trace_event
+{
+    rt_uint32_t timestamp;                              /**< timestamp of rt_hw_trace_timestamp */
+    rt_uint8_t  type;                                   /**< type of event */
+    rt_uint8_t  irq_nest;                               /**< interrupt nest when it's recorded */
+    rt_uint16_t value;                                  /**< priority of the switched thread or object class */
+    rt_uint32_t object;                                 /**< address of thread, object or memory */
+    rt_uint32_t arg;                                    /**< argument of event */
+};
+
+void rt_trace_start(void);
+void rt_trace_stop(void);
+void rt_trace_record(rt_uint8_t type, rt_uint16_t value, rt_uint32_t object, rt_uint32_t arg);
+void rt_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
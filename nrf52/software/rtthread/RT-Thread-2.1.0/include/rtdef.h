@@ -30,6 +30,11 @@
  * 2012-12-30     Bernard      add more control command for graphic.
  * 2013-01-09     Bernard      change version number.
  * 2015-02-01     Bernard      change version number to v2.1.0
+ * 2026-10-17     agent        add the timing wheel configuration.
+ * 2026-10-17     agent        add the timer check batch and budget configuration.
+ * 2026-10-17     agent        add the lock-free memory pool block list.
+ * 2026-10-17     agent        add the reader/writer lock.
+ * 2026-10-17     agent        add the name hash index of object container.
  */
 
 #ifndef __RT_DEF_H__
@@ -319,6 +324,10 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object  *hash_next;                       /**< next object in the bucket of name hash index */
+    struct rt_object **hash_pprev;                      /**< the pointer to this object in the bucket */
+#endif
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -357,6 +366,9 @@ enum rt_object_class_type
 #ifdef RT_USING_MESSAGEQUEUE
     RT_Object_Class_MessageQueue,                       /**< The object is a message queue. */
 #endif
+#ifdef RT_USING_RWLOCK
+    RT_Object_Class_RWLock,                             /**< The object is a reader/writer lock. */
+#endif
 #ifdef RT_USING_MEMHEAP
     RT_Object_Class_MemHeap,                            /**< The object is a memory heap */
 #endif
@@ -377,11 +389,25 @@ enum rt_object_class_type
 /**
  * The information of the kernel object
  */
+#ifdef RT_USING_OBJECT_HASH
+/* the buckets of name hash index in each object class, it shall be power of 2 */
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE             16
+#endif
+
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "the RT_OBJECT_HASH_SIZE must be power of 2"
+#endif
+#endif
+
 struct rt_object_information
 {
     enum rt_object_class_type type;                     /**< object class type */
     rt_list_t                 object_list;              /**< object list */
     rt_size_t                 object_size;              /**< object size */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object         *hash[RT_OBJECT_HASH_SIZE];/**< name hash index of objects */
+#endif
 };
 
 /**
@@ -427,6 +453,32 @@ struct rt_object_information
 #define RT_TIMER_SKIP_LIST_MASK         0x3
 #endif
 
+#ifdef RT_USING_TIMER_WHEEL
+/* the timing wheel has (1 << RT_TIMER_WHEEL_BITS) slots per level, the bits shall not be greater than 5 */
+#ifndef RT_TIMER_WHEEL_BITS
+#define RT_TIMER_WHEEL_BITS             5
+#endif
+
+/* the wheel covers (1 << (RT_TIMER_WHEEL_LEVEL * RT_TIMER_WHEEL_BITS)) ticks, the longer timer is cascaded again */
+#ifndef RT_TIMER_WHEEL_LEVEL
+#define RT_TIMER_WHEEL_LEVEL            4
+#endif
+
+#if RT_TIMER_WHEEL_BITS > 5 || RT_TIMER_WHEEL_LEVEL * RT_TIMER_WHEEL_BITS >= 32
+#error "the timing wheel is out of the 32 bits bitmap and tick"
+#endif
+#endif
+
+/* the max timers which are moved to the expired list in one interrupt disabled window of timer check */
+#ifndef RT_TIMER_CHECK_BATCH
+#define RT_TIMER_CHECK_BATCH            16
+#endif
+
+/* the max hard timer timeout functions in one timer check, the rest is invoked by timer thread, 0 is unlimited */
+#ifndef RT_TIMER_CHECK_BUDGET
+#define RT_TIMER_CHECK_BUDGET           0
+#endif
+
 /**
  * timer structure
  */
@@ -489,6 +541,10 @@ struct rt_thread
 #endif
 
     rt_list_t   list;                                   /**< the object list */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object  *hash_next;                       /**< next object in the bucket of name hash index */
+    struct rt_object **hash_pprev;                      /**< the pointer to this object in the bucket */
+#endif
     rt_list_t   tlist;                                  /**< the thread list */
 
     /* stack point and entry */
@@ -653,6 +709,33 @@ struct rt_messagequeue
 typedef struct rt_messagequeue *rt_mq_t;
 #endif
 
+#ifdef RT_USING_RWLOCK
+/**
+ * reader/writer lock structure, the writers are preferred to the readers
+ *
+ * @note only the writer which holds the lock inherits the priority of a waiting
+ * thread. The readers are counted but not recorded, so a high priority writer
+ * which waits for the readers doesn't boost them, and it may wait as long as a
+ * middle priority thread preempts a low priority reader. Don't hold the read
+ * lock in a low priority thread which may block a time critical writer, or use
+ * a mutex for it.
+ */
+struct rt_rwlock
+{
+    struct rt_ipc_object parent;                        /**< inherit from ipc_object, writers are suspended on it */
+
+    rt_uint16_t          readers;                       /**< numbers of thread hold the read lock */
+
+    rt_uint8_t           original_priority;             /**< priority of the writer hold the lock */
+    rt_uint8_t           hold;                          /**< numbers of the writer hold the lock */
+
+    struct rt_thread    *owner;                         /**< the writer hold the lock */
+
+    rt_list_t            suspend_reader_thread;         /**< reader thread suspended on this lock */
+};
+typedef struct rt_rwlock *rt_rwlock_t;
+#endif
+
 /*@}*/
 
 /**
@@ -716,10 +799,14 @@ struct rt_mempool
     rt_size_t        size;                              /**< size of memory pool */
 
     rt_size_t        block_size;                        /**< size of memory blocks */
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    volatile rt_ubase_t block_list;                     /**< memory blocks list, the tagged index of first block */
+#else
     rt_uint8_t      *block_list;                        /**< memory blocks list */
+#endif
 
     rt_size_t        block_total_count;                 /**< numbers of memory block */
-    rt_size_t        block_free_count;                  /**< numbers of free memory block */
+    volatile rt_size_t block_free_count;                /**< numbers of free memory block */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
     rt_size_t        suspend_thread_count;              /**< numbers of thread pended on this resource */
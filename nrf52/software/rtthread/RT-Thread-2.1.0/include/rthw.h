@@ -23,6 +23,12 @@
  * 2006-04-25     Bernard      add rt_hw_context_switch_interrupt declaration
  * 2006-09-24     Bernard      add rt_hw_context_switch_to declaration
  * 2012-12-29     Bernard      add rt_hw_exception_install declaration
+ * 2026-10-17     agent        use rt_ubase_t for the thread stack pointer address of context switch
+ * 2026-10-17     agent        add rt_hw_tickless_sleep declaration
+ * 2026-10-17     agent        add rt_hw_cycle_get declaration
+ * 2026-10-17     agent        add rt_hw_atomic_cas declaration
+ * 2026-10-17     agent        add rt_hw_trace_timestamp declaration
+ * 2026-10-17     agent        the rt_hw_cycle_get is used by interrupt masked statistics too
  */
 
 #ifndef __RT_HW_H__
@@ -84,9 +90,9 @@ void rt_hw_interrupt_enable(rt_base_t level);
 /*
  * Context interfaces
  */
-void rt_hw_context_switch(rt_uint32_t from, rt_uint32_t to);
-void rt_hw_context_switch_to(rt_uint32_t to);
-void rt_hw_context_switch_interrupt(rt_uint32_t from, rt_uint32_t to);
+void rt_hw_context_switch(rt_ubase_t from, rt_ubase_t to);
+void rt_hw_context_switch_to(rt_ubase_t to);
+void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to);
 
 void rt_hw_console_output(const char *str);
 
@@ -98,6 +104,39 @@ void rt_hw_show_memory(rt_uint32_t addr, rt_uint32_t size);
  */
 void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
 
+#ifdef RT_USING_TICKLESS
+/*
+ * Tickless interfaces, it's invoked by idle thread with interrupt disabled.
+ * It sleeps until the timeout tick or interrupt, and returns the skipped tick.
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t timeout);
+#endif
+
+#if defined (RT_USING_TIMER_IRQOFF_STAT) || defined (RT_USING_IRQOFF_STAT)
+/*
+ * Cycle counter interfaces, it's a free running counter of CPU cycles for the
+ * time measurement, the wrap around is handled by the unsigned subtraction.
+ */
+rt_uint32_t rt_hw_cycle_get(void);
+#endif
+
+#ifdef RT_USING_TRACE
+/*
+ * Trace interfaces, the timestamp is a free running counter which is same on
+ * all threads, and the frequency in Hz is used to convert it to time on host.
+ */
+rt_uint32_t rt_hw_trace_timestamp(void);
+rt_uint32_t rt_hw_trace_frequency(void);
+#endif
+
+#if defined (RT_USING_MEMPOOL_LOCKFREE) || defined (RT_USING_TRACE)
+/*
+ * Atomic interfaces, it sets the value to the new one if it's equal to the old
+ * one, and it's safe from the interrupts and other CPUs without disabling interrupt.
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new_value);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,8 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type,
 void rt_object_delete(rt_object_t object);
 rt_bool_t rt_object_is_systemobject(rt_object_t object);
 rt_object_t rt_object_find(const char *name, rt_uint8_t type);
+rt_object_t rt_object_lookup(struct rt_object_information *information,
+                             const char                   *name);
 
 #ifdef RT_USING_HOOK
 void rt_object_attach_sethook(void (*hook)(struct rt_object *object));
@@ -111,6 +113,9 @@ rt_err_t rt_timer_control(rt_timer_t timer, rt_uint8_t cmd, void *arg);
 
 rt_tick_t rt_timer_next_timeout_tick(void);
 void rt_timer_check(void);
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+rt_uint32_t rt_timer_irqoff_max(rt_bool_t reset);
+#endif
 
 #ifdef RT_USING_HOOK
 void rt_timer_timeout_sethook(void (*hook)(struct rt_timer *timer));
@@ -251,6 +256,17 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_uint32_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
 #endif
 
+#ifdef RT_USING_OBJCACHE
+/*
+ * kernel object and thread stack cache interface
+ */
+void *rt_objcache_alloc(enum rt_object_class_type type, rt_size_t size);
+void rt_objcache_free(enum rt_object_class_type type, void *ptr);
+void *rt_objcache_stack_alloc(rt_size_t size);
+void rt_objcache_stack_free(void *stack, rt_size_t size);
+rt_size_t rt_objcache_shrink(void);
+#endif
+
 #endif
 
 #ifdef RT_USING_MEMHEAP
@@ -343,6 +359,14 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
                          rt_uint32_t  value,
                          rt_int32_t   timeout);
 rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_uint32_t *value, rt_int32_t timeout);
+rt_size_t rt_mb_send_n(rt_mailbox_t       mb,
+                       const rt_uint32_t *values,
+                       rt_size_t          count,
+                       rt_int32_t         timeout);
+rt_size_t rt_mb_recv_n(rt_mailbox_t mb,
+                       rt_uint32_t *values,
+                       rt_size_t    count,
+                       rt_int32_t   timeout);
 rt_err_t rt_mb_control(rt_mailbox_t mb, rt_uint8_t cmd, void *arg);
 #endif
 
@@ -370,6 +394,32 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     rt_size_t  size,
                     rt_int32_t timeout);
 rt_err_t rt_mq_control(rt_mq_t mq, rt_uint8_t cmd, void *arg);
+
+void *rt_mq_loan(rt_mq_t mq);
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer);
+rt_err_t rt_mq_recv_ref(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer);
+
+rt_size_t rt_mq_send_n(rt_mq_t mq, const void *buffer, rt_size_t size, rt_size_t count);
+rt_size_t rt_mq_recv_n(rt_mq_t    mq,
+                       void      *buffer,
+                       rt_size_t  size,
+                       rt_size_t  count,
+                       rt_int32_t timeout);
+#endif
+
+#ifdef RT_USING_RWLOCK
+/*
+ * reader/writer lock interface
+ */
+rt_err_t rt_rwlock_init(rt_rwlock_t rwlock, const char *name, rt_uint8_t flag);
+rt_err_t rt_rwlock_detach(rt_rwlock_t rwlock);
+rt_rwlock_t rt_rwlock_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_rwlock_delete(rt_rwlock_t rwlock);
+
+rt_err_t rt_rwlock_take_read(rt_rwlock_t rwlock, rt_int32_t time);
+rt_err_t rt_rwlock_take_write(rt_rwlock_t rwlock, rt_int32_t time);
+rt_err_t rt_rwlock_release(rt_rwlock_t rwlock);
 #endif
 
 /**@}*/
@@ -468,6 +518,16 @@ void rt_interrupt_leave(void);
  */
 rt_uint8_t rt_interrupt_get_nest(void);
 
+#ifdef RT_USING_IRQOFF_STAT
+/*
+ * rt_interrupt_mask_begin and rt_interrupt_mask_end only can be called by the
+ * interrupt disable and enable of BSP
+ */
+void rt_interrupt_mask_begin(void *caller);
+void rt_interrupt_mask_end(void);
+void rt_interrupt_mask_reset(void);
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_interrupt_enter_sethook(void (*hook)(void));
 void rt_interrupt_leave_sethook(void (*hook)(void));
@@ -17,9 +17,14 @@
  * 2012-12-23     aozima       stack addr align to 8byte.
  * 2012-12-29     Bernard      Add exception hook.
  * 2013-06-23     aozima       support lazy stack optimized.
+ * 2026-10-17     agent        add the DWT cycle counter.
+ * 2026-10-17     agent        add the atomic compare and swap by LDREX/STREX.
+ * 2026-10-17     agent        the atomic compare and swap is used by trace too.
+ * 2026-10-17     agent        add the zero-latency interrupt check and the masked window statistics.
  */
 
 #include <rtthread.h>
+#include "cpuport.h"
 
 #define USE_FPU   /* ARMCC */ (  (defined ( __CC_ARM ) && defined ( __TARGET_FPU_VFP )) \
                   /* IAR */   || (defined ( __ICCARM__ ) && defined ( __ARMVFP__ )) \
@@ -32,6 +37,17 @@ rt_uint32_t rt_thread_switch_interrupt_flag;
 /* exception hook */
 static rt_err_t (*rt_exception_hook)(void *context) = RT_NULL;
 
+/* the DWT cycle counter registers */
+#define DEM_CR                         (*(volatile rt_uint32_t *)0xE000EDFC)
+#define DEM_CR_TRCENA                  (1UL << 24)
+#define DWT_CTRL                       (*(volatile rt_uint32_t *)0xE0001000)
+#define DWT_CTRL_CYCCNTENA             (1UL << 0)
+#define DWT_CYCCNT                     (*(volatile rt_uint32_t *)0xE0001004)
+
+/* the priority registers of interrupts and system exceptions, one byte for each */
+#define NVIC_IPR                       ((volatile rt_uint8_t *)0xE000E400)
+#define SCB_SHPR                       ((volatile rt_uint8_t *)0xE000ED18)
+
 struct exception_stack_frame
 {
     rt_uint32_t r0;
@@ -212,6 +228,161 @@ void rt_hw_hard_fault_exception(struct exception_stack_frame *exception_stack)
     while (1);
 }
 
+#if defined (RT_USING_TIMER_IRQOFF_STAT) || defined (RT_USING_IRQOFF_STAT)
+/**
+ * This function will get the DWT cycle counter, the counter is enabled on the
+ * first call.
+ *
+ * @return the CPU cycles
+ */
+rt_uint32_t rt_hw_cycle_get(void)
+{
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA))
+    {
+        DEM_CR |= DEM_CR_TRCENA;
+        DWT_CYCCNT = 0;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    return DWT_CYCCNT;
+}
+#endif
+
+#ifdef RT_HW_INTERRUPT_MASKED_HOOK
+#if defined (RT_USING_BASEPRI) && defined (RT_DEBUG)
+/* the zero-latency interrupt which calls kernel is reported once, the assertion calls kernel too */
+static rt_bool_t rt_hw_zero_latency_reported;
+
+#if defined(__CC_ARM)
+static __inline rt_uint32_t _rt_hw_ipsr(void)
+{
+    register rt_uint32_t ipsr __asm("ipsr");
+
+    return ipsr;
+}
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _rt_hw_ipsr()                  __get_IPSR()
+#elif defined(__GNUC__)
+rt_inline rt_uint32_t _rt_hw_ipsr(void)
+{
+    rt_uint32_t ipsr;
+
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+
+    return ipsr;
+}
+#endif
+
+/* the zero-latency interrupt is not masked by kernel, so the kernel data is not protected in it */
+static void _rt_hw_zero_latency_check(void)
+{
+    rt_uint32_t exception;
+    rt_uint8_t priority;
+
+    exception = _rt_hw_ipsr() & 0x1FF;
+    /* thread mode, or the reset, NMI and hard fault which have the fixed priority */
+    if (exception < 4)
+        return;
+
+    if (exception >= 16)
+        priority = NVIC_IPR[exception - 16];
+    else
+        priority = SCB_SHPR[exception - 4];
+
+    if (priority < RT_BASEPRI_MASK && !rt_hw_zero_latency_reported)
+    {
+        rt_hw_zero_latency_reported = RT_TRUE;
+        rt_kprintf("exception %d of priority %d is higher than RT_BASEPRI_THRESHOLD, it can't call kernel\n",
+                   exception, priority >> (8 - RT_BASEPRI_PRIO_BITS));
+        RT_ASSERT(priority >= RT_BASEPRI_MASK);
+    }
+}
+#endif
+
+/**
+ * This function will be invoked by rt_hw_interrupt_disable after the
+ * interrupt is masked. It asserts that the caller is not a zero-latency
+ * interrupt, and begins the masked window of the outermost disable.
+ *
+ * @param level the level before disable, 0: the interrupt was not masked
+ * @param caller the return address of rt_hw_interrupt_disable
+ */
+void rt_hw_interrupt_masked(rt_base_t level, void *caller)
+{
+#if defined (RT_USING_BASEPRI) && defined (RT_DEBUG)
+    _rt_hw_zero_latency_check();
+#endif
+
+#ifdef RT_USING_IRQOFF_STAT
+    if (level == 0)
+        rt_interrupt_mask_begin(caller);
+#endif
+}
+#endif /* RT_HW_INTERRUPT_MASKED_HOOK */
+
+#if defined (RT_USING_MEMPOOL_LOCKFREE) || defined (RT_USING_TRACE)
+/**
+ * This function will set the value to the new one if it's equal to the old one.
+ * The exclusive monitor is cleared by the exception entry and return, so the
+ * STREX is failed and retried when it's preempted by an interrupt.
+ *
+ * @param ptr the address of value
+ * @param old the expected value
+ * @param new_value the new value
+ *
+ * @return RT_TRUE if the value is set, RT_FALSE if it's not equal to the old one
+ */
+#if defined(__CC_ARM)
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new_value)
+{
+    do
+    {
+        if (__ldrex(ptr) != old)
+        {
+            __clrex();
+            return RT_FALSE;
+        }
+    } while (__strex(new_value, ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new_value)
+{
+    do
+    {
+        if (__LDREX((unsigned long *)ptr) != old)
+        {
+            __CLREX();
+            return RT_FALSE;
+        }
+    } while (__STREX(new_value, (unsigned long *)ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__GNUC__)
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new_value)
+{
+    rt_ubase_t value, fail;
+
+    do
+    {
+        __asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (ptr) : "memory");
+        if (value != old)
+        {
+            __asm volatile ("clrex" ::: "memory");
+            return RT_FALSE;
+        }
+        __asm volatile ("strex %0, %2, [%1]" : "=&r" (fail) : "r" (ptr), "r" (new_value) : "memory");
+    } while (fail != 0);
+
+    return RT_TRUE;
+}
+#endif
+#endif /* defined (RT_USING_MEMPOOL_LOCKFREE) || defined (RT_USING_TRACE) */
+
 /**
  * shutdown CPU
  */
@@ -0,0 +1,46 @@
+/*
+ * File      : cpuport.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2014, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, the BASEPRI critical section.
+ */
+
+/* it's included by the assembly, so only the preprocessor definitions are here */
+
+#ifndef __CPUPORT_H__
+#define __CPUPORT_H__
+
+#include <rtconfig.h>
+
+#ifdef RT_USING_BASEPRI
+/* the highest (smallest number) NVIC priority of the interrupts which call kernel */
+#ifndef RT_BASEPRI_THRESHOLD
+#define RT_BASEPRI_THRESHOLD           2
+#endif
+
+/* the implemented priority bits of NVIC, it's __NVIC_PRIO_BITS of CMSIS, 3 on nRF52 */
+#ifndef RT_BASEPRI_PRIO_BITS
+#define RT_BASEPRI_PRIO_BITS           3
+#endif
+
+#if RT_BASEPRI_THRESHOLD <= 0 || RT_BASEPRI_THRESHOLD >= (1 << RT_BASEPRI_PRIO_BITS)
+#error "the RT_BASEPRI_THRESHOLD must be 1 ~ (2 ^ RT_BASEPRI_PRIO_BITS - 1), BASEPRI 0 doesn't mask interrupt"
+#endif
+
+/* the BASEPRI of kernel critical section, the interrupts of this priority and lower are masked */
+#define RT_BASEPRI_MASK                (RT_BASEPRI_THRESHOLD << (8 - RT_BASEPRI_PRIO_BITS))
+#endif /* RT_USING_BASEPRI */
+
+/* the masked hook of rt_hw_interrupt_disable, it checks the zero-latency interrupt and counts the masked window */
+#if defined (RT_USING_IRQOFF_STAT) || (defined (RT_USING_BASEPRI) && defined (RT_DEBUG))
+#define RT_HW_INTERRUPT_MASKED_HOOK
+#endif
+
+#endif
@@ -0,0 +1,531 @@
+/*
+ * File      : cpuport.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2014, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version for POSIX host simulator.
+ * 2026-10-17     agent        pend the context switch until interrupt is enabled like PendSV.
+ * 2026-10-17     agent        add the interrupt masked time measurement.
+ * 2026-10-17     agent        nest the interrupt by priority like NVIC, add the cycle counter.
+ * 2026-10-17     agent        add the atomic compare and swap.
+ * 2026-10-17     agent        the atomic compare and swap is used by trace too.
+ * 2026-10-17     agent        simulate the BASEPRI critical section, add the masked window statistics.
+ */
+
+/*
+ * Every RT-Thread thread is run on a host pthread, but only one of them is running at any time. The
+ * context switch hands the CPU over to the next pthread by its semaphore, then waits for its own
+ * semaphore. The interrupt is simulated by a pending flag which is set by the host thread (tick timer,
+ * console input, etc.), and the interrupt service routine is run on the current thread when the
+ * interrupt is enabled (rt_hw_interrupt_enable), so the thread is never preempted inside the libc.
+ * The interrupt service routine is run with interrupt enabled like NVIC, it's preempted by the
+ * interrupt which has higher priority (lower number) when it enables the interrupt.
+ *
+ * With RT_USING_BASEPRI, the interrupts of lower number than RT_BASEPRI_THRESHOLD are zero-latency,
+ * they are not masked by rt_hw_interrupt_disable and they are also served when the interrupt is
+ * disabled, or enabled to the masked level.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+struct sim_thread
+{
+    void       *entry;
+    void       *parameter;
+    void       *exit;
+
+    rt_bool_t   started;
+    pthread_t   pthread;
+    sem_t       resume;
+};
+
+/* the thread stack pointer (thread->sp) is pointed to the simulated thread */
+#define SIM_THREAD(sp_addr)            (*(struct sim_thread **)(*(rt_ubase_t *)(sp_addr)))
+
+/* exception and interrupt handler table */
+rt_ubase_t rt_interrupt_from_thread;
+rt_ubase_t rt_interrupt_to_thread;
+rt_ubase_t rt_thread_switch_interrupt_flag;
+/* exception hook */
+static rt_err_t (*rt_exception_hook)(void *context) = RT_NULL;
+
+/* the simulated PRIMASK, it's only accessed by the running thread */
+static volatile rt_base_t interrupt_masked;
+/* the pending interrupts, it's set by the host threads */
+static rt_uint32_t interrupt_pending;
+/* the running interrupt number, RT_HW_SIM_IRQ_MAX is the thread mode */
+static int interrupt_active = RT_HW_SIM_IRQ_MAX;
+static void (*interrupt_handler[RT_HW_SIM_IRQ_MAX])(void);
+/* the idle thread waits the interrupt by it like WFI */
+static pthread_mutex_t interrupt_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t interrupt_cond = PTHREAD_COND_INITIALIZER;
+
+/* the longest interrupt masked time, it's the thread CPU time so the host scheduling is excluded */
+static rt_bool_t irqoff_measuring, irqoff_started;
+static struct timespec irqoff_start;
+static rt_uint32_t irqoff_max;
+
+#ifdef RT_USING_BASEPRI
+#define SIM_ZERO_LATENCY_MASK          ((1UL << RT_BASEPRI_THRESHOLD) - 1)
+#define SIM_ZERO_LATENCY_PENDING()     (__atomic_load_n(&interrupt_pending, __ATOMIC_ACQUIRE) & SIM_ZERO_LATENCY_MASK)
+#ifdef RT_DEBUG
+/* the zero-latency interrupt which calls kernel is reported once, the assertion calls kernel too */
+static rt_bool_t zero_latency_reported;
+#endif
+#endif
+
+static void sim_context_switch(rt_ubase_t from, rt_ubase_t to);
+
+static void sim_irqoff_begin(void)
+{
+    if (irqoff_measuring)
+    {
+        irqoff_started = RT_TRUE;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &irqoff_start);
+    }
+}
+
+static void sim_irqoff_end(void)
+{
+    struct timespec now;
+    rt_uint32_t time;
+
+    if (irqoff_started)
+    {
+        irqoff_started = RT_FALSE;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        time = (now.tv_sec - irqoff_start.tv_sec) * 1000000000L + now.tv_nsec - irqoff_start.tv_nsec;
+        if (time > irqoff_max)
+            irqoff_max = time;
+    }
+}
+
+static void sim_interrupt_dispatch(void)
+{
+    rt_uint32_t pending;
+    int irq, preempted = interrupt_active;
+
+    while (1)
+    {
+        /* only the interrupt which has higher priority than the running one is served */
+        pending = __atomic_load_n(&interrupt_pending, __ATOMIC_ACQUIRE);
+        if (preempted < RT_HW_SIM_IRQ_MAX)
+            pending &= (1UL << preempted) - 1;
+#ifdef RT_USING_BASEPRI
+        /* only the zero-latency interrupts are not masked by BASEPRI */
+        if (interrupt_masked)
+            pending &= SIM_ZERO_LATENCY_MASK;
+#endif
+        if (pending)
+        {
+            irq = __builtin_ctz(pending);
+            __atomic_fetch_and(&interrupt_pending, ~(1UL << irq), __ATOMIC_ACQ_REL);
+            interrupt_active = irq;
+            if (interrupt_handler[irq] != RT_NULL)
+                interrupt_handler[irq]();
+            interrupt_active = preempted;
+            continue;
+        }
+
+        /* do the context switch when it's returned to thread, like PendSV which has the lowest priority */
+        if (preempted == RT_HW_SIM_IRQ_MAX && rt_thread_switch_interrupt_flag && !interrupt_masked)
+        {
+            rt_thread_switch_interrupt_flag = 0;
+            sim_context_switch(rt_interrupt_from_thread, rt_interrupt_to_thread);
+            continue;
+        }
+
+        break;
+    }
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    rt_base_t level = interrupt_masked;
+
+    interrupt_masked = 1;
+#if defined (RT_USING_BASEPRI) && defined (RT_DEBUG)
+    /* the zero-latency interrupt is not masked by kernel, so the kernel data is not protected in it */
+    if (interrupt_active < RT_BASEPRI_THRESHOLD && !zero_latency_reported)
+    {
+        zero_latency_reported = RT_TRUE;
+        rt_kprintf("interrupt %d is higher than RT_BASEPRI_THRESHOLD, it can't call kernel\n", interrupt_active);
+        RT_ASSERT(interrupt_active >= RT_BASEPRI_THRESHOLD);
+    }
+#endif
+    if (level == 0)
+    {
+        sim_irqoff_begin();
+#ifdef RT_USING_IRQOFF_STAT
+        rt_interrupt_mask_begin(__builtin_return_address(0));
+#endif
+    }
+
+#ifdef RT_USING_BASEPRI
+    if (SIM_ZERO_LATENCY_PENDING())
+        sim_interrupt_dispatch();
+#endif
+
+    return level;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    if (level == 0 && interrupt_masked)
+    {
+        sim_irqoff_end();
+#ifdef RT_USING_IRQOFF_STAT
+        rt_interrupt_mask_end();
+#endif
+    }
+    interrupt_masked = level;
+
+    if (level == 0 && (rt_thread_switch_interrupt_flag
+            || __atomic_load_n(&interrupt_pending, __ATOMIC_ACQUIRE)))
+        sim_interrupt_dispatch();
+#ifdef RT_USING_BASEPRI
+    else if (level != 0 && SIM_ZERO_LATENCY_PENDING())
+        sim_interrupt_dispatch();
+#endif
+}
+
+/**
+ * This function will install a simulated interrupt service routine. The routine should call
+ * rt_interrupt_enter and rt_interrupt_leave like the hardware interrupt handler.
+ *
+ * @param irq the interrupt number
+ * @param handler the interrupt service routine
+ */
+void rt_hw_sim_interrupt_install(int irq, void (*handler)(void))
+{
+    RT_ASSERT(irq >= 0 && irq < RT_HW_SIM_IRQ_MAX);
+
+    interrupt_handler[irq] = handler;
+}
+
+/**
+ * This function will set the simulated interrupt to pending. It's the only function which can be
+ * called by the host thread.
+ *
+ * @param irq the interrupt number
+ */
+void rt_hw_sim_interrupt_trigger(int irq)
+{
+    __atomic_fetch_or(&interrupt_pending, 1UL << irq, __ATOMIC_ACQ_REL);
+
+    pthread_mutex_lock(&interrupt_lock);
+    pthread_cond_signal(&interrupt_cond);
+    pthread_mutex_unlock(&interrupt_lock);
+}
+
+/**
+ * This function will wait for the next interrupt like WFI, the pending interrupt will be served
+ * before return when interrupt is enabled.
+ */
+void rt_hw_sim_interrupt_wait(void)
+{
+    /* the sleep with interrupt masked is not counted, the interrupt still wakes up the CPU */
+    if (interrupt_masked)
+    {
+        sim_irqoff_end();
+#ifdef RT_USING_IRQOFF_STAT
+        rt_interrupt_mask_end();
+#endif
+    }
+
+    pthread_mutex_lock(&interrupt_lock);
+    while (__atomic_load_n(&interrupt_pending, __ATOMIC_ACQUIRE) == 0)
+    {
+        pthread_cond_wait(&interrupt_cond, &interrupt_lock);
+    }
+    pthread_mutex_unlock(&interrupt_lock);
+
+    if (interrupt_masked == 0)
+    {
+        sim_interrupt_dispatch();
+    }
+    else
+    {
+        sim_irqoff_begin();
+#ifdef RT_USING_IRQOFF_STAT
+        /* the masked window after sleep is counted to here */
+        rt_interrupt_mask_begin((void *)rt_hw_sim_interrupt_wait);
+#endif
+#ifdef RT_USING_BASEPRI
+        if (SIM_ZERO_LATENCY_PENDING())
+            sim_interrupt_dispatch();
+#endif
+    }
+}
+
+/**
+ * This function will get the cycle counter, it's the CPU time of host thread in nanosecond.
+ *
+ * @return the cycles
+ */
+rt_uint32_t rt_hw_cycle_get(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+#if defined (RT_USING_MEMPOOL_LOCKFREE) || defined (RT_USING_TRACE)
+/**
+ * This function will set the value to the new one if it's equal to the old one, it's atomic
+ * between the host threads too.
+ *
+ * @param ptr the address of value
+ * @param old the expected value
+ * @param new_value the new value
+ *
+ * @return RT_TRUE if the value is set, RT_FALSE if it's not equal to the old one
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new_value)
+{
+    return __atomic_compare_exchange_n(ptr, &old, new_value, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+/**
+ * This function will start or stop the measurement of the longest interrupt
+ * masked time, the result is cleared when it's started.
+ *
+ * @param enable RT_TRUE to start, RT_FALSE to stop
+ */
+void rt_hw_sim_irqoff_measure(rt_bool_t enable)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (enable)
+        irqoff_max = 0;
+    irqoff_measuring = enable;
+    irqoff_started = RT_FALSE;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will get whether the interrupt is masked by kernel, the zero-latency interrupt
+ * is served in the kernel critical section.
+ *
+ * @return RT_TRUE if the interrupt is masked
+ */
+rt_bool_t rt_hw_sim_interrupt_masked(void)
+{
+    return interrupt_masked != 0;
+}
+
+/**
+ * This function will get the longest interrupt masked time.
+ *
+ * @return the time in nanosecond
+ */
+rt_uint32_t rt_hw_sim_irqoff_max(void)
+{
+    return irqoff_max;
+}
+
+static void *sim_thread_entry(void *parameter)
+{
+    struct sim_thread *thread = (struct sim_thread *)parameter;
+
+    /* the thread is always started with interrupt enabled, same as the exception return */
+    rt_hw_interrupt_enable(0);
+
+    ((void (*)(void *))thread->entry)(thread->parameter);
+    ((void (*)(void))thread->exit)();
+
+    /* never reach here */
+    return RT_NULL;
+}
+
+static void sim_thread_resume(struct sim_thread *thread)
+{
+    pthread_attr_t attr;
+
+    if (thread->started)
+    {
+        sem_post(&thread->resume);
+        return;
+    }
+
+    thread->started = RT_TRUE;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread->pthread, &attr, sim_thread_entry, thread) != 0)
+    {
+        perror("simulated thread create");
+        abort();
+    }
+    pthread_attr_destroy(&attr);
+}
+
+static void sim_context_switch(rt_ubase_t from, rt_ubase_t to)
+{
+    struct sim_thread *from_thread = SIM_THREAD(from);
+    struct sim_thread *to_thread = SIM_THREAD(to);
+    rt_bool_t closed;
+
+    if (from_thread == to_thread)
+        return;
+
+    /* the thread object maybe released by other thread after switched */
+    closed = rt_list_entry(from, struct rt_thread, sp)->stat == RT_THREAD_CLOSE;
+
+    sim_thread_resume(to_thread);
+
+    if (closed)
+    {
+        /* the closed thread will never be switched back */
+        sem_destroy(&from_thread->resume);
+        free(from_thread);
+        pthread_exit(RT_NULL);
+    }
+
+    while (sem_wait(&from_thread->resume) != 0);
+}
+
+rt_uint8_t *rt_hw_stack_init(void       *tentry,
+                             void       *parameter,
+                             rt_uint8_t *stack_addr,
+                             void       *texit)
+{
+    struct sim_thread *thread;
+    rt_uint8_t        *stk;
+
+    thread = (struct sim_thread *)malloc(sizeof(struct sim_thread));
+    if (thread == RT_NULL)
+    {
+        perror("simulated thread");
+        abort();
+    }
+    thread->entry     = tentry;
+    thread->parameter = parameter;
+    thread->exit      = texit;
+    thread->started   = RT_FALSE;
+    sem_init(&thread->resume, 0, 0);
+
+    /* the code is run on the host thread stack, so only the simulated thread is saved on the stack */
+    stk  = stack_addr + sizeof(rt_uint32_t);
+    stk  = (rt_uint8_t *)RT_ALIGN_DOWN((rt_ubase_t)stk, sizeof(void *));
+    stk -= sizeof(struct sim_thread *);
+    *(struct sim_thread **)stk = thread;
+
+    /* return task's current stack address */
+    return stk;
+}
+
+/* the context switch is pended until the interrupt is enabled, same as the PendSV on Cortex-M */
+void rt_hw_context_switch(rt_ubase_t from, rt_ubase_t to)
+{
+    rt_hw_context_switch_interrupt(from, to);
+
+    if (interrupt_masked == 0)
+        sim_interrupt_dispatch();
+}
+
+void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to)
+{
+    if (rt_thread_switch_interrupt_flag == 0)
+    {
+        rt_thread_switch_interrupt_flag = 1;
+        rt_interrupt_from_thread = from;
+    }
+    rt_interrupt_to_thread = to;
+}
+
+void rt_hw_context_switch_to(rt_ubase_t to)
+{
+    rt_interrupt_from_thread = 0;
+    rt_thread_switch_interrupt_flag = 0;
+
+#ifdef RT_USING_IRQOFF_STAT
+    /* the masked window of startup is not counted, it's ended by exception return on the target */
+    rt_interrupt_mask_begin(RT_NULL);
+#endif
+
+    sim_thread_resume(SIM_THREAD(to));
+
+    /* the startup context is never switched back */
+    while (1)
+    {
+        pause();
+    }
+}
+
+static void sim_exception_handler(int sig, siginfo_t *info, void *context)
+{
+    extern long list_thread(void);
+
+    if (rt_exception_hook != RT_NULL)
+    {
+        rt_err_t result;
+
+        result = rt_exception_hook(context);
+        if (result == RT_EOK) return;
+    }
+
+    rt_kprintf("%s at address: %p\n", strsignal(sig), info->si_addr);
+    rt_kprintf("hard fault on thread: %s\n", rt_thread_self()->name);
+
+#ifdef RT_USING_FINSH
+    list_thread();
+#endif
+
+    /* the signal will be raised again by default action when it's returned */
+    signal(sig, SIG_DFL);
+}
+
+/**
+ * This function set the hook, which is invoked on fault exception handling.
+ *
+ * @param exception_handle the exception handling hook function.
+ */
+void rt_hw_exception_install(rt_err_t (*exception_handle)(void* context))
+{
+    static const int fault_signals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE };
+    struct sigaction action;
+    size_t i;
+
+    rt_exception_hook = exception_handle;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = sim_exception_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    for (i = 0; i < sizeof(fault_signals) / sizeof(fault_signals[0]); i++)
+    {
+        sigaction(fault_signals[i], &action, RT_NULL);
+    }
+}
+
+/**
+ * shutdown CPU
+ */
+void rt_hw_cpu_shutdown(void)
+{
+    rt_kprintf("shutdown...\n");
+
+    fflush(stdout);
+    exit(0);
+}
@@ -0,0 +1,40 @@
+/*
+ * File      : cpuport.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2014, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version for POSIX host simulator.
+ * 2026-10-17     agent        add the interrupt masked time measurement.
+ * 2026-10-17     agent        nest the interrupt by priority like NVIC.
+ * 2026-10-17     agent        add the zero-latency interrupts of BASEPRI critical section.
+ */
+
+#ifndef __CPUPORT_H__
+#define __CPUPORT_H__
+
+#include <rtthread.h>
+
+/* the simulated interrupt number, the lower number has the higher priority and it can preempt the others */
+#define RT_HW_SIM_IRQ_MAX              32
+
+#ifdef RT_USING_BASEPRI
+/* the interrupts of lower number than it are zero-latency, they are never masked by kernel and can't call kernel */
+#ifndef RT_BASEPRI_THRESHOLD
+#define RT_BASEPRI_THRESHOLD           2
+#endif
+#endif
+
+void rt_hw_sim_interrupt_install(int irq, void (*handler)(void));
+void rt_hw_sim_interrupt_trigger(int irq);
+void rt_hw_sim_interrupt_wait(void);
+rt_bool_t rt_hw_sim_interrupt_masked(void);
+void rt_hw_sim_irqoff_measure(rt_bool_t enable);
+rt_uint32_t rt_hw_sim_irqoff_max(void);
+
+#endif
@@ -26,6 +26,7 @@
  * 2012-12-25     Bernard      return RT_EOK if the device interface not exist.
  * 2013-07-09     Grissiom     add ref_count support
  * 2016-04-02     Bernard      fix the open_flag initialization issue.
+ * 2026-10-17     agent        find device by the name hash index of object container.
  */
 
 #include <rtthread.h>
@@ -100,8 +101,6 @@ rt_err_t rt_device_init_all(void)
 rt_device_t rt_device_find(const char *name)
 {
     struct rt_object *object;
-    struct rt_list_node *node;
-    struct rt_object_information *information;
 
     extern struct rt_object_information rt_object_container[];
 
@@ -110,28 +109,13 @@ rt_device_t rt_device_find(const char *name)
         rt_enter_critical();
 
     /* try to find device object */
-    information = &rt_object_container[RT_Object_Class_Device];
-    for (node  = information->object_list.next;
-         node != &(information->object_list);
-         node  = node->next)
-    {
-        object = rt_list_entry(node, struct rt_object, list);
-        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
-        {
-            /* leave critical */
-            if (rt_thread_self() != RT_NULL)
-                rt_exit_critical();
-
-            return (rt_device_t)object;
-        }
-    }
+    object = rt_object_lookup(&rt_object_container[RT_Object_Class_Device], name);
 
     /* leave critical */
     if (rt_thread_self() != RT_NULL)
         rt_exit_critical();
 
-    /* not found */
-    return RT_NULL;
+    return (rt_device_t)object;
 }
 RTM_EXPORT(rt_device_find);
 
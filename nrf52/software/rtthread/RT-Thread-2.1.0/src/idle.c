@@ -25,6 +25,9 @@
  * 2013-12-21     Grissiom     let rt_thread_idle_excute loop until there is no
  *                             dead thread.
  * 2016-08-09     ArdaFu       add method to get the handler of the idle thread.
+ * 2026-10-17     agent        add tickless idle, the tick is stopped until next timer timeout.
+ * 2026-10-17     agent        lock the scheduler in timer check after tickless sleep.
+ * 2026-10-17     agent        free the thread stack to stack cache.
  */
 
 #include <rthw.h>
@@ -150,7 +153,11 @@ void rt_thread_idle_excute(void)
         else
 #endif
         /* release thread's stack */
+#ifdef RT_USING_OBJCACHE
+        rt_objcache_stack_free(thread->stack_addr, thread->stack_size);
+#else
         RT_KERNEL_FREE(thread->stack_addr);
+#endif
         /* delete thread object */
         rt_object_delete((rt_object_t)thread);
 #endif
@@ -175,12 +182,60 @@ void rt_thread_idle_excute(void)
     }
 }
 
+#ifdef RT_USING_TICKLESS
+extern void rt_timer_check(void);
+
+/**
+ * This function will sleep until the next timer timeout or interrupt, and
+ * catch the system tick up in one step after wakeup.
+ */
+static void rt_thread_idle_tickless(void)
+{
+    rt_base_t level;
+    rt_tick_t timeout_tick, sleep_tick;
+
+    /* the interrupt which wakes up the CPU is served after the tick is caught up */
+    level = rt_hw_interrupt_disable();
+
+    /* the thread sleep and the software timer thread are on this list too */
+    timeout_tick = rt_timer_next_timeout_tick();
+    if (timeout_tick != RT_TICK_MAX)
+    {
+        timeout_tick -= rt_tick_get();
+        /* the timer is timeout but not checked yet */
+        if (timeout_tick >= RT_TICK_MAX / 2)
+            timeout_tick = 0;
+    }
+
+    sleep_tick = rt_hw_tickless_sleep(timeout_tick);
+    if (sleep_tick > 0)
+        rt_tick_set(rt_tick_get() + sleep_tick);
+
+    rt_hw_interrupt_enable(level);
+
+    /*
+     * the timer is not checked by tick interrupt when sleep. The scheduler is
+     * locked, otherwise the idle thread is preempted by the woken thread in
+     * checking, and the tick interrupt skips the check until idle runs again.
+     */
+    if (sleep_tick > 0)
+    {
+        rt_enter_critical();
+        rt_timer_check();
+        rt_exit_critical();
+    }
+}
+#endif
+
 static void rt_thread_idle_entry(void *parameter)
 {
     while (1)
     {
         RT_OBJECT_HOOK_CALL(rt_thread_idle_hook,());
         rt_thread_idle_excute();
+#ifdef RT_USING_TICKLESS
+        rt_thread_idle_tickless();
+#endif
     }
 }
 
@@ -46,6 +46,9 @@
  * 2010-11-10     Bernard      add IPC reset command implementation.
  * 2011-12-18     Bernard      add more parameter checking in message queue
  * 2013-09-14     Grissiom     add an option check in rt_event_recv
+ * 2026-10-17     agent        add zero-copy message queue with loaned message
+ * 2026-10-17     agent        add batch send and receive of mailbox and message queue
+ * 2026-10-17     agent        add reader/writer lock with writer preference
  */
 
 #include <rtthread.h>
@@ -158,6 +161,28 @@ rt_inline rt_err_t rt_ipc_list_resume(rt_list_t *list)
     return RT_EOK;
 }
 
+/**
+ * This function will resume the first count threads in a list, it's used by
+ * the batch send and receive, which may wake up a thread for each message.
+ *
+ * @param list the thread list
+ * @param count the max count of threads to resume
+ *
+ * @return the count of resumed threads
+ */
+rt_inline rt_size_t rt_ipc_list_resume_n(rt_list_t *list, rt_size_t count)
+{
+    rt_size_t resumed = 0;
+
+    while (resumed < count && !rt_list_isempty(list))
+    {
+        rt_ipc_list_resume(list);
+        resumed ++;
+    }
+
+    return resumed;
+}
+
 /**
  * This function will resume all suspended threads in a list, including
  * suspend list of IPC object and private list of mailbox etc.
@@ -1676,6 +1701,276 @@ rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_uint32_t *value, rt_int32_t timeout)
 }
 RTM_EXPORT(rt_mb_recv);
 
+/**
+ * This function will send a batch of mails to mailbox object in one critical
+ * section. If the mailbox is full, current thread will be suspended until
+ * there is a free entry or timeout, then the mails are sent as many as the
+ * free entries. The threads suspended on mailbox object are waked up for the
+ * mails, and the scheduler is called once.
+ *
+ * @param mb the mailbox object
+ * @param values the mails
+ * @param count the count of mails
+ * @param timeout the waiting time
+ *
+ * @return the count of sent mails, 0 if timeout or error
+ */
+rt_size_t rt_mb_send_n(rt_mailbox_t       mb,
+                       const rt_uint32_t *values,
+                       rt_size_t          count,
+                       rt_int32_t         timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t index;
+
+    /* parameter check */
+    RT_ASSERT(mb != RT_NULL);
+    RT_ASSERT(values != RT_NULL);
+
+    if (count == 0)
+        return 0;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mb->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* mailbox is full */
+    while (mb->entry == mb->size)
+    {
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            return 0;
+        }
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(mb->suspend_sender_thread),
+                            thread,
+                            mb->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mb_send_n: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+            return 0;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* send the mails as many as the free entries */
+    if (count > (rt_size_t)(mb->size - mb->entry))
+        count = mb->size - mb->entry;
+    for (index = 0; index < count; index ++)
+    {
+        mb->msg_pool[mb->in_offset] = values[index];
+        /* increase input offset */
+        ++ mb->in_offset;
+        if (mb->in_offset >= mb->size)
+            mb->in_offset = 0;
+    }
+    /* increase message entry */
+    mb->entry += count;
+
+    /* resume suspended threads, one for each mail */
+    if (rt_ipc_list_resume_n(&(mb->parent.suspend_thread), count) > 0)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return count;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return count;
+}
+RTM_EXPORT(rt_mb_send_n);
+
+/**
+ * This function will receive a batch of mails from mailbox object in one
+ * critical section. If there is no mail in mailbox object, the thread shall
+ * wait for a specified time, then the mails are received as many as in the
+ * mailbox. The threads suspended on sending are waked up for the free
+ * entries, and the scheduler is called once.
+ *
+ * @param mb the mailbox object
+ * @param values the received mails will be saved in
+ * @param count the max count of mails
+ * @param timeout the waiting time
+ *
+ * @return the count of received mails, 0 if timeout or error
+ */
+rt_size_t rt_mb_recv_n(rt_mailbox_t mb,
+                       rt_uint32_t *values,
+                       rt_size_t    count,
+                       rt_int32_t   timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t index;
+
+    /* parameter check */
+    RT_ASSERT(mb != RT_NULL);
+    RT_ASSERT(values != RT_NULL);
+
+    if (count == 0)
+        return 0;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mb->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* mailbox is empty */
+    while (mb->entry == 0)
+    {
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            return 0;
+        }
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(mb->parent.suspend_thread),
+                            thread,
+                            mb->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mb_recv_n: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+            return 0;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* receive the mails as many as in the mailbox */
+    if (count > mb->entry)
+        count = mb->entry;
+    for (index = 0; index < count; index ++)
+    {
+        values[index] = mb->msg_pool[mb->out_offset];
+        /* increase output offset */
+        ++ mb->out_offset;
+        if (mb->out_offset >= mb->size)
+            mb->out_offset = 0;
+    }
+    /* decrease message entry */
+    mb->entry -= count;
+
+    /* resume suspended threads, one for each free entry */
+    if (rt_ipc_list_resume_n(&(mb->suspend_sender_thread), count) > 0)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mb->parent.parent)));
+
+        rt_schedule();
+
+        return count;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mb->parent.parent)));
+
+    return count;
+}
+RTM_EXPORT(rt_mb_recv_n);
+
 /**
  * This function can get or set some extra attributions of a mailbox object.
  *
@@ -1724,6 +2019,21 @@ struct rt_mq_message
     struct rt_mq_message *next;
 };
 
+/* get the message header of the loaned or received message buffer */
+rt_inline struct rt_mq_message *_rt_mq_message(rt_mq_t mq, void *buffer)
+{
+    struct rt_mq_message *msg = (struct rt_mq_message *)buffer - 1;
+
+    /* the message shall be in the pool of message queue */
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+    RT_ASSERT(((rt_uint8_t *)msg - (rt_uint8_t *)mq->msg_pool) %
+              (mq->msg_size + sizeof(struct rt_mq_message)) == 0);
+
+    return msg;
+}
+
 /**
  * This function will initialize a message queue and put it under control of
  * resource management.
@@ -2083,52 +2393,145 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, void *buffer, rt_size_t size)
 RTM_EXPORT(rt_mq_urgent);
 
 /**
- * This function will receive a message from message queue object, if there is
- * no message in message queue object, the thread shall wait for a specified
- * time.
+ * This function will loan a free message of message queue object, so the
+ * message is filled in place of the queue without copy. The message must be
+ * sent by rt_mq_commit, or given back by rt_mq_release.
  *
  * @param mq the message queue object
- * @param buffer the received message will be saved in
- * @param size the size of buffer
- * @param timeout the waiting time
  *
- * @return the error code
+ * @return the message which size is the msg_size of queue, RT_NULL if the
+ *         message queue is full
  */
-rt_err_t rt_mq_recv(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+void *rt_mq_loan(rt_mq_t mq)
 {
-    struct rt_thread *thread;
     register rt_ubase_t temp;
     struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
 
     RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
 
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
-    /* for non-blocking call */
-    if (mq->entry == 0 && timeout == 0)
+    /* get a free list */
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    /* message queue is full */
+    if (msg == RT_NULL)
     {
+        /* enable interrupt */
         rt_hw_interrupt_enable(temp);
 
-        return -RT_ETIMEOUT;
+        return RT_NULL;
     }
+    /* move free list pointer */
+    mq->msg_queue_free = msg->next;
 
-    /* message queue is empty */
-    while (mq->entry == 0)
-    {
-        RT_DEBUG_IN_THREAD_CONTEXT;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return msg + 1;
+}
+RTM_EXPORT(rt_mq_loan);
+
+/**
+ * This function will send a message which is loaned by rt_mq_loan and filled,
+ * to the tail of message queue object. If there are threads suspended on
+ * message queue object, it will be waked up.
+ *
+ * @param mq the message queue object
+ * @param buffer the loaned message
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = _rt_mq_message(mq, buffer);
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* the msg is the new tailer of list, the next shall be NULL */
+    msg->next = RT_NULL;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* link msg to message queue */
+    if (mq->msg_queue_tail != RT_NULL)
+    {
+        /* if the tail exists, */
+        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
+    }
+
+    /* set new tail */
+    mq->msg_queue_tail = msg;
+    /* if the head is empty, set head */
+    if (mq->msg_queue_head == RT_NULL)
+        mq->msg_queue_head = msg;
+
+    /* increase message entry */
+    mq->entry ++;
+
+    /* resume suspended thread */
+    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        rt_ipc_list_resume(&(mq->parent.suspend_thread));
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_commit);
+
+/*
+ * wait and take the messages from the head of queue, the count is the max
+ * count of messages on input and the taken count on output, and the taken
+ * messages are still linked by next
+ */
+static rt_err_t _rt_mq_recv_message(rt_mq_t               mq,
+                                    struct rt_mq_message **message,
+                                    rt_size_t            *count,
+                                    rt_int32_t            timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg, *last;
+    rt_uint32_t tick_delta;
+    rt_size_t index;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* for non-blocking call */
+    if (mq->entry == 0 && timeout == 0)
+    {
+        rt_hw_interrupt_enable(temp);
+
+        return -RT_ETIMEOUT;
+    }
+
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        RT_DEBUG_IN_THREAD_CONTEXT;
 
         /* reset error number in thread */
         thread->error = RT_EOK;
@@ -2191,21 +2594,60 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
         }
     }
 
-    /* get message from queue */
+    /* get messages from queue, as many as in the queue */
+    if (*count > mq->entry)
+        *count = mq->entry;
     msg = (struct rt_mq_message *)mq->msg_queue_head;
+    for (last = msg, index = 1; index < *count; index ++)
+        last = last->next;
 
     /* move message queue head */
-    mq->msg_queue_head = msg->next;
+    mq->msg_queue_head = last->next;
     /* reach queue tail, set to NULL */
-    if (mq->msg_queue_tail == msg)
+    if (mq->msg_queue_tail == last)
         mq->msg_queue_tail = RT_NULL;
 
     /* decrease message entry */
-    mq->entry --;
+    mq->entry -= *count;
 
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
 
+    *message = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will receive a message from message queue object, if there is
+ * no message in message queue object, the thread shall wait for a specified
+ * time.
+ *
+ * @param mq the message queue object
+ * @param buffer the received message will be saved in
+ * @param size the size of buffer
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_recv(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+    rt_size_t count = 1;
+    rt_err_t result;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    result = _rt_mq_recv_message(mq, &msg, &count, timeout);
+    if (result != RT_EOK)
+        return result;
+
     /* copy message */
     rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
 
@@ -2223,6 +2665,225 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 }
 RTM_EXPORT(rt_mq_recv);
 
+/**
+ * This function will receive a message from message queue object without
+ * copy, the message is read in place of the queue. If there is no message in
+ * message queue object, the thread shall wait for a specified time. The
+ * message must be given back by rt_mq_release after it's used.
+ *
+ * @param mq the message queue object
+ * @param buffer the address of message in the queue will be saved in, the
+ *        size of message is the msg_size of queue
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_recv_ref(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_size_t count = 1;
+    rt_err_t result;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+
+    result = _rt_mq_recv_message(mq, &msg, &count, timeout);
+    if (result != RT_EOK)
+        return result;
+
+    *buffer = msg + 1;
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv_ref);
+
+/**
+ * This function will give back a message which is received by rt_mq_recv_ref
+ * or loaned by rt_mq_loan but not committed, to the free list of message
+ * queue object.
+ *
+ * @param mq the message queue object
+ * @param buffer the message
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = _rt_mq_message(mq, buffer);
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* put message to free list */
+    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_release);
+
+/**
+ * This function will send a batch of messages to message queue object. The
+ * free messages are taken and linked to the queue in one critical section
+ * each, as many as the free messages. The threads suspended on message queue
+ * object are waked up for the messages, and the scheduler is called once.
+ *
+ * @param mq the message queue object
+ * @param buffer the messages, which are placed one by one
+ * @param size the size of each message in buffer
+ * @param count the count of messages
+ *
+ * @return the count of sent messages, 0 if the message queue is full or error
+ */
+rt_size_t rt_mq_send_n(rt_mq_t mq, const void *buffer, rt_size_t size, rt_size_t count)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg, *last;
+    rt_size_t index;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size || count == 0)
+        return 0;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* get the free messages as many as there are */
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    if (msg == RT_NULL)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        return 0;
+    }
+    for (last = msg, index = 1; index < count && last->next != RT_NULL; index ++)
+        last = last->next;
+    count = index;
+    /* move free list pointer */
+    mq->msg_queue_free = last->next;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    /* copy buffer, the messages are still linked by next */
+    for (last = msg, index = 0; index < count; index ++)
+    {
+        rt_memcpy(last + 1, (const rt_uint8_t *)buffer + index * size, size);
+        if (index + 1 < count)
+            last = last->next;
+    }
+    /* the last msg is the new tailer of list, the next shall be NULL */
+    last->next = RT_NULL;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* link msg to message queue */
+    if (mq->msg_queue_tail != RT_NULL)
+    {
+        /* if the tail exists, */
+        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
+    }
+
+    /* set new tail */
+    mq->msg_queue_tail = last;
+    /* if the head is empty, set head */
+    if (mq->msg_queue_head == RT_NULL)
+        mq->msg_queue_head = msg;
+
+    /* increase message entry */
+    mq->entry += count;
+
+    /* resume suspended threads, one for each message */
+    if (rt_ipc_list_resume_n(&(mq->parent.suspend_thread), count) > 0)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return count;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return count;
+}
+RTM_EXPORT(rt_mq_send_n);
+
+/**
+ * This function will receive a batch of messages from message queue object.
+ * If there is no message in message queue object, the thread shall wait for
+ * a specified time, then the messages are taken in one critical section, as
+ * many as in the queue.
+ *
+ * @param mq the message queue object
+ * @param buffer the received messages will be saved in one by one
+ * @param size the size of each message in buffer
+ * @param count the max count of messages
+ * @param timeout the waiting time
+ *
+ * @return the count of received messages, 0 if timeout or error
+ */
+rt_size_t rt_mq_recv_n(rt_mq_t    mq,
+                       void      *buffer,
+                       rt_size_t  size,
+                       rt_size_t  count,
+                       rt_int32_t timeout)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg, *last;
+    rt_size_t index;
+
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    if (count == 0)
+        return 0;
+
+    if (_rt_mq_recv_message(mq, &msg, &count, timeout) != RT_EOK)
+        return 0;
+
+    /* copy messages */
+    for (last = msg, index = 0; index < count; index ++)
+    {
+        rt_memcpy((rt_uint8_t *)buffer + index * size, last + 1,
+                  size > mq->msg_size ? mq->msg_size : size);
+        if (index + 1 < count)
+            last = last->next;
+    }
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* put messages to free list */
+    last->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return count;
+}
+RTM_EXPORT(rt_mq_recv_n);
+
 /**
  * This function can get or set some extra attributions of a message queue
  * object.
@@ -2281,4 +2942,482 @@ rt_err_t rt_mq_control(rt_mq_t mq, rt_uint8_t cmd, void *arg)
 RTM_EXPORT(rt_mq_control);
 #endif /* end of RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_RWLOCK
+/*
+ * The lock is handed over by the release: the next writer becomes the owner,
+ * or all suspended readers hold the lock when there is no suspended writer,
+ * before they are resumed. So the resumed thread holds the lock already.
+ * The new readers are suspended when a writer is suspended, and the owner
+ * inherits the priority of the suspended writers and readers.
+ */
+
+/* hand over the free lock to the suspended threads, return whether a thread is resumed */
+static rt_bool_t _rt_rwlock_hand_over(rt_rwlock_t rwlock)
+{
+    struct rt_thread *thread;
+
+    /* the writers are preferred */
+    if (!rt_list_isempty(&(rwlock->parent.suspend_thread)))
+    {
+        /* get suspended thread */
+        thread = rt_list_entry(rwlock->parent.suspend_thread.next,
+                               struct rt_thread,
+                               tlist);
+
+        RT_DEBUG_LOG(RT_DEBUG_IPC, ("rwlock: hand over to writer: %s\n",
+                                    thread->name));
+
+        /* set new owner and priority */
+        rwlock->owner             = thread;
+        rwlock->original_priority = thread->current_priority;
+        rwlock->hold              = 1;
+
+        /* resume thread */
+        rt_ipc_list_resume(&(rwlock->parent.suspend_thread));
+
+        return RT_TRUE;
+    }
+
+    /* all suspended readers hold the lock */
+    if (!rt_list_isempty(&(rwlock->suspend_reader_thread)))
+    {
+        while (!rt_list_isempty(&(rwlock->suspend_reader_thread)))
+        {
+            rwlock->readers ++;
+            rt_ipc_list_resume(&(rwlock->suspend_reader_thread));
+        }
+
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* the owner inherits the priority of the suspending thread */
+rt_inline void _rt_rwlock_inherit(rt_rwlock_t rwlock, struct rt_thread *thread)
+{
+    if (rwlock->owner != RT_NULL &&
+        thread->current_priority < rwlock->owner->current_priority)
+    {
+        /* change the owner thread priority */
+        rt_thread_control(rwlock->owner,
+                          RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &thread->current_priority);
+    }
+}
+
+/* suspend the thread on the list of lock, and wait until it's handed over */
+static rt_err_t _rt_rwlock_suspend(rt_rwlock_t       rwlock,
+                                   rt_list_t        *list,
+                                   struct rt_thread *thread,
+                                   rt_int32_t        time,
+                                   rt_base_t         temp)
+{
+    _rt_rwlock_inherit(rwlock, thread);
+
+    /* suspend current thread */
+    rt_ipc_list_suspend(list, thread, rwlock->parent.parent.flag);
+
+    /* has waiting time, start thread timer */
+    if (time > 0)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_IPC,
+                     ("rwlock: start the timer of thread:%s\n",
+                      thread->name));
+
+        /* reset the timeout of thread timer and start it */
+        rt_timer_control(&(thread->thread_timer),
+                         RT_TIMER_CTRL_SET_TIME,
+                         &time);
+        rt_timer_start(&(thread->thread_timer));
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    /* do schedule */
+    rt_schedule();
+
+    if (thread->error != RT_EOK && list == &(rwlock->parent.suspend_thread))
+    {
+        /*
+         * the readers which are suspended by this writer are resumed, when
+         * there is no other writer and the lock is held by readers
+         */
+        temp = rt_hw_interrupt_disable();
+        if (rwlock->owner == RT_NULL && rt_list_isempty(&(rwlock->parent.suspend_thread))
+                && _rt_rwlock_hand_over(rwlock))
+        {
+            rt_hw_interrupt_enable(temp);
+            rt_schedule();
+        }
+        else
+        {
+            rt_hw_interrupt_enable(temp);
+        }
+    }
+
+    return thread->error;
+}
+
+/**
+ * This function will initialize a reader/writer lock and put it under control
+ * of resource management.
+ *
+ * @param rwlock the reader/writer lock object
+ * @param name the name of reader/writer lock
+ * @param flag the flag of reader/writer lock
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_rwlock_init(rt_rwlock_t rwlock, const char *name, rt_uint8_t flag)
+{
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* init object */
+    rt_object_init(&(rwlock->parent.parent), RT_Object_Class_RWLock, name);
+
+    /* init ipc object */
+    rt_ipc_object_init(&(rwlock->parent));
+
+    rwlock->readers           = 0;
+    rwlock->owner             = RT_NULL;
+    rwlock->original_priority = 0xFF;
+    rwlock->hold              = 0;
+    rt_list_init(&(rwlock->suspend_reader_thread));
+
+    /* set flag */
+    rwlock->parent.parent.flag = flag;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_init);
+
+/**
+ * This function will detach a reader/writer lock from resource management
+ *
+ * @param rwlock the reader/writer lock object
+ *
+ * @return the operation status, RT_EOK on successful
+ *
+ * @see rt_rwlock_delete
+ */
+rt_err_t rt_rwlock_detach(rt_rwlock_t rwlock)
+{
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* wakeup all suspend threads */
+    rt_ipc_list_resume_all(&(rwlock->parent.suspend_thread));
+    rt_ipc_list_resume_all(&(rwlock->suspend_reader_thread));
+
+    /* detach reader/writer lock object */
+    rt_object_detach(&(rwlock->parent.parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_detach);
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create a reader/writer lock from system resource
+ *
+ * @param name the name of reader/writer lock
+ * @param flag the flag of reader/writer lock
+ *
+ * @return the created reader/writer lock, RT_NULL on error happen
+ *
+ * @see rt_rwlock_init
+ */
+rt_rwlock_t rt_rwlock_create(const char *name, rt_uint8_t flag)
+{
+    struct rt_rwlock *rwlock;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate object */
+    rwlock = (rt_rwlock_t)rt_object_allocate(RT_Object_Class_RWLock, name);
+    if (rwlock == RT_NULL)
+        return rwlock;
+
+    /* init ipc object */
+    rt_ipc_object_init(&(rwlock->parent));
+
+    rwlock->readers           = 0;
+    rwlock->owner             = RT_NULL;
+    rwlock->original_priority = 0xFF;
+    rwlock->hold              = 0;
+    rt_list_init(&(rwlock->suspend_reader_thread));
+
+    /* set flag */
+    rwlock->parent.parent.flag = flag;
+
+    return rwlock;
+}
+RTM_EXPORT(rt_rwlock_create);
+
+/**
+ * This function will delete a reader/writer lock object and release the memory
+ *
+ * @param rwlock the reader/writer lock object
+ *
+ * @return the error code
+ *
+ * @see rt_rwlock_detach
+ */
+rt_err_t rt_rwlock_delete(rt_rwlock_t rwlock)
+{
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* wakeup all suspend threads */
+    rt_ipc_list_resume_all(&(rwlock->parent.suspend_thread));
+    rt_ipc_list_resume_all(&(rwlock->suspend_reader_thread));
+
+    /* delete reader/writer lock object */
+    rt_object_delete(&(rwlock->parent.parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_delete);
+#endif
+
+/**
+ * This function will take a reader/writer lock for reading, which is shared
+ * with other readers. If the lock is held or waited by a writer, the thread
+ * shall wait for a specified time. The read lock is not recursive, but the
+ * writer which holds the lock can take it again for reading.
+ *
+ * @param rwlock the reader/writer lock object
+ * @param time the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_rwlock_take_read(rt_rwlock_t rwlock, rt_int32_t time)
+{
+    register rt_base_t temp;
+    struct rt_thread *thread;
+
+    /* this function must not be used in interrupt even if time = 0 */
+    RT_DEBUG_IN_THREAD_CONTEXT;
+
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(rwlock->parent.parent)));
+
+    /* reset thread error */
+    thread->error = RT_EOK;
+
+    if (rwlock->owner == thread)
+    {
+        /* the writer reads its data */
+        rwlock->hold ++;
+    }
+    else if (rwlock->owner == RT_NULL && rt_list_isempty(&(rwlock->parent.suspend_thread)))
+    {
+        /* no writer holds or waits the lock */
+        rwlock->readers ++;
+    }
+    else
+    {
+        /* no waiting, return with timeout */
+        if (time == 0)
+        {
+            /* set error as timeout */
+            thread->error = -RT_ETIMEOUT;
+
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            return -RT_ETIMEOUT;
+        }
+
+        RT_DEBUG_LOG(RT_DEBUG_IPC, ("rwlock_take_read: suspend thread: %s\n",
+                                    thread->name));
+
+        /* the lock is held as the reader when it's resumed */
+        if (_rt_rwlock_suspend(rwlock, &(rwlock->suspend_reader_thread), thread, time, temp) != RT_EOK)
+            return thread->error;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(rwlock->parent.parent)));
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(rwlock->parent.parent)));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_take_read);
+
+/**
+ * This function will take a reader/writer lock for writing, which is
+ * exclusive. If the lock is held by other writer or readers, the thread
+ * shall wait for a specified time, and the writer which holds the lock
+ * inherits its priority. The readers which hold the lock don't inherit it,
+ * they aren't recorded. The write lock is recursive.
+ *
+ * @param rwlock the reader/writer lock object
+ * @param time the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_rwlock_take_write(rt_rwlock_t rwlock, rt_int32_t time)
+{
+    register rt_base_t temp;
+    struct rt_thread *thread;
+
+    /* this function must not be used in interrupt even if time = 0 */
+    RT_DEBUG_IN_THREAD_CONTEXT;
+
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(rwlock->parent.parent)));
+
+    /* reset thread error */
+    thread->error = RT_EOK;
+
+    if (rwlock->owner == thread)
+    {
+        /* it's the same thread */
+        rwlock->hold ++;
+    }
+    else if (rwlock->owner == RT_NULL && rwlock->readers == 0)
+    {
+        /* set lock owner and original priority */
+        rwlock->owner             = thread;
+        rwlock->original_priority = thread->current_priority;
+        rwlock->hold              = 1;
+    }
+    else
+    {
+        /* no waiting, return with timeout */
+        if (time == 0)
+        {
+            /* set error as timeout */
+            thread->error = -RT_ETIMEOUT;
+
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            return -RT_ETIMEOUT;
+        }
+
+        RT_DEBUG_LOG(RT_DEBUG_IPC, ("rwlock_take_write: suspend thread: %s\n",
+                                    thread->name));
+
+        /* the lock is owned when it's resumed */
+        if (_rt_rwlock_suspend(rwlock, &(rwlock->parent.suspend_thread), thread, time, temp) != RT_EOK)
+            return thread->error;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(rwlock->parent.parent)));
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(rwlock->parent.parent)));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_take_write);
+
+/**
+ * This function will release a reader/writer lock which is taken for reading
+ * or writing. When the lock is free, it's handed over to the first suspended
+ * writer, or to all suspended readers if there is no suspended writer.
+ *
+ * @param rwlock the reader/writer lock object
+ *
+ * @return the error code
+ */
+rt_err_t rt_rwlock_release(rt_rwlock_t rwlock)
+{
+    register rt_base_t temp;
+    struct rt_thread *thread;
+    rt_bool_t need_schedule;
+
+    need_schedule = RT_FALSE;
+
+    /* only thread could release lock because we need test the ownership */
+    RT_DEBUG_IN_THREAD_CONTEXT;
+
+    RT_ASSERT(rwlock != RT_NULL);
+
+    /* get current thread */
+    thread = rt_thread_self();
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(rwlock->parent.parent)));
+
+    if (rwlock->owner == thread)
+    {
+        /* decrease hold */
+        rwlock->hold --;
+        if (rwlock->hold == 0)
+        {
+            /* change the owner thread to original priority */
+            if (rwlock->original_priority != thread->current_priority)
+            {
+                rt_thread_control(thread,
+                                  RT_THREAD_CTRL_CHANGE_PRIORITY,
+                                  &(rwlock->original_priority));
+            }
+
+            /* clear owner */
+            rwlock->owner             = RT_NULL;
+            rwlock->original_priority = 0xFF;
+
+            need_schedule = _rt_rwlock_hand_over(rwlock);
+        }
+    }
+    else if (rwlock->owner == RT_NULL && rwlock->readers > 0)
+    {
+        /* decrease readers */
+        rwlock->readers --;
+        if (rwlock->readers == 0)
+            need_schedule = _rt_rwlock_hand_over(rwlock);
+    }
+    else
+    {
+        /* the lock is not held by this thread */
+        thread->error = -RT_ERROR;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        return -RT_ERROR;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    /* perform a schedule */
+    if (need_schedule == RT_TRUE)
+        rt_schedule();
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_release);
+#endif /* end of RT_USING_RWLOCK */
+
 /**@}*/
@@ -22,6 +22,7 @@
  * 2006-02-24     Bernard      first version
  * 2006-05-03     Bernard      add IRQ_DEBUG
  * 2016-08-09     ArdaFu       add interrupt enter and leave hook.
+ * 2026-10-17     agent        add the longest interrupt masked window of each call site.
  */
 
 #include <rthw.h>
@@ -29,8 +30,8 @@
 
 #ifdef RT_USING_HOOK
 
-static void (*rt_interrupt_enter_hook)(void);
-static void (*rt_interrupt_leave_hook)(void);
+void (*rt_interrupt_enter_hook)(void);
+void (*rt_interrupt_leave_hook)(void);
 
 /**
  * @ingroup Hook
@@ -56,6 +57,27 @@ void rt_interrupt_leave_sethook(void (*hook)(void))
 
 /* #define IRQ_DEBUG */
 
+#ifdef RT_USING_IRQOFF_STAT
+/* the call sites in statistics table */
+#ifndef RT_IRQOFF_SITE_MAX
+#define RT_IRQOFF_SITE_MAX             32
+#endif
+
+struct rt_irqoff_site
+{
+    /* the caller of the outermost interrupt disable, RT_NULL: the entry is free */
+    void *caller;
+    rt_uint32_t count;
+    /* the longest interrupt masked window in CPU cycles */
+    rt_uint32_t max;
+};
+
+/* the last entry is shared by the call sites which are not in table */
+static struct rt_irqoff_site rt_irqoff_site[RT_IRQOFF_SITE_MAX + 1];
+static void *rt_irqoff_caller;
+static rt_uint32_t rt_irqoff_start;
+#endif
+
 /**
  * @addtogroup Kernel
  */
@@ -123,5 +145,118 @@ RTM_EXPORT(rt_interrupt_get_nest);
 RTM_EXPORT(rt_hw_interrupt_disable);
 RTM_EXPORT(rt_hw_interrupt_enable);
 
+#ifdef RT_USING_IRQOFF_STAT
+/**
+ * This function will be invoked by BSP, when the interrupt is masked by the
+ * outermost rt_hw_interrupt_disable. It's invoked with interrupt disabled.
+ *
+ * @note please don't invoke this routine in application
+ *
+ * @param caller the return address of rt_hw_interrupt_disable
+ */
+void rt_interrupt_mask_begin(void *caller)
+{
+    rt_irqoff_caller = caller;
+    rt_irqoff_start = rt_hw_cycle_get();
+}
+
+/**
+ * This function will be invoked by BSP, when the interrupt is unmasked by the
+ * outermost rt_hw_interrupt_enable. The masked window is counted to the call
+ * site of rt_hw_interrupt_disable. It's invoked with interrupt disabled.
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_interrupt_mask_end(void)
+{
+    struct rt_irqoff_site *site;
+    rt_uint32_t cycle, index, probe;
+
+    if (rt_irqoff_caller == RT_NULL)
+        return;
+    cycle = rt_hw_cycle_get() - rt_irqoff_start;
+
+    /* the call site is found by linear probing from the hash of its address */
+    index = (rt_uint32_t)((rt_ubase_t)rt_irqoff_caller >> 1) % RT_IRQOFF_SITE_MAX;
+    for (probe = 0; probe < RT_IRQOFF_SITE_MAX; probe ++)
+    {
+        site = &rt_irqoff_site[index];
+        if (site->caller == rt_irqoff_caller)
+            break;
+        if (site->caller == RT_NULL)
+        {
+            site->caller = rt_irqoff_caller;
+            break;
+        }
+        index = (index + 1) % RT_IRQOFF_SITE_MAX;
+    }
+    if (probe == RT_IRQOFF_SITE_MAX)
+        site = &rt_irqoff_site[RT_IRQOFF_SITE_MAX];
+
+    site->count ++;
+    if (cycle > site->max)
+        site->max = cycle;
+
+    rt_irqoff_caller = RT_NULL;
+}
+
+/**
+ * This function will clear the statistics of interrupt masked window.
+ */
+void rt_interrupt_mask_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(rt_irqoff_site, 0, sizeof(rt_irqoff_site));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_interrupt_mask_reset);
+#endif /* RT_USING_IRQOFF_STAT */
+
 /**@}*/
 
+#if defined (RT_USING_IRQOFF_STAT) && defined (RT_USING_FINSH)
+#include <finsh.h>
+
+static int cmd_list_irqoff(int argc, char **argv)
+{
+    static struct rt_irqoff_site site[RT_IRQOFF_SITE_MAX + 1];
+    rt_base_t level;
+    int index, longest;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(site, rt_irqoff_site, sizeof(site));
+    rt_hw_interrupt_enable(level);
+
+    rt_kprintf("caller             count      max cycles\n");
+    rt_kprintf("------------------ ---------- ----------\n");
+    /* from the longest window */
+    while (1)
+    {
+        longest = -1;
+        for (index = 0; index < RT_IRQOFF_SITE_MAX; index ++)
+        {
+            if (site[index].caller != RT_NULL && (longest < 0 || site[index].max > site[longest].max))
+                longest = index;
+        }
+        if (longest < 0)
+            break;
+
+        rt_kprintf("0x%-16p %10d %10d\n", site[longest].caller, site[longest].count, site[longest].max);
+        site[longest].caller = RT_NULL;
+    }
+    if (site[RT_IRQOFF_SITE_MAX].count)
+    {
+        rt_kprintf("%-18s %10d %10d\n", "other", site[RT_IRQOFF_SITE_MAX].count,
+                   site[RT_IRQOFF_SITE_MAX].max);
+    }
+
+    if (argc == 2 && rt_strcmp(argv[1], "reset") == 0)
+        rt_interrupt_mask_reset();
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT_ALIAS(cmd_list_irqoff, __cmd_list_irqoff, list the longest interrupt masked window of each call site: list_irqoff [reset]);
+#endif /* defined (RT_USING_IRQOFF_STAT) && defined (RT_USING_FINSH) */
+
@@ -31,6 +31,7 @@
  * 2013-06-24     Bernard      remove rt_kprintf if RT_USING_CONSOLE is not defined.
  * 2013-09-24     aozima       make sure the device is in STREAM mode when used by rt_kprintf.
  * 2015-07-06     Bernard      Add rt_assert_handler routine.
+ * 2026-10-17     agent        copy and compare memory by words for unaligned address, add the word copy of rt_memmove.
  */
 
 #include <rtthread.h>
@@ -206,6 +207,210 @@ void *rt_memset(void *s, int c, rt_ubase_t count)
 }
 RTM_EXPORT(rt_memset);
 
+#ifndef RT_TINY_SIZE
+#define MEM_WORDSIZE        (sizeof(rt_ubase_t))
+#define MEM_BIGBLOCKSIZE    (sizeof(rt_ubase_t) << 2)
+#define MEM_UNALIGNED(X)    ((rt_ubase_t)(X) & (MEM_WORDSIZE - 1))
+
+/* merge the low part of word and the high part of next word into the unaligned word between them */
+#if defined(__ARMEB__) || defined(__BIG_ENDIAN__) || \
+    (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+#define MEM_MERGE(LO, HI, SHIFT) \
+    (((LO) << (SHIFT)) | ((HI) >> (MEM_WORDSIZE * 8 - (SHIFT))))
+#else
+#define MEM_MERGE(LO, HI, SHIFT) \
+    (((LO) >> (SHIFT)) | ((HI) << (MEM_WORDSIZE * 8 - (SHIFT))))
+#endif
+
+/* LDM/STM move 8 words by 2 instructions on ARMv7-M */
+#if defined(__GNUC__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+#define MEM_USING_LDM_STM
+#endif
+
+/*
+ * Copy memory from the low address to the high address. The destination is
+ * aligned first, then the source is copied by words if it's aligned too, or
+ * by aligned words merged by shift. An aligned word never crosses the end of
+ * memory region, so the bytes out of source read by the aligned word are safe.
+ */
+static void _rt_memcpy_forward(char *dst, const char *src, rt_ubase_t count)
+{
+    rt_ubase_t *aligned_dst;
+    const rt_ubase_t *aligned_src;
+    rt_ubase_t lo, hi, offset, shift;
+
+    if (count >= MEM_BIGBLOCKSIZE)
+    {
+        while (MEM_UNALIGNED(dst))
+        {
+            *dst++ = *src++;
+            count --;
+        }
+
+        aligned_dst = (rt_ubase_t *)dst;
+        offset = MEM_UNALIGNED(src);
+        if (offset == 0)
+        {
+            aligned_src = (const rt_ubase_t *)src;
+#ifdef MEM_USING_LDM_STM
+            while (count >= 32)
+            {
+                __asm volatile ("ldmia %1!, {r3-r6}\n"
+                                "stmia %0!, {r3-r6}\n"
+                                "ldmia %1!, {r3-r6}\n"
+                                "stmia %0!, {r3-r6}\n"
+                                : "+r" (aligned_dst), "+r" (aligned_src)
+                                :
+                                : "r3", "r4", "r5", "r6", "memory");
+                count -= 32;
+            }
+#endif
+            while (count >= MEM_BIGBLOCKSIZE)
+            {
+                aligned_dst[0] = aligned_src[0];
+                aligned_dst[1] = aligned_src[1];
+                aligned_dst[2] = aligned_src[2];
+                aligned_dst[3] = aligned_src[3];
+                aligned_dst += 4;
+                aligned_src += 4;
+                count -= MEM_BIGBLOCKSIZE;
+            }
+            while (count >= MEM_WORDSIZE)
+            {
+                *aligned_dst++ = *aligned_src++;
+                count -= MEM_WORDSIZE;
+            }
+            src = (const char *)aligned_src;
+        }
+        else
+        {
+            shift = offset * 8;
+            aligned_src = (const rt_ubase_t *)(src - offset);
+            lo = *aligned_src++;
+            while (count >= MEM_BIGBLOCKSIZE)
+            {
+                hi = aligned_src[0];
+                aligned_dst[0] = MEM_MERGE(lo, hi, shift);
+                lo = aligned_src[1];
+                aligned_dst[1] = MEM_MERGE(hi, lo, shift);
+                hi = aligned_src[2];
+                aligned_dst[2] = MEM_MERGE(lo, hi, shift);
+                lo = aligned_src[3];
+                aligned_dst[3] = MEM_MERGE(hi, lo, shift);
+                aligned_dst += 4;
+                aligned_src += 4;
+                count -= MEM_BIGBLOCKSIZE;
+            }
+            while (count >= MEM_WORDSIZE)
+            {
+                hi = *aligned_src++;
+                *aligned_dst++ = MEM_MERGE(lo, hi, shift);
+                lo = hi;
+                count -= MEM_WORDSIZE;
+            }
+            /* the last read word holds the next byte of source */
+            src = (const char *)(aligned_src - 1) + offset;
+        }
+        dst = (char *)aligned_dst;
+    }
+
+    while (count--)
+        *dst++ = *src++;
+}
+
+/*
+ * Copy memory from the high address to the low address, it's the mirror of
+ * _rt_memcpy_forward for the overlapped rt_memmove.
+ */
+static void _rt_memcpy_backward(char *dst, const char *src, rt_ubase_t count)
+{
+    rt_ubase_t *aligned_dst;
+    const rt_ubase_t *aligned_src;
+    rt_ubase_t lo, hi, offset, shift;
+
+    dst += count;
+    src += count;
+
+    if (count >= MEM_BIGBLOCKSIZE)
+    {
+        while (MEM_UNALIGNED(dst))
+        {
+            *--dst = *--src;
+            count --;
+        }
+
+        aligned_dst = (rt_ubase_t *)dst;
+        offset = MEM_UNALIGNED(src);
+        if (offset == 0)
+        {
+            aligned_src = (const rt_ubase_t *)src;
+#ifdef MEM_USING_LDM_STM
+            while (count >= 32)
+            {
+                __asm volatile ("ldmdb %1!, {r3-r6}\n"
+                                "stmdb %0!, {r3-r6}\n"
+                                "ldmdb %1!, {r3-r6}\n"
+                                "stmdb %0!, {r3-r6}\n"
+                                : "+r" (aligned_dst), "+r" (aligned_src)
+                                :
+                                : "r3", "r4", "r5", "r6", "memory");
+                count -= 32;
+            }
+#endif
+            while (count >= MEM_BIGBLOCKSIZE)
+            {
+                aligned_dst -= 4;
+                aligned_src -= 4;
+                aligned_dst[3] = aligned_src[3];
+                aligned_dst[2] = aligned_src[2];
+                aligned_dst[1] = aligned_src[1];
+                aligned_dst[0] = aligned_src[0];
+                count -= MEM_BIGBLOCKSIZE;
+            }
+            while (count >= MEM_WORDSIZE)
+            {
+                *--aligned_dst = *--aligned_src;
+                count -= MEM_WORDSIZE;
+            }
+            src = (const char *)aligned_src;
+        }
+        else
+        {
+            shift = offset * 8;
+            aligned_src = (const rt_ubase_t *)(src - offset);
+            hi = *aligned_src;
+            while (count >= MEM_BIGBLOCKSIZE)
+            {
+                aligned_dst -= 4;
+                aligned_src -= 4;
+                lo = aligned_src[3];
+                aligned_dst[3] = MEM_MERGE(lo, hi, shift);
+                hi = aligned_src[2];
+                aligned_dst[2] = MEM_MERGE(hi, lo, shift);
+                lo = aligned_src[1];
+                aligned_dst[1] = MEM_MERGE(lo, hi, shift);
+                hi = aligned_src[0];
+                aligned_dst[0] = MEM_MERGE(hi, lo, shift);
+                count -= MEM_BIGBLOCKSIZE;
+            }
+            while (count >= MEM_WORDSIZE)
+            {
+                lo = *--aligned_src;
+                *--aligned_dst = MEM_MERGE(lo, hi, shift);
+                hi = lo;
+                count -= MEM_WORDSIZE;
+            }
+            /* the last read word holds the previous byte of source */
+            src = (const char *)aligned_src + offset;
+        }
+        dst = (char *)aligned_dst;
+    }
+
+    while (count--)
+        *--dst = *--src;
+}
+#endif /* RT_TINY_SIZE */
+
 /**
  * This function will copy memory content from source address to destination
  * address.
@@ -223,61 +428,11 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 
     while (count--)
         *tmp++ = *s++;
-
-    return dst;
 #else
-
-#define UNALIGNED(X, Y)                                               \
-                        (((rt_int32_t)X & (sizeof(rt_int32_t) - 1)) | \
-                         ((rt_int32_t)Y & (sizeof(rt_int32_t) - 1)))
-#define BIGBLOCKSIZE    (sizeof(rt_int32_t) << 2)
-#define LITTLEBLOCKSIZE (sizeof(rt_int32_t))
-#define TOO_SMALL(LEN)  ((LEN) < BIGBLOCKSIZE)
-
-    char *dst_ptr = (char *)dst;
-    char *src_ptr = (char *)src;
-    rt_int32_t *aligned_dst;
-    rt_int32_t *aligned_src;
-    int len = count;
-
-    /* If the size is small, or either SRC or DST is unaligned,
-    then punt into the byte copy loop.  This should be rare. */
-    if (!TOO_SMALL(len) && !UNALIGNED(src_ptr, dst_ptr))
-    {
-        aligned_dst = (rt_int32_t *)dst_ptr;
-        aligned_src = (rt_int32_t *)src_ptr;
-
-        /* Copy 4X long words at a time if possible. */
-        while (len >= BIGBLOCKSIZE)
-        {
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            len -= BIGBLOCKSIZE;
-        }
-
-        /* Copy one long word at a time if possible. */
-        while (len >= LITTLEBLOCKSIZE)
-        {
-            *aligned_dst++ = *aligned_src++;
-            len -= LITTLEBLOCKSIZE;
-        }
-
-        /* Pick up any residual with a byte copier. */
-        dst_ptr = (char *)aligned_dst;
-        src_ptr = (char *)aligned_src;
-    }
-
-    while (len--)
-        *dst_ptr++ = *src_ptr++;
+    _rt_memcpy_forward((char *)dst, (const char *)src, count);
+#endif
 
     return dst;
-#undef UNALIGNED
-#undef BIGBLOCKSIZE
-#undef LITTLEBLOCKSIZE
-#undef TOO_SMALL
-#endif
 }
 RTM_EXPORT(rt_memcpy);
 
@@ -295,6 +450,7 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
 {
     char *tmp = (char *)dest, *s = (char *)src;
 
+#ifdef RT_TINY_SIZE
     if (s < tmp && tmp < s + n)
     {
         tmp += n;
@@ -308,6 +464,13 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
         while (n--)
             *tmp++ = *s++;
     }
+#else
+    /* the forward copy never overwrites the source before it's read if dest is lower */
+    if (s < tmp && tmp < s + n)
+        _rt_memcpy_backward(tmp, s, n);
+    else if (s != tmp)
+        _rt_memcpy_forward(tmp, s, n);
+#endif
 
     return dest;
 }
@@ -324,10 +487,59 @@ RTM_EXPORT(rt_memmove);
  */
 rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
 {
-    const unsigned char *su1, *su2;
+    const unsigned char *su1 = cs, *su2 = ct;
     int res = 0;
+#ifndef RT_TINY_SIZE
+    const rt_ubase_t *aligned_cs, *aligned_ct;
+    rt_ubase_t lo, hi, offset, shift;
+
+    /* compare by words until the first different word, which is found by the byte loop */
+    if (count >= MEM_BIGBLOCKSIZE)
+    {
+        while (MEM_UNALIGNED(su1))
+        {
+            if ((res = *su1 - *su2) != 0)
+                return res;
+            su1 ++;
+            su2 ++;
+            count --;
+        }
+
+        aligned_cs = (const rt_ubase_t *)su1;
+        offset = MEM_UNALIGNED(su2);
+        if (offset == 0)
+        {
+            aligned_ct = (const rt_ubase_t *)su2;
+            while (count >= MEM_WORDSIZE && *aligned_cs == *aligned_ct)
+            {
+                aligned_cs ++;
+                aligned_ct ++;
+                count -= MEM_WORDSIZE;
+            }
+            su2 = (const unsigned char *)aligned_ct;
+        }
+        else
+        {
+            shift = offset * 8;
+            aligned_ct = (const rt_ubase_t *)(su2 - offset);
+            lo = *aligned_ct++;
+            while (count >= MEM_WORDSIZE)
+            {
+                hi = *aligned_ct;
+                if (*aligned_cs != MEM_MERGE(lo, hi, shift))
+                    break;
+                aligned_cs ++;
+                aligned_ct ++;
+                lo = hi;
+                count -= MEM_WORDSIZE;
+            }
+            su2 = (const unsigned char *)(aligned_ct - 1) + offset;
+        }
+        su1 = (const unsigned char *)aligned_cs;
+    }
+#endif
 
-    for (su1 = cs, su2 = ct; 0 < count; ++su1, ++su2, count--)
+    for (; 0 < count; ++su1, ++su2, count--)
         if ((res = *su1 - *su2) != 0)
             break;
 
@@ -1199,17 +1411,17 @@ void* rt_malloc_align(rt_size_t size, rt_size_t align)
     if (ptr != RT_NULL)
     {
          /* the allocated memory block is aligned */
-        if (((rt_uint32_t)ptr & (align - 1)) == 0)
+        if (((rt_ubase_t)ptr & (align - 1)) == 0)
         {
-            align_ptr = (void *)((rt_uint32_t)ptr + align);
+            align_ptr = (void *)((rt_ubase_t)ptr + align);
         }
         else
         {
-            align_ptr = (void *)(((rt_uint32_t)ptr + (align - 1)) & ~(align - 1));
+            align_ptr = (void *)(((rt_ubase_t)ptr + (align - 1)) & ~(align - 1));
         }
 
         /* set the pointer before alignment pointer to the real pointer */
-        *((rt_uint32_t *)((rt_uint32_t)align_ptr - sizeof(void *))) = (rt_uint32_t)ptr;
+        *((rt_ubase_t *)((rt_ubase_t)align_ptr - sizeof(void *))) = (rt_ubase_t)ptr;
 
         ptr = align_ptr;
     }
@@ -1228,7 +1440,7 @@ void rt_free_align(void *ptr)
 {
     void *real_ptr;
 
-    real_ptr = (void *)*(rt_uint32_t *)((rt_uint32_t)ptr - sizeof(void *));
+    real_ptr = (void *)*(rt_ubase_t *)((rt_ubase_t)ptr - sizeof(void *));
     rt_free(real_ptr);
 }
 RTM_EXPORT(rt_free_align);
@@ -28,6 +28,7 @@
  * 2010-10-26     yi.qiu       add module support in rt_mp_delete
  * 2011-01-24     Bernard      add object allocation check.
  * 2012-03-22     Bernard      fix align issue in rt_mp_init and rt_mp_create.
+ * 2026-10-17     agent        add the lock-free block list for rt_mp_alloc and rt_mp_free.
  */
 
 #include <rthw.h>
@@ -70,6 +71,150 @@ void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block))
 /**@}*/
 #endif
 
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+/*
+ * The free block list is a tagged index. The low half of it is the index of
+ * the first free block (plus one, 0 is the end of list), and the high half is
+ * a tag which is increased by every pop. The blocks are popped and pushed by
+ * rt_hw_atomic_cas without disabling interrupt, the tag fails the pop when
+ * the first block is popped and pushed back by an interrupt between the read
+ * of its next block and the compare and swap (ABA).
+ */
+#define MP_INDEX_BITS                  (sizeof(rt_ubase_t) * 4)
+#define MP_INDEX_MASK                  ((1UL << MP_INDEX_BITS) - 1)
+#define MP_TAG_ONE                     (1UL << MP_INDEX_BITS)
+
+rt_inline rt_uint8_t *_rt_mp_block(struct rt_mempool *mp, rt_ubase_t index)
+{
+    return (rt_uint8_t *)mp->start_address + (index - 1) * (mp->block_size + sizeof(rt_uint8_t *));
+}
+
+rt_inline rt_ubase_t _rt_mp_block_index(struct rt_mempool *mp, rt_uint8_t *block_ptr)
+{
+    return (block_ptr - (rt_uint8_t *)mp->start_address) / (mp->block_size + sizeof(rt_uint8_t *)) + 1;
+}
+
+static void _rt_mp_free_count_add(struct rt_mempool *mp, rt_base_t value)
+{
+    rt_ubase_t count;
+
+    do
+    {
+        count = mp->block_free_count;
+    } while (!rt_hw_atomic_cas((volatile rt_ubase_t *)&mp->block_free_count, count, count + value));
+}
+
+/* pop the first free block, it's safe in interrupt without disabling interrupt */
+static rt_uint8_t *_rt_mp_block_pop(struct rt_mempool *mp)
+{
+    rt_ubase_t head, next;
+    rt_uint8_t *block_ptr;
+
+    do
+    {
+        head = mp->block_list;
+        if ((head & MP_INDEX_MASK) == 0)
+            return RT_NULL;
+
+        /* the block may be allocated by others now, then the tag is changed and the pop is retried */
+        block_ptr = _rt_mp_block(mp, head & MP_INDEX_MASK);
+        next = *(volatile rt_ubase_t *)block_ptr;
+    } while (!rt_hw_atomic_cas(&mp->block_list, head,
+                               ((head + MP_TAG_ONE) & ~MP_INDEX_MASK) | (next & MP_INDEX_MASK)));
+
+    _rt_mp_free_count_add(mp, -1);
+
+    return block_ptr;
+}
+
+/* push the block to the free block list, it's safe in interrupt without disabling interrupt */
+static void _rt_mp_block_push(struct rt_mempool *mp, rt_uint8_t *block_ptr)
+{
+    rt_ubase_t head, index = _rt_mp_block_index(mp, block_ptr);
+
+    do
+    {
+        head = mp->block_list;
+        *(volatile rt_ubase_t *)block_ptr = head & MP_INDEX_MASK;
+    } while (!rt_hw_atomic_cas(&mp->block_list, head, (head & ~MP_INDEX_MASK) | index));
+
+    _rt_mp_free_count_add(mp, 1);
+}
+
+/* link all blocks to the free block list */
+static void _rt_mp_block_list_init(struct rt_mempool *mp)
+{
+    rt_ubase_t index;
+
+    RT_ASSERT(mp->block_total_count < MP_INDEX_MASK);
+
+    for (index = 1; index < mp->block_total_count; index ++)
+    {
+        *(rt_ubase_t *)_rt_mp_block(mp, index) = index + 1;
+    }
+
+    if (mp->block_total_count > 0)
+    {
+        *(rt_ubase_t *)_rt_mp_block(mp, mp->block_total_count) = 0;
+        mp->block_list = 1;
+    }
+    else
+    {
+        mp->block_list = 0;
+    }
+}
+#else
+/* pop the first free block, it's invoked with interrupt disabled */
+static rt_uint8_t *_rt_mp_block_pop(struct rt_mempool *mp)
+{
+    rt_uint8_t *block_ptr = mp->block_list;
+
+    if (block_ptr != RT_NULL)
+    {
+        /* Setup the next free node. */
+        mp->block_list = *(rt_uint8_t **)block_ptr;
+        /* decrease the free block counter */
+        mp->block_free_count --;
+    }
+
+    return block_ptr;
+}
+
+/* push the block to the free block list, it's invoked with interrupt disabled */
+static void _rt_mp_block_push(struct rt_mempool *mp, rt_uint8_t *block_ptr)
+{
+    *(rt_uint8_t **)block_ptr = mp->block_list;
+    mp->block_list = block_ptr;
+    /* increase the free block count */
+    mp->block_free_count ++;
+}
+
+/* link all blocks to the free block list */
+static void _rt_mp_block_list_init(struct rt_mempool *mp)
+{
+    rt_uint8_t *block_ptr = (rt_uint8_t *)mp->start_address;
+    rt_size_t block_size = mp->block_size;
+    register rt_base_t offset;
+
+    for (offset = 0; offset < mp->block_total_count; offset ++)
+    {
+        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *))) =
+            (rt_uint8_t *)(block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *)));
+    }
+
+    if (offset > 0)
+    {
+        *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *))) =
+            RT_NULL;
+        mp->block_list = block_ptr;
+    }
+    else
+    {
+        mp->block_list = RT_NULL;
+    }
+}
+#endif /* RT_USING_MEMPOOL_LOCKFREE */
+
 /**
  * @addtogroup MM
  */
@@ -94,9 +239,6 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
                     rt_size_t          size,
                     rt_size_t          block_size)
 {
-    rt_uint8_t *block_ptr;
-    register rt_base_t offset;
-
     /* parameter check */
     RT_ASSERT(mp != RT_NULL);
 
@@ -120,17 +262,7 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
     mp->suspend_thread_count = 0;
 
     /* initialize free block list */
-    block_ptr = (rt_uint8_t *)mp->start_address;
-    for (offset = 0; offset < mp->block_total_count; offset ++)
-    {
-        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *))) =
-            (rt_uint8_t *)(block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *)));
-    }
-
-    *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *))) =
-        RT_NULL;
-
-    mp->block_list = block_ptr;
+    _rt_mp_block_list_init(mp);
 
     return RT_EOK;
 }
@@ -198,9 +330,7 @@ rt_mp_t rt_mp_create(const char *name,
                      rt_size_t   block_count,
                      rt_size_t   block_size)
 {
-    rt_uint8_t *block_ptr;
     struct rt_mempool *mp;
-    register rt_base_t offset;
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
@@ -234,17 +364,7 @@ rt_mp_t rt_mp_create(const char *name,
     mp->suspend_thread_count = 0;
 
     /* initialize free block list */
-    block_ptr = (rt_uint8_t *)mp->start_address;
-    for (offset = 0; offset < mp->block_total_count; offset ++)
-    {
-        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *)))
-            = block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *));
-    }
-
-    *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *)))
-        = RT_NULL;
-
-    mp->block_list = block_ptr;
+    _rt_mp_block_list_init(mp);
 
     return mp;
 }
@@ -310,15 +430,8 @@ rt_err_t rt_mp_delete(rt_mp_t mp)
 RTM_EXPORT(rt_mp_delete);
 #endif
 
-/**
- * This function will allocate a block from memory pool
- *
- * @param mp the memory pool object
- * @param time the waiting time
- *
- * @return the allocated memory block or RT_NULL on allocated failed
- */
-void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
+/* pop a free block with interrupt disabled, the thread is suspended until a block is freed */
+static rt_uint8_t *_rt_mp_alloc_wait(rt_mp_t mp, rt_int32_t time)
 {
     rt_uint8_t *block_ptr;
     register rt_base_t level;
@@ -331,7 +444,7 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (mp->block_free_count == 0)
+    while ((block_ptr = _rt_mp_block_pop(mp)) == RT_NULL)
     {
         /* memory block is unavailable. */
         if (time == 0)
@@ -384,22 +497,38 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
         level = rt_hw_interrupt_disable();
     }
 
-    /* memory block is available. decrease the free block counter */
-    mp->block_free_count--;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return block_ptr;
+}
 
-    /* get block from block list */
-    block_ptr = mp->block_list;
-    RT_ASSERT(block_ptr != RT_NULL);
+/**
+ * This function will allocate a block from memory pool
+ *
+ * @param mp the memory pool object
+ * @param time the waiting time
+ *
+ * @return the allocated memory block or RT_NULL on allocated failed
+ */
+void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
+{
+    rt_uint8_t *block_ptr;
 
-    /* Setup the next free node. */
-    mp->block_list = *(rt_uint8_t **)block_ptr;
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    /* the block is popped without disabling interrupt, the waiting is only for the empty pool */
+    block_ptr = _rt_mp_block_pop(mp);
+    if (block_ptr == RT_NULL)
+        block_ptr = _rt_mp_alloc_wait(mp, time);
+#else
+    block_ptr = _rt_mp_alloc_wait(mp, time);
+#endif
+    if (block_ptr == RT_NULL)
+        return RT_NULL;
 
     /* point to memory pool */
     *(rt_uint8_t **)block_ptr = (rt_uint8_t *)mp;
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
     RT_OBJECT_HOOK_CALL(rt_mp_alloc_hook,
                         (mp, (rt_uint8_t *)(block_ptr + sizeof(rt_uint8_t *))));
 
@@ -425,15 +554,23 @@ void rt_mp_free(void *block)
 
     RT_OBJECT_HOOK_CALL(rt_mp_free_hook, (mp, block));
 
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    /* link the block into the block list without disabling interrupt */
+    _rt_mp_block_push(mp, (rt_uint8_t *)block_ptr);
+
+    /* the thread is suspended after its last pop with interrupt disabled, so it's seen here */
+    if (mp->suspend_thread_count == 0)
+        return;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+#else
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
-
-    /* increase the free block count */
-    mp->block_free_count ++;
 
     /* link the block into the block list */
-    *block_ptr = mp->block_list;
-    mp->block_list = (rt_uint8_t *)block_ptr;
+    _rt_mp_block_push(mp, (rt_uint8_t *)block_ptr);
+#endif
 
     if (mp->suspend_thread_count > 0)
     {
@@ -27,6 +27,8 @@
  * 2012-11-23     Bernard      using RT_DEBUG_LOG instead of rt_kprintf.
  * 2012-11-28     Bernard      remove rt_current_module and user
  *                             can use rt_module_unload to remove a module.
+ * 2026-10-17     agent        add reader/writer lock object container
+ * 2026-10-17     agent        clear the name hash index of module object container
  */
 
 #include <rthw.h>
@@ -291,6 +293,11 @@ void rt_module_init_object_container(struct rt_module *module)
 {
     RT_ASSERT(module != RT_NULL);
 
+#ifdef RT_USING_OBJECT_HASH
+    /* the name hash index of module objects is empty */
+    rt_memset(module->module_object, 0, sizeof(module->module_object));
+#endif
+
     /* initialize object container - thread */
     rt_list_init(&(module->module_object[RT_Object_Class_Thread].object_list));
     module->module_object[RT_Object_Class_Thread].object_size = sizeof(struct rt_thread);
@@ -331,6 +338,13 @@ void rt_module_init_object_container(struct rt_module *module)
     module->module_object[RT_Object_Class_MessageQueue].type = RT_Object_Class_MessageQueue;
 #endif
 
+#ifdef RT_USING_RWLOCK
+    /* initialize object container - reader/writer lock */
+    rt_list_init(&(module->module_object[RT_Object_Class_RWLock].object_list));
+    module->module_object[RT_Object_Class_RWLock].object_size = sizeof(struct rt_rwlock);
+    module->module_object[RT_Object_Class_RWLock].type = RT_Object_Class_RWLock;
+#endif
+
 #ifdef RT_USING_MEMHEAP
     /* initialize object container - memory heap */
     rt_list_init(&(module->module_object[RT_Object_Class_MemHeap].object_list));
@@ -1377,6 +1391,25 @@ rt_err_t rt_module_destroy(rt_module_t module)
         }
 #endif
 
+#ifdef RT_USING_RWLOCK
+        /* delete reader/writer locks */
+        list = &module->module_object[RT_Object_Class_RWLock].object_list;
+        while (list->next != list)
+        {
+            object = rt_list_entry(list->next, struct rt_object, list);
+            if (rt_object_is_systemobject(object) == RT_TRUE)
+            {
+                /* detach static object */
+                rt_rwlock_detach((rt_rwlock_t)object);
+            }
+            else
+            {
+                /* delete dynamic object */
+                rt_rwlock_delete((rt_rwlock_t)object);
+            }
+        }
+#endif
+
 #ifdef RT_USING_MEMPOOL
         /* delete mempools */
         list = &module->module_object[RT_Object_Class_MemPool].object_list;
@@ -0,0 +1,382 @@
+/*
+ * File      : objcache.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, object and thread stack caches
+ */
+
+/*
+ * The memory of deleted kernel objects is kept in a cache of each object
+ * class, and the thread stacks are kept in a cache of each stack size. They
+ * are reused by the next create of same class or stack size without the heap.
+ * A stack size gets its cache when a stack of this size is freed at the first
+ * time, so the short-lived threads are cached and the static ones are not.
+ *
+ * The caches are small and bounded by RT_OBJCACHE_DEPTH, the memory beyond it
+ * is freed to heap. All cached memory is freed to heap when the heap is out
+ * of memory, then the allocation is retried.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_OBJCACHE)
+
+/* the max cached memory blocks of each cache */
+#ifndef RT_OBJCACHE_DEPTH
+#define RT_OBJCACHE_DEPTH              4
+#endif
+
+/* the count of stack sizes which are cached */
+#ifndef RT_OBJCACHE_STACK_CLASS
+#define RT_OBJCACHE_STACK_CLASS        4
+#endif
+
+struct rt_objcache
+{
+    /* the cached memory blocks, the first word of block is the next one */
+    void *free_list;
+    rt_uint16_t count;
+
+    /* the size of memory block, the stack cache is not used when it's 0 */
+    rt_size_t size;
+
+    /* the allocation from cache, the allocation from heap and the free to heap */
+    rt_uint32_t hit;
+    rt_uint32_t miss;
+    rt_uint32_t drop;
+};
+
+static struct rt_objcache object_cache[RT_Object_Class_Unknown];
+static struct rt_objcache stack_cache[RT_OBJCACHE_STACK_CLASS];
+/* the stack allocations and frees of the sizes without cache */
+static rt_uint32_t stack_other_miss, stack_other_drop;
+
+static void *_rt_objcache_pop(struct rt_objcache *cache)
+{
+    register rt_base_t level;
+    void *ptr;
+
+    level = rt_hw_interrupt_disable();
+
+    ptr = cache->free_list;
+    if (ptr != RT_NULL)
+    {
+        cache->free_list = *(void **)ptr;
+        cache->count --;
+        cache->hit ++;
+    }
+    else
+    {
+        cache->miss ++;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return ptr;
+}
+
+static rt_bool_t _rt_objcache_push(struct rt_objcache *cache, void *ptr)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+
+    if (cache->count >= RT_OBJCACHE_DEPTH)
+    {
+        cache->drop ++;
+        rt_hw_interrupt_enable(level);
+
+        return RT_FALSE;
+    }
+
+    *(void **)ptr = cache->free_list;
+    cache->free_list = ptr;
+    cache->count ++;
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_TRUE;
+}
+
+/* free all cached memory of the cache to heap, and return the freed bytes */
+static rt_size_t _rt_objcache_drain(struct rt_objcache *cache)
+{
+    register rt_base_t level;
+    rt_size_t size = 0;
+    void *ptr;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        ptr = cache->free_list;
+        if (ptr != RT_NULL)
+        {
+            cache->free_list = *(void **)ptr;
+            cache->count --;
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (ptr == RT_NULL)
+            break;
+
+        RT_KERNEL_FREE(ptr);
+        size += cache->size;
+    }
+
+    return size;
+}
+
+/* allocate from heap, the cached memory is freed to heap when it's out of memory */
+static void *_rt_objcache_malloc(rt_size_t size)
+{
+    void *ptr;
+
+    ptr = RT_KERNEL_MALLOC(size);
+    if (ptr == RT_NULL && rt_objcache_shrink() > 0)
+        ptr = RT_KERNEL_MALLOC(size);
+
+    return ptr;
+}
+
+/* find the cache of stack size, a free cache is used for the new size if create is true */
+static struct rt_objcache *_rt_objcache_stack_find(rt_size_t size, rt_bool_t create)
+{
+    register rt_base_t level;
+    struct rt_objcache *cache = RT_NULL;
+    int index;
+
+    level = rt_hw_interrupt_disable();
+
+    for (index = 0; index < RT_OBJCACHE_STACK_CLASS; index ++)
+    {
+        if (stack_cache[index].size == size)
+        {
+            cache = &stack_cache[index];
+            break;
+        }
+        if (stack_cache[index].size == 0 && cache == RT_NULL)
+            cache = &stack_cache[index];
+    }
+
+    if (cache != RT_NULL && cache->size != size)
+    {
+        if (create)
+            cache->size = size;
+        else
+            cache = RT_NULL;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return cache;
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * This function will allocate the memory of kernel object from the cache of
+ * its class, or from heap when the cache is empty.
+ *
+ * @param type the object class type
+ * @param size the object size
+ *
+ * @return the memory of object, RT_NULL if no memory
+ */
+void *rt_objcache_alloc(enum rt_object_class_type type, rt_size_t size)
+{
+    struct rt_objcache *cache;
+    void *ptr;
+
+    RT_ASSERT(type < RT_Object_Class_Unknown);
+
+    cache = &object_cache[type];
+    cache->size = size;
+
+    ptr = _rt_objcache_pop(cache);
+    if (ptr == RT_NULL)
+        ptr = _rt_objcache_malloc(size);
+
+    return ptr;
+}
+
+/**
+ * This function will free the memory of kernel object to the cache of its
+ * class, or to heap when the cache is full.
+ *
+ * @param type the object class type
+ * @param ptr the memory of object
+ */
+void rt_objcache_free(enum rt_object_class_type type, void *ptr)
+{
+    RT_ASSERT(type < RT_Object_Class_Unknown);
+
+    if (!_rt_objcache_push(&object_cache[type], ptr))
+        RT_KERNEL_FREE(ptr);
+}
+
+/**
+ * This function will allocate a thread stack from the cache of its size, or
+ * from heap when there is no cached stack.
+ *
+ * @param size the stack size
+ *
+ * @return the stack, RT_NULL if no memory
+ */
+void *rt_objcache_stack_alloc(rt_size_t size)
+{
+    struct rt_objcache *cache;
+    void *ptr = RT_NULL;
+
+    cache = _rt_objcache_stack_find(size, RT_FALSE);
+    if (cache != RT_NULL)
+        ptr = _rt_objcache_pop(cache);
+    else
+        stack_other_miss ++;
+
+    if (ptr == RT_NULL)
+        ptr = _rt_objcache_malloc(size);
+
+    return ptr;
+}
+
+/**
+ * This function will free a thread stack to the cache of its size, or to
+ * heap when the cache is full or all stack caches are used by other sizes.
+ *
+ * @param stack the stack
+ * @param size the stack size
+ */
+void rt_objcache_stack_free(void *stack, rt_size_t size)
+{
+    struct rt_objcache *cache;
+
+    cache = _rt_objcache_stack_find(size, RT_TRUE);
+    if (cache == RT_NULL)
+        stack_other_drop ++;
+
+    if (cache == RT_NULL || !_rt_objcache_push(cache, stack))
+        RT_KERNEL_FREE(stack);
+}
+
+/**
+ * This function will free all cached memory to heap.
+ *
+ * @return the freed bytes
+ */
+rt_size_t rt_objcache_shrink(void)
+{
+    rt_size_t size = 0;
+    int index;
+
+    for (index = 0; index < RT_Object_Class_Unknown; index ++)
+        size += _rt_objcache_drain(&object_cache[index]);
+    for (index = 0; index < RT_OBJCACHE_STACK_CLASS; index ++)
+        size += _rt_objcache_drain(&stack_cache[index]);
+
+    return size;
+}
+RTM_EXPORT(rt_objcache_shrink);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static const char *_rt_objcache_name(enum rt_object_class_type type)
+{
+    switch (type)
+    {
+    case RT_Object_Class_Thread:       return "thread";
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:    return "semaphore";
+#endif
+#ifdef RT_USING_MUTEX
+    case RT_Object_Class_Mutex:        return "mutex";
+#endif
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:        return "event";
+#endif
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:      return "mailbox";
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue: return "msgqueue";
+#endif
+#ifdef RT_USING_RWLOCK
+    case RT_Object_Class_RWLock:       return "rwlock";
+#endif
+#ifdef RT_USING_MEMHEAP
+    case RT_Object_Class_MemHeap:      return "memheap";
+#endif
+#ifdef RT_USING_MEMPOOL
+    case RT_Object_Class_MemPool:      return "mempool";
+#endif
+#ifdef RT_USING_DEVICE
+    case RT_Object_Class_Device:       return "device";
+#endif
+    case RT_Object_Class_Timer:        return "timer";
+#ifdef RT_USING_MODULE
+    case RT_Object_Class_Module:       return "module";
+#endif
+    default:                           return "unknown";
+    }
+}
+
+static void _list_objcache(const char *name, struct rt_objcache *cache)
+{
+    rt_kprintf("%-10s %5d %6d %8d %8d %8d\n", name, (rt_uint32_t)cache->size, cache->count,
+               cache->hit, cache->miss, cache->drop);
+}
+
+long list_objcache(void)
+{
+    int index;
+
+    rt_kprintf("cache       size cached      hit     miss     drop\n");
+    rt_kprintf("---------- ----- ------ -------- -------- --------\n");
+    for (index = 0; index < RT_Object_Class_Unknown; index ++)
+    {
+        /* the cache is not shown if the objects of class are never created */
+        if (object_cache[index].size == 0)
+            continue;
+
+        _list_objcache(_rt_objcache_name((enum rt_object_class_type)index), &object_cache[index]);
+    }
+    for (index = 0; index < RT_OBJCACHE_STACK_CLASS; index ++)
+    {
+        if (stack_cache[index].size == 0)
+            continue;
+
+        _list_objcache("stack", &stack_cache[index]);
+    }
+    rt_kprintf("%-10s %5s %6s %8s %8d %8d\n", "stack", "other", "-", "-", stack_other_miss, stack_other_drop);
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT(list_objcache, list object and stack caches);
+MSH_CMD_EXPORT(list_objcache, list object and stack caches);
+#endif /* RT_USING_FINSH */
+
+#endif /* defined (RT_USING_HEAP) && defined (RT_USING_OBJCACHE) */
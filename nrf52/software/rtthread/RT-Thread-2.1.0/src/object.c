@@ -25,6 +25,9 @@
  * 2006-08-03     Bernard      add hook support
  * 2007-01-28     Bernard      rename RT_OBJECT_Class_Static to RT_Object_Class_Static
  * 2010-10-26     yi.qiu       add module support in rt_object_allocate and rt_object_free
+ * 2026-10-17     agent        allocate and free the object memory by object cache
+ * 2026-10-17     agent        add reader/writer lock object container
+ * 2026-10-17     agent        add the name hash index of object container
  */
 
 #include <rtthread.h>
@@ -56,6 +59,10 @@ struct rt_object_information rt_object_container[RT_Object_Class_Unknown] =
     /* initialize object container - message queue */
     {RT_Object_Class_MessageQueue, _OBJ_CONTAINER_LIST_INIT(RT_Object_Class_MessageQueue), sizeof(struct rt_messagequeue)},
 #endif
+#ifdef RT_USING_RWLOCK
+    /* initialize object container - reader/writer lock */
+    {RT_Object_Class_RWLock, _OBJ_CONTAINER_LIST_INIT(RT_Object_Class_RWLock), sizeof(struct rt_rwlock)},
+#endif
 #ifdef RT_USING_MEMHEAP
     /* initialize object container - memory heap */
     {RT_Object_Class_MemHeap, _OBJ_CONTAINER_LIST_INIT(RT_Object_Class_MemHeap), sizeof(struct rt_memheap)},
@@ -162,6 +169,47 @@ void rt_object_put_sethook(void (*hook)(struct rt_object *object))
 /**@}*/
 #endif
 
+#ifdef RT_USING_OBJECT_HASH
+/* the FNV-1a hash of object name, the name is compared in RT_NAME_MAX characters */
+static rt_uint32_t _object_name_hash(const char *name)
+{
+    rt_uint32_t hash = 2166136261u;
+    rt_ubase_t index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash ^= (rt_uint8_t)name[index];
+        hash *= 16777619u;
+    }
+
+    /* fold the high bits, the low bits of FNV-1a only depend on the low bits of characters */
+    return (hash ^ (hash >> 16)) & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+/* it shall be invoked with interrupt disabled */
+static void _object_hash_insert(struct rt_object_information *information,
+                                struct rt_object             *object,
+                                rt_uint32_t                   hash)
+{
+    object->hash_next = information->hash[hash];
+    if (object->hash_next != RT_NULL)
+        object->hash_next->hash_pprev = &(object->hash_next);
+    information->hash[hash] = object;
+    object->hash_pprev = &(information->hash[hash]);
+}
+
+/* it shall be invoked with interrupt disabled, the object can be removed again like rt_list_remove */
+static void _object_hash_remove(struct rt_object *object)
+{
+    *(object->hash_pprev) = object->hash_next;
+    if (object->hash_next != RT_NULL)
+        object->hash_next->hash_pprev = object->hash_pprev;
+
+    object->hash_next = RT_NULL;
+    object->hash_pprev = &(object->hash_next);
+}
+#endif
+
 /**
  * @ingroup SystemInit
  *
@@ -207,6 +255,9 @@ void rt_object_init(struct rt_object         *object,
 {
     register rt_base_t temp;
     struct rt_object_information *information;
+#ifdef RT_USING_OBJECT_HASH
+    rt_uint32_t hash;
+#endif
 
 #ifdef RT_USING_MODULE
     /* get module object information */
@@ -227,11 +278,18 @@ void rt_object_init(struct rt_object         *object,
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    hash = _object_name_hash(object->name);
+#endif
+
     /* lock interrupt */
     temp = rt_hw_interrupt_disable();
 
     /* insert object into information object list */
     rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_insert(information, object, hash);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -257,6 +315,9 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -276,6 +337,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     struct rt_object *object;
     register rt_base_t temp;
     struct rt_object_information *information;
+#ifdef RT_USING_OBJECT_HASH
+    rt_uint32_t hash;
+#endif
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
@@ -291,7 +355,11 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     information = &rt_object_container[type];
 #endif
 
+#ifdef RT_USING_OBJCACHE
+    object = (struct rt_object *)rt_objcache_alloc(type, information->object_size);
+#else
     object = (struct rt_object *)RT_KERNEL_MALLOC(information->object_size);
+#endif
     if (object == RT_NULL)
     {
         /* no memory can be allocated */
@@ -319,11 +387,18 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    hash = _object_name_hash(object->name);
+#endif
+
     /* lock interrupt */
     temp = rt_hw_interrupt_disable();
 
     /* insert object into information object list */
     rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_insert(information, object, hash);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -352,6 +427,9 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -363,7 +441,11 @@ void rt_object_delete(rt_object_t object)
 #endif
 
     /* free the memory of object */
+#ifdef RT_USING_OBJCACHE
+    rt_objcache_free((enum rt_object_class_type)object->type, object);
+#else
     RT_KERNEL_FREE(object);
+#endif
 }
 #endif
 
@@ -402,7 +484,9 @@ rt_bool_t rt_object_is_systemobject(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifdef RT_USING_MODULE
     struct rt_list_node *node = RT_NULL;
+#endif
     struct rt_object_information *information = RT_NULL;
 
     /* parameter check */
@@ -474,24 +558,58 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 
     /* try to find object */
     if (information == RT_NULL) information = &rt_object_container[type];
+    object = rt_object_lookup(information, name);
+
+    /* leave critical */
+    rt_exit_critical();
+
+    return object;
+}
+
+/**
+ * This function will find specified name object in the object container
+ * of a type. It's O(1) with RT_USING_OBJECT_HASH, or it walks the object list.
+ *
+ * @param information the object container of the type.
+ * @param name the specified name of object.
+ *
+ * @return the found object or RT_NULL if there is no this object
+ * in object container.
+ *
+ * @note the caller shall lock the scheduler.
+ */
+rt_object_t rt_object_lookup(struct rt_object_information *information,
+                             const char                   *name)
+{
+    struct rt_object *object;
+#ifndef RT_USING_OBJECT_HASH
+    struct rt_list_node *node;
+#endif
+
+    RT_ASSERT(information != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+
+#ifdef RT_USING_OBJECT_HASH
+    for (object  = information->hash[_object_name_hash(name)];
+         object != RT_NULL;
+         object  = object->hash_next)
+    {
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+            return object;
+    }
+#else
     for (node  = information->object_list.next;
          node != &(information->object_list);
          node  = node->next)
     {
         object = rt_list_entry(node, struct rt_object, list);
         if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
-        {
-            /* leave critical */
-            rt_exit_critical();
-
             return object;
-        }
     }
-
-    /* leave critical */
-    rt_exit_critical();
+#endif
 
     return RT_NULL;
 }
+RTM_EXPORT(rt_object_lookup);
 
 /**@}*/
@@ -74,8 +74,8 @@ static rt_size_t used_mem, max_mem;
 #endif
 
 #ifdef RT_USING_HOOK
-static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
-static void (*rt_free_hook)(void *ptr);
+void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+void (*rt_free_hook)(void *ptr);
 
 /**
  * @addtogroup Hook
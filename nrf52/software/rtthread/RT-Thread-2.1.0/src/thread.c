@@ -38,6 +38,8 @@
  * 2016-08-09     ArdaFu       add thread suspend and resume hook.
  * 2017-04-10     armink       fixed the rt_thread_delete and rt_thread_detach
                                bug when thread has not startup.
+ * 2026-10-17     agent        allocate the thread stack by stack cache
+ * 2026-10-17     agent        find thread by the name hash index of object container
  */
 
 #include <rtthread.h>
@@ -360,7 +362,11 @@ rt_thread_t rt_thread_create(const char *name,
     if (thread == RT_NULL)
         return RT_NULL;
 
+#ifdef RT_USING_OBJCACHE
+    stack_start = (void *)rt_objcache_stack_alloc(stack_size);
+#else
     stack_start = (void *)RT_KERNEL_MALLOC(stack_size);
+#endif
     if (stack_start == RT_NULL)
     {
         /* allocate stack failure */
@@ -726,9 +732,7 @@ RTM_EXPORT(rt_thread_timeout);
  */
 rt_thread_t rt_thread_find(char *name)
 {
-    struct rt_object_information *information;
     struct rt_object *object;
-    struct rt_list_node *node;
 
     extern struct rt_object_information rt_object_container[];
 
@@ -736,29 +740,14 @@ rt_thread_t rt_thread_find(char *name)
     if (rt_thread_self() != RT_NULL)
         rt_enter_critical();
 
-    /* try to find device object */
-    information = &rt_object_container[RT_Object_Class_Thread];
-    for (node  = information->object_list.next;
-         node != &(information->object_list);
-         node  = node->next)
-    {
-        object = rt_list_entry(node, struct rt_object, list);
-        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
-        {
-            /* leave critical */
-            if (rt_thread_self() != RT_NULL)
-                rt_exit_critical();
-
-            return (rt_thread_t)object;
-        }
-    }
+    /* try to find thread object */
+    object = rt_object_lookup(&rt_object_container[RT_Object_Class_Thread], name);
 
     /* leave critical */
     if (rt_thread_self() != RT_NULL)
         rt_exit_critical();
 
-    /* not found */
-    return RT_NULL;
+    return (rt_thread_t)object;
 }
 RTM_EXPORT(rt_thread_find);
 
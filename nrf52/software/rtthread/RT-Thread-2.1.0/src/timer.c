@@ -30,13 +30,45 @@
  * 2012-12-15     Bernard      fix the next timeout issue in soft timer
  * 2014-07-12     Bernard      does not lock scheduler when invoking soft-timer 
  *                             timeout function.
+ * 2026-10-17     agent        add the hierarchical timing wheel (RT_USING_TIMER_WHEEL).
+ * 2026-10-17     agent        invoke the hard timer timeout function with interrupt enabled,
+ *                             and bound the interrupt disabled window of timer check.
+ * 2026-10-17     agent        invoke the rest of expired hard timers by the next tick instead of timer
+ *                             thread, and don't touch the timer which is taken over by its timeout function.
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_USING_TIMER_WHEEL
+#define RT_TIMER_WHEEL_SIZE            (1UL << RT_TIMER_WHEEL_BITS)
+#define RT_TIMER_WHEEL_MASK            (RT_TIMER_WHEEL_SIZE - 1)
+
+struct rt_timer_wheel
+{
+    rt_tick_t   tick;                                   /* the last checked tick */
+    rt_uint32_t bitmap[RT_TIMER_WHEEL_LEVEL];           /* the slots which are not empty */
+    rt_list_t   slot[RT_TIMER_WHEEL_LEVEL][RT_TIMER_WHEEL_SIZE];
+    rt_list_t   cascade;                                /* the timers which are being cascaded */
+};
+
+/* hard timer wheel */
+static struct rt_timer_wheel rt_timer_wheel;
+#else
 /* hard timer list */
 static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif
+/* the expired hard timers, the timeout functions are invoked with interrupt enabled */
+static rt_list_t rt_timer_expired_list;
+/* the timer check is running, it's not re-entered when the tick interrupt preempts idle thread */
+static rt_bool_t rt_timer_checking;
+/* the hard timer whose timeout function is being invoked, it's cleared when the timer is removed */
+static rt_timer_t rt_timer_invoking;
+
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+/* the longest interrupt disabled window of timer in CPU cycles */
+static rt_uint32_t rt_timer_irqoff_nest, rt_timer_irqoff_start, rt_timer_irqoff_cycle;
+#endif
 
 #ifdef RT_USING_TIMER_SOFT
 #ifndef RT_TIMER_THREAD_STACK_SIZE
@@ -47,8 +79,13 @@ static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 #define RT_TIMER_THREAD_PRIO           0
 #endif
 
+#ifdef RT_USING_TIMER_WHEEL
+/* soft timer wheel */
+static struct rt_timer_wheel rt_soft_timer_wheel;
+#else
 /* soft timer list */
 static rt_list_t rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif
 static struct rt_thread timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -57,7 +94,7 @@ static rt_uint8_t timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
 #ifdef RT_USING_HOOK
 extern void (*rt_object_take_hook)(struct rt_object *object);
 extern void (*rt_object_put_hook)(struct rt_object *object);
-static void (*rt_timer_timeout_hook)(struct rt_timer *timer);
+void (*rt_timer_timeout_hook)(struct rt_timer *timer);
 
 /**
  * @addtogroup Hook
@@ -79,6 +116,36 @@ void rt_timer_timeout_sethook(void (*hook)(struct rt_timer *timer))
 /**@}*/
 #endif
 
+/* disable interrupt in timer, the outermost interrupt disabled window is measured */
+rt_inline rt_base_t _rt_timer_irq_disable(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+    if (rt_timer_irqoff_nest++ == 0)
+        rt_timer_irqoff_start = rt_hw_cycle_get();
+#endif
+
+    return level;
+}
+
+rt_inline void _rt_timer_irq_enable(rt_base_t level)
+{
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+    rt_uint32_t cycle;
+
+    if (--rt_timer_irqoff_nest == 0)
+    {
+        cycle = rt_hw_cycle_get() - rt_timer_irqoff_start;
+        if (cycle > rt_timer_irqoff_cycle)
+            rt_timer_irqoff_cycle = cycle;
+    }
+#endif
+
+    rt_hw_interrupt_enable(level);
+}
+
 static void _rt_timer_init(rt_timer_t timer,
                            void (*timeout)(void *parameter),
                            void      *parameter,
@@ -106,6 +173,7 @@ static void _rt_timer_init(rt_timer_t timer,
     }
 }
 
+#ifndef RT_USING_TIMER_WHEEL
 /* the fist timer always in the last row */
 static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 {
@@ -119,6 +187,7 @@ static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 
     return timer->timeout_tick;
 }
+#endif
 
 rt_inline void _rt_timer_remove(rt_timer_t timer)
 {
@@ -128,7 +197,255 @@ rt_inline void _rt_timer_remove(rt_timer_t timer)
     {
         rt_list_remove(&timer->row[i]);
     }
+
+    /* the timer is started, stopped or deleted while its timeout function is invoked */
+    if (timer == rt_timer_invoking)
+        rt_timer_invoking = RT_NULL;
+}
+
+#ifndef RT_USING_TIMER_WHEEL
+/*
+ * Move the timeout timers to the expired list by the first row, it must be
+ * invoked with interrupt disabled. At most RT_TIMER_CHECK_BATCH timers are
+ * moved, so the caller can enable interrupt between the batches.
+ *
+ * @return RT_TRUE if all timeout timers are moved
+ */
+static rt_bool_t _rt_timer_list_expire(rt_list_t timer_list[],
+                                       rt_tick_t current_tick,
+                                       rt_list_t *expired)
+{
+    struct rt_timer *t;
+    int count;
+
+    for (count = 0; count < RT_TIMER_CHECK_BATCH; count++)
+    {
+        if (rt_list_isempty(&timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+            return RT_TRUE;
+
+        t = rt_list_entry(timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+                          struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+        /*
+         * It supposes that the new tick shall less than the half duration of
+         * tick max.
+         */
+        if ((current_tick - t->timeout_tick) >= RT_TICK_MAX / 2)
+            return RT_TRUE;
+
+        _rt_timer_remove(t);
+        rt_list_insert_before(expired, &t->row[0]);
+    }
+
+    return RT_FALSE;
 }
+#endif
+
+#ifdef RT_USING_TIMER_WHEEL
+extern int __rt_ffs(int value);
+
+/* join the from list to the tail of the to list in O(1), the from list is empty after join */
+rt_inline void _rt_timer_list_join(rt_list_t *to, rt_list_t *from)
+{
+    if (rt_list_isempty(from))
+        return;
+
+    from->next->prev = to->prev;
+    to->prev->next   = from->next;
+    from->prev->next = to;
+    to->prev         = from->prev;
+    rt_list_init(from);
+}
+
+static void _rt_timer_wheel_init(struct rt_timer_wheel *wheel)
+{
+    int level, index;
+
+    wheel->tick = rt_tick_get();
+    rt_list_init(&wheel->cascade);
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        wheel->bitmap[level] = 0;
+        for (index = 0; index < RT_TIMER_WHEEL_SIZE; index++)
+        {
+            rt_list_init(&wheel->slot[level][index]);
+        }
+    }
+}
+
+/*
+ * Insert the timer to the wheel in O(1), it must be invoked with interrupt
+ * disabled. The level n slot is (1 << (n * RT_TIMER_WHEEL_BITS)) ticks, the
+ * timer is moved to the lower level slot (cascade) when the lower level wraps.
+ */
+static void _rt_timer_wheel_insert(struct rt_timer_wheel *wheel, struct rt_timer *timer)
+{
+    rt_tick_t delta, timeout_tick;
+    int level, index;
+
+    timeout_tick = timer->timeout_tick;
+    delta = timeout_tick - wheel->tick;
+    /* the timeout timer will be checked on the next tick */
+    if (delta - 1 >= RT_TICK_MAX / 2)
+    {
+        delta = 1;
+        timeout_tick = wheel->tick + 1;
+    }
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL - 1; level++)
+    {
+        if (delta < (1UL << ((level + 1) * RT_TIMER_WHEEL_BITS)))
+            break;
+    }
+    /* the timer out of the wheel is put to the last slot, it will be inserted again on cascade */
+    if (delta >= (1UL << ((level + 1) * RT_TIMER_WHEEL_BITS)))
+        timeout_tick = wheel->tick + (1UL << ((level + 1) * RT_TIMER_WHEEL_BITS)) - 1;
+
+    index = (timeout_tick >> (level * RT_TIMER_WHEEL_BITS)) & RT_TIMER_WHEEL_MASK;
+    rt_list_insert_before(&wheel->slot[level][index], &timer->row[0]);
+    wheel->bitmap[level] |= 1UL << index;
+}
+
+/* start the timer on wheel, it must be invoked with interrupt disabled */
+static void _rt_timer_wheel_start(struct rt_timer_wheel *wheel, struct rt_timer *timer)
+{
+    int level;
+
+    /* the empty wheel is turned to current tick directly, no timer is skipped */
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        if (wheel->bitmap[level])
+            break;
+    }
+    if (level == RT_TIMER_WHEEL_LEVEL && rt_list_isempty(&wheel->cascade))
+        wheel->tick = rt_tick_get();
+
+    _rt_timer_wheel_insert(wheel, timer);
+}
+
+/* detach the timers of current slot in O(1), they are moved to the lower level later */
+static void _rt_timer_wheel_cascade(struct rt_timer_wheel *wheel, int level)
+{
+    int index;
+
+    index = (wheel->tick >> (level * RT_TIMER_WHEEL_BITS)) & RT_TIMER_WHEEL_MASK;
+    wheel->bitmap[level] &= ~(1UL << index);
+    _rt_timer_list_join(&wheel->cascade, &wheel->slot[level][index]);
+}
+
+/*
+ * Turn the wheel to current tick and move the timeout timers to the expired
+ * list, it must be invoked with interrupt disabled. The empty slots are
+ * skipped by the bitmap, so it's fast after tickless sleep too. The timeout
+ * slot is joined in O(1), but the cascaded timers are inserted one by one,
+ * so at most RT_TIMER_CHECK_BATCH of them are moved in one invoking.
+ *
+ * @return RT_TRUE if the wheel is turned to current tick
+ */
+static rt_bool_t _rt_timer_wheel_expire(struct rt_timer_wheel *wheel,
+                                        rt_tick_t current_tick,
+                                        rt_list_t *expired)
+{
+    struct rt_timer *t;
+    rt_uint32_t pending;
+    rt_tick_t step;
+    int level, index, count = 0;
+
+    while (1)
+    {
+        /* the timers can be started or stopped between batches, the wheel tick is not changed */
+        while (!rt_list_isempty(&wheel->cascade))
+        {
+            if (count++ == RT_TIMER_CHECK_BATCH)
+                return RT_FALSE;
+
+            t = rt_list_entry(wheel->cascade.next, struct rt_timer, row[0]);
+            rt_list_remove(&t->row[0]);
+
+            if (t->timeout_tick == wheel->tick)
+                rt_list_insert_before(expired, &t->row[0]);
+            else
+                _rt_timer_wheel_insert(wheel, t);
+        }
+
+        if ((current_tick - wheel->tick - 1) >= RT_TICK_MAX / 2)
+            return RT_TRUE;
+
+        /* go to the next not empty slot, but stop at the end of level 0 to cascade */
+        index = wheel->tick & RT_TIMER_WHEEL_MASK;
+        step = RT_TIMER_WHEEL_SIZE - index;
+        if (step > current_tick - wheel->tick)
+            step = current_tick - wheel->tick;
+        pending = (wheel->bitmap[0] >> index) >> 1;
+        pending &= (1UL << (step - 1)) - 1;
+        if (pending)
+            step = __rt_ffs(pending);
+        wheel->tick += step;
+
+        index = wheel->tick & RT_TIMER_WHEEL_MASK;
+        if (index == 0)
+        {
+            for (level = 1; level < RT_TIMER_WHEEL_LEVEL; level++)
+            {
+                _rt_timer_wheel_cascade(wheel, level);
+                if ((wheel->tick >> (level * RT_TIMER_WHEEL_BITS)) & RT_TIMER_WHEEL_MASK)
+                    break;
+            }
+        }
+
+        if (wheel->bitmap[0] & (1UL << index))
+        {
+            wheel->bitmap[0] &= ~(1UL << index);
+            _rt_timer_list_join(expired, &wheel->slot[0][index]);
+        }
+    }
+}
+
+/*
+ * Get the next timeout tick of wheel, it's exact for the level 0 timer. The
+ * upper level timer returns its cascade tick, it's never later than timeout.
+ */
+static rt_tick_t _rt_timer_wheel_next_timeout(struct rt_timer_wheel *wheel)
+{
+    rt_tick_t next_timeout = RT_TICK_MAX, timeout_tick;
+    rt_uint32_t pending;
+    int level, index, shift, distance;
+
+    /* the cascade is not finished, it's checked on the next tick */
+    if (!rt_list_isempty(&wheel->cascade))
+        return wheel->tick + 1;
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        shift = level * RT_TIMER_WHEEL_BITS;
+        index = (wheel->tick >> shift) & RT_TIMER_WHEEL_MASK;
+
+        while (wheel->bitmap[level])
+        {
+            /* rotate the bitmap, the bit 0 is the next slot */
+            pending = ((wheel->bitmap[level] >> index) >> 1)
+                    | (wheel->bitmap[level] << (RT_TIMER_WHEEL_MASK - index));
+            pending &= (2UL << RT_TIMER_WHEEL_MASK) - 1;
+            distance = __rt_ffs(pending);
+
+            /* the bit of removed timer is cleared lazily */
+            if (rt_list_isempty(&wheel->slot[level][(index + distance) & RT_TIMER_WHEEL_MASK]))
+            {
+                wheel->bitmap[level] &= ~(1UL << ((index + distance) & RT_TIMER_WHEEL_MASK));
+                continue;
+            }
+
+            timeout_tick = ((wheel->tick >> shift) + distance) << shift;
+            if (next_timeout == RT_TICK_MAX ||
+                (timeout_tick - wheel->tick) < (next_timeout - wheel->tick))
+                next_timeout = timeout_tick;
+            break;
+        }
+    }
+
+    return next_timeout;
+}
+#endif /* RT_USING_TIMER_WHEEL */
 
 #if RT_DEBUG_TIMER
 static int rt_timer_count_height(struct rt_timer *timer)
@@ -209,12 +526,12 @@ rt_err_t rt_timer_detach(rt_timer_t timer)
     RT_ASSERT(timer != RT_NULL);
 
     /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    level = _rt_timer_irq_disable();
 
     _rt_timer_remove(timer);
 
     /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
     rt_object_detach((rt_object_t)timer);
 
@@ -270,12 +587,12 @@ rt_err_t rt_timer_delete(rt_timer_t timer)
     RT_ASSERT(timer != RT_NULL);
 
     /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    level = _rt_timer_irq_disable();
 
     _rt_timer_remove(timer);
 
     /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
     rt_object_delete((rt_object_t)timer);
 
@@ -293,23 +610,27 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
+    register rt_base_t level;
+#ifdef RT_USING_TIMER_WHEEL
+    struct rt_timer_wheel *timer_wheel;
+#else
     unsigned int row_lvl;
     rt_list_t *timer_list;
-    register rt_base_t level;
     rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
     unsigned int tst_nr;
     static unsigned int random_nr;
+#endif
 
     /* timer check */
     RT_ASSERT(timer != RT_NULL);
 
 	/* stop timer firstly */
-	level = rt_hw_interrupt_disable();
+	level = _rt_timer_irq_disable();
 	/* remove timer from list */
     _rt_timer_remove(timer);
     /* change status of timer */
     timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
     RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(timer->parent)));
 
@@ -321,8 +642,24 @@ rt_err_t rt_timer_start(rt_timer_t timer)
     timer->timeout_tick = rt_tick_get() + timer->init_tick;
 
     /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    level = _rt_timer_irq_disable();
 
+#ifdef RT_USING_TIMER_WHEEL
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+    {
+        /* insert timer to soft timer wheel */
+        timer_wheel = &rt_soft_timer_wheel;
+    }
+    else
+#endif
+    {
+        /* insert timer to system timer wheel */
+        timer_wheel = &rt_timer_wheel;
+    }
+
+    _rt_timer_wheel_start(timer_wheel, timer);
+#else
 #ifdef RT_USING_TIMER_SOFT
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
@@ -386,11 +723,12 @@ rt_err_t rt_timer_start(rt_timer_t timer)
          * bits. */
         tst_nr >>= (RT_TIMER_SKIP_LIST_MASK+1)>>1;
     }
+#endif
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
     /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
 #ifdef RT_USING_TIMER_SOFT
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
@@ -428,12 +766,12 @@ rt_err_t rt_timer_stop(rt_timer_t timer)
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(timer->parent)));
 
     /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    level = _rt_timer_irq_disable();
 
     _rt_timer_remove(timer);
 
     /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
     /* change stat */
     timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
@@ -479,68 +817,119 @@ rt_err_t rt_timer_control(rt_timer_t timer, rt_uint8_t cmd, void *arg)
 }
 RTM_EXPORT(rt_timer_control);
 
+/*
+ * Invoke the timeout functions of expired hard timers with interrupt enabled,
+ * it must be invoked with interrupt disabled, and it returns with interrupt
+ * disabled too. The timer which is stopped or restarted before its timeout
+ * function is invoked is removed from the expired list. The timer which is
+ * started, stopped or deleted while its timeout function is invoked is not
+ * touched after the function returns, it may have been freed.
+ *
+ * @param budget the max timeout functions to be invoked, 0 is unlimited
+ * @param level the interrupt level which is returned by _rt_timer_irq_disable
+ *
+ * @return RT_TRUE if all expired timers are invoked
+ */
+static rt_bool_t _rt_timer_invoke(rt_uint32_t budget, rt_base_t level)
+{
+    struct rt_timer *t;
+    rt_uint32_t count = 0;
+
+    while (!rt_list_isempty(&rt_timer_expired_list))
+    {
+        if (budget && count++ == budget)
+            return RT_FALSE;
+
+        t = rt_list_entry(rt_timer_expired_list.next, struct rt_timer, row[0]);
+
+        RT_OBJECT_HOOK_CALL(rt_timer_timeout_hook, (t));
+
+        /* remove timer from expired list firstly */
+        _rt_timer_remove(t);
+        rt_timer_invoking = t;
+
+        /* call timeout function */
+        _rt_timer_irq_enable(level);
+        t->timeout_func(t->parameter);
+        level = _rt_timer_irq_disable();
+
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", rt_tick_get()));
+
+        /* the timer is taken over by the timeout function or others with interrupt enabled */
+        if (rt_timer_invoking != t)
+            continue;
+        rt_timer_invoking = RT_NULL;
+
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
+        }
+        else
+        {
+            /* stop timer */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+    }
+
+    return RT_TRUE;
+}
+
 /**
  * This function will check timer list, if a timeout event happens, the
  * corresponding timeout function will be invoked.
  *
+ * The timeout timers are moved to the expired list in batches with interrupt
+ * disabled, then the timeout functions are invoked with interrupt enabled. At
+ * most RT_TIMER_CHECK_BUDGET timeout functions are invoked in one check, the
+ * rest are invoked by the check of next tick, so they are always invoked in
+ * the timer interrupt and not by a lower priority thread.
+ *
  * @note this function shall be invoked in operating system timer interrupt.
  */
 void rt_timer_check(void)
 {
-    struct rt_timer *t;
     rt_tick_t current_tick;
     register rt_base_t level;
+    rt_bool_t finished;
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("timer check enter\n"));
 
-    current_tick = rt_tick_get();
-
     /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    level = _rt_timer_irq_disable();
 
-    while (!rt_list_isempty(&rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL-1]))
+    /* the check in idle thread after tickless sleep is preempted, the new tick is checked by it */
+    if (rt_timer_checking)
     {
-        t = rt_list_entry(rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                          struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
-
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX/2)
-        {
-            RT_OBJECT_HOOK_CALL(rt_timer_timeout_hook, (t));
+        _rt_timer_irq_enable(level);
+        return;
+    }
+    rt_timer_checking = RT_TRUE;
 
-            /* remove timer from timer list firstly */
-            _rt_timer_remove(t);
+    do
+    {
+        current_tick = rt_tick_get();
 
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        /* the interrupt is served between the batches */
+#ifdef RT_USING_TIMER_WHEEL
+        while (!_rt_timer_wheel_expire(&rt_timer_wheel, current_tick, &rt_timer_expired_list))
+#else
+        while (!_rt_timer_list_expire(rt_timer_list, current_tick, &rt_timer_expired_list))
+#endif
+        {
+            _rt_timer_irq_enable(level);
+            level = _rt_timer_irq_disable();
+        }
 
-            /* re-get tick */
-            current_tick = rt_tick_get();
+        finished = _rt_timer_invoke(RT_TIMER_CHECK_BUDGET, level);
+    } while (finished && current_tick != rt_tick_get());
 
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
-
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
-            else
-            {
-                /* stop timer */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-        }
-        else
-            break;
-    }
+    rt_timer_checking = RT_FALSE;
 
     /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    _rt_timer_irq_enable(level);
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("timer check leave\n"));
 }
@@ -552,8 +941,48 @@ void rt_timer_check(void)
  */
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
-    return rt_timer_list_next_timeout(rt_timer_list);
+    rt_tick_t next_timeout;
+    register rt_base_t level;
+
+    level = _rt_timer_irq_disable();
+    /* the expired timers which are out of the check budget are invoked by the next tick */
+    if (!rt_list_isempty(&rt_timer_expired_list))
+        next_timeout = rt_tick_get() + 1;
+    else
+#ifdef RT_USING_TIMER_WHEEL
+        next_timeout = _rt_timer_wheel_next_timeout(&rt_timer_wheel);
+#else
+        next_timeout = rt_timer_list_next_timeout(rt_timer_list);
+#endif
+    _rt_timer_irq_enable(level);
+
+    return next_timeout;
+}
+
+#ifdef RT_USING_TIMER_IRQOFF_STAT
+/**
+ * This function will get the longest interrupt disabled window of timer start,
+ * stop and check, it's measured by the cycle counter of CPU.
+ *
+ * @param reset RT_TRUE to clear it after get
+ *
+ * @return the CPU cycles of the longest window
+ */
+rt_uint32_t rt_timer_irqoff_max(rt_bool_t reset)
+{
+    rt_uint32_t cycle;
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    cycle = rt_timer_irqoff_cycle;
+    if (reset)
+        rt_timer_irqoff_cycle = 0;
+    rt_hw_interrupt_enable(level);
+
+    return cycle;
 }
+RTM_EXPORT(rt_timer_irqoff_max);
+#endif
 
 #ifdef RT_USING_TIMER_SOFT
 /**
@@ -563,13 +992,74 @@ rt_tick_t rt_timer_next_timeout_tick(void)
 void rt_soft_timer_check(void)
 {
     rt_tick_t current_tick;
-    rt_list_t *n;
     struct rt_timer *t;
+#ifdef RT_USING_TIMER_WHEEL
+    register rt_base_t level;
+    rt_list_t expired;
+#else
+    rt_list_t *n;
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("software timer check enter\n"));
 
     current_tick = rt_tick_get();
 
+#ifdef RT_USING_TIMER_WHEEL
+    rt_list_init(&expired);
+
+    /* the soft timer can be started in interrupt, the interrupt is served between the batches */
+    level = _rt_timer_irq_disable();
+    while (!_rt_timer_wheel_expire(&rt_soft_timer_wheel, current_tick, &expired))
+    {
+        _rt_timer_irq_enable(level);
+        level = _rt_timer_irq_disable();
+    }
+    _rt_timer_irq_enable(level);
+
+    /* lock scheduler */
+    rt_enter_critical();
+
+    while (!rt_list_isempty(&expired))
+    {
+        t = rt_list_entry(expired.next, struct rt_timer, row[0]);
+
+        RT_OBJECT_HOOK_CALL(rt_timer_timeout_hook, (t));
+
+        /* remove timer from expired list firstly */
+        level = _rt_timer_irq_disable();
+        _rt_timer_remove(t);
+        _rt_timer_irq_enable(level);
+
+        /* not lock scheduler when performing timeout function */
+        rt_exit_critical();
+        /* call timeout function */
+        t->timeout_func(t->parameter);
+
+        /* re-get tick */
+        current_tick = rt_tick_get();
+
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+
+        /* lock scheduler */
+        rt_enter_critical();
+
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
+        }
+        else
+        {
+            /* stop timer */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+    }
+
+    /* unlock scheduler */
+    rt_exit_critical();
+#else
 	/* lock scheduler */
 	rt_enter_critical();
 
@@ -623,6 +1113,7 @@ void rt_soft_timer_check(void)
 
 	/* unlock scheduler */
 	rt_exit_critical();
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("software timer check leave\n"));
 }
@@ -630,22 +1121,32 @@ void rt_soft_timer_check(void)
 /* system timer thread entry */
 static void rt_thread_timer_entry(void *parameter)
 {
+    register rt_base_t level;
     rt_tick_t next_timeout;
 
     while (1)
     {
+        level = _rt_timer_irq_disable();
+
         /* get the next timeout tick */
+#ifdef RT_USING_TIMER_WHEEL
+        next_timeout = _rt_timer_wheel_next_timeout(&rt_soft_timer_wheel);
+#else
         next_timeout = rt_timer_list_next_timeout(rt_soft_timer_list);
+#endif
         if (next_timeout == RT_TICK_MAX)
         {
-            /* no software timer exist, suspend self. */
+            /* no software timer exist, suspend self. it's resumed by soft timer start after interrupt enabled */
             rt_thread_suspend(rt_thread_self());
+            _rt_timer_irq_enable(level);
             rt_schedule();
         }
         else
         {
             rt_tick_t current_tick;
 
+            _rt_timer_irq_enable(level);
+
             /* get current tick */
             current_tick = rt_tick_get();
 
@@ -670,12 +1171,18 @@ static void rt_thread_timer_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+    rt_list_init(&rt_timer_expired_list);
+
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_timer_wheel);
+#else
     int i;
 
     for (i = 0; i < sizeof(rt_timer_list)/sizeof(rt_timer_list[0]); i++)
     {
         rt_list_init(rt_timer_list+i);
     }
+#endif
 }
 
 /**
@@ -686,6 +1193,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_soft_timer_wheel);
+#else
     int i;
 
     for (i = 0;
@@ -694,6 +1204,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(rt_soft_timer_list+i);
     }
+#endif
 
     /* start software timer thread */
     rt_thread_init(&timer_thread,
@@ -0,0 +1,771 @@
+/*
+ * File      : tlsf.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, Two-Level Segregated Fit heap
+ */
+
+/*
+ * The TLSF (Two-Level Segregated Fit) heap keeps the free blocks in the
+ * segregated lists, which are indexed by two levels of the block size. The
+ * first level is the power of two, and the second level divides it linearly
+ * to TLSF_SL_INDEX_COUNT lists. The not empty lists are marked in bitmaps, so
+ * the malloc finds a suitable free block by two find-first-set operations, and
+ * the free merges the physical neighbor blocks immediately. Both of them are
+ * O(1) and never walk the heap.
+ *
+ * The requested size is rounded up to the next list, so every free block in the
+ * found list is large enough (good fit). The first block in the list of the
+ * requested size itself is also checked when the upper lists are empty, then
+ * the last large free block of heap can be allocated.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifndef RT_USING_MEMHEAP_AS_HEAP
+
+/* #define RT_MEM_DEBUG */
+#define RT_MEM_STATS
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_TLSF)
+
+#if defined (RT_USING_SMALL_MEM) || defined (RT_USING_SLAB)
+#error "the RT_USING_TLSF is instead of RT_USING_SMALL_MEM and RT_USING_SLAB, only one of them can be used"
+#endif
+
+/* the max block size is (1 << RT_TLSF_FL_INDEX_MAX), the larger heap is truncated */
+#ifndef RT_TLSF_FL_INDEX_MAX
+#define RT_TLSF_FL_INDEX_MAX           20
+#endif
+
+/* the second level lists of each first level */
+#define TLSF_SL_INDEX_COUNT_LOG2       4
+#define TLSF_SL_INDEX_COUNT            (1UL << TLSF_SL_INDEX_COUNT_LOG2)
+
+/* the block which is smaller than TLSF_SMALL_BLOCK_SIZE is in the first level 0 */
+#define TLSF_FL_INDEX_SHIFT            (TLSF_SL_INDEX_COUNT_LOG2 + 3)
+#define TLSF_FL_INDEX_COUNT            (RT_TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE          (1UL << TLSF_FL_INDEX_SHIFT)
+
+#if TLSF_FL_INDEX_COUNT <= 0 || RT_TLSF_FL_INDEX_MAX >= 32
+#error "the RT_TLSF_FL_INDEX_MAX shall be in 8 to 31"
+#endif
+
+/* the block data is aligned to the size overhead, the RT_ALIGN_SIZE shall not be larger than it */
+#define TLSF_ALIGN_SIZE                (sizeof(rt_size_t))
+
+/* the bit 0 and 1 of block size are the flags, the size is always aligned */
+#define TLSF_BLOCK_FREE                0x01
+#define TLSF_BLOCK_PREV_FREE           0x02
+#define TLSF_BLOCK_FLAG_MASK           (TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE)
+
+struct tlsf_block
+{
+    /* the previous physical block, it's valid only when the previous block is free */
+    struct tlsf_block *prev_phys;
+
+    /* the data size and flags of block */
+    rt_size_t size;
+
+    /* the free list, they are valid only when the block is free */
+    struct tlsf_block *next_free;
+    struct tlsf_block *prev_free;
+};
+
+/*
+ * The used block only has the size overhead, the prev_phys of the next block
+ * is the last word of current block data, it's used only when it's free.
+ */
+#define TLSF_BLOCK_OVERHEAD            (sizeof(rt_size_t))
+#define TLSF_BLOCK_DATA_OFFSET         (sizeof(struct tlsf_block *) + sizeof(rt_size_t))
+#define TLSF_BLOCK_SIZE_MIN            (sizeof(struct tlsf_block) - sizeof(struct tlsf_block *))
+#define TLSF_BLOCK_SIZE_MAX            (1UL << RT_TLSF_FL_INDEX_MAX)
+
+struct tlsf_control
+{
+    /* the not empty lists of first level and second level */
+    rt_uint32_t fl_bitmap;
+    rt_uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+
+    /* the heads of free lists */
+    struct tlsf_block *blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+};
+
+#ifdef RT_USING_HOOK
+void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+void (*rt_free_hook)(void *ptr);
+
+/**
+ * @addtogroup Hook
+ */
+
+/**@{*/
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated from heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_malloc_hook = hook;
+}
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released to heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_free_sethook(void (*hook)(void *ptr))
+{
+    rt_free_hook = hook;
+}
+
+/**@}*/
+
+#endif
+
+extern int __rt_ffs(int value);
+
+static struct tlsf_control tlsf;
+
+/** the heap begin and end address */
+static rt_uint8_t *heap_ptr, *heap_end;
+
+static struct rt_semaphore heap_sem;
+static rt_size_t mem_size_aligned;
+
+#ifdef RT_MEM_STATS
+static rt_size_t used_mem, max_mem;
+#endif
+
+/* find the last set bit, the index is 0 based, and -1 if the value is 0 */
+rt_inline int tlsf_fls(rt_uint32_t value)
+{
+#if defined (__GNUC__)
+    return value ? 31 - __builtin_clz((unsigned int)value) : -1;
+#else
+    int bit = 31;
+
+    if (value == 0)
+        return -1;
+    if (!(value & 0xffff0000UL)) { value <<= 16; bit -= 16; }
+    if (!(value & 0xff000000UL)) { value <<= 8;  bit -= 8;  }
+    if (!(value & 0xf0000000UL)) { value <<= 4;  bit -= 4;  }
+    if (!(value & 0xc0000000UL)) { value <<= 2;  bit -= 2;  }
+    if (!(value & 0x80000000UL)) { bit -= 1; }
+
+    return bit;
+#endif
+}
+
+rt_inline rt_size_t tlsf_block_size(const struct tlsf_block *block)
+{
+    return block->size & ~TLSF_BLOCK_FLAG_MASK;
+}
+
+rt_inline void tlsf_block_set_size(struct tlsf_block *block, rt_size_t size)
+{
+    block->size = size | (block->size & TLSF_BLOCK_FLAG_MASK);
+}
+
+rt_inline rt_uint8_t *tlsf_block_to_ptr(const struct tlsf_block *block)
+{
+    return (rt_uint8_t *)block + TLSF_BLOCK_DATA_OFFSET;
+}
+
+rt_inline struct tlsf_block *tlsf_block_from_ptr(const void *ptr)
+{
+    return (struct tlsf_block *)((rt_uint8_t *)ptr - TLSF_BLOCK_DATA_OFFSET);
+}
+
+/* the next physical block, it's valid when the block is not the last sentinel */
+rt_inline struct tlsf_block *tlsf_block_next(const struct tlsf_block *block)
+{
+    return (struct tlsf_block *)(tlsf_block_to_ptr(block) + tlsf_block_size(block)
+                                 - sizeof(struct tlsf_block *));
+}
+
+rt_inline struct tlsf_block *tlsf_block_link_next(struct tlsf_block *block)
+{
+    struct tlsf_block *next = tlsf_block_next(block);
+
+    next->prev_phys = block;
+
+    return next;
+}
+
+rt_inline void tlsf_block_mark_as_free(struct tlsf_block *block)
+{
+    struct tlsf_block *next = tlsf_block_link_next(block);
+
+    next->size  |= TLSF_BLOCK_PREV_FREE;
+    block->size |= TLSF_BLOCK_FREE;
+}
+
+rt_inline void tlsf_block_mark_as_used(struct tlsf_block *block)
+{
+    struct tlsf_block *next = tlsf_block_next(block);
+
+    next->size  &= ~TLSF_BLOCK_PREV_FREE;
+    block->size &= ~TLSF_BLOCK_FREE;
+}
+
+/* get the list index of block size, the block in the list is not smaller than the first size of list */
+rt_inline void tlsf_mapping_insert(rt_size_t size, int *fl, int *sl)
+{
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+    }
+    else
+    {
+        *fl = tlsf_fls(size);
+        *sl = (size >> (*fl - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        *fl -= TLSF_FL_INDEX_SHIFT - 1;
+    }
+}
+
+/* get the list index for the requested size, every block in the list is large enough */
+rt_inline void tlsf_mapping_search(rt_size_t size, int *fl, int *sl)
+{
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+        size += (1UL << (tlsf_fls(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    else
+        size += TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT - 1;
+
+    tlsf_mapping_insert(size, fl, sl);
+}
+
+/* find the first not empty list from the index by bitmaps */
+static struct tlsf_block *tlsf_search_suitable_block(int *fl, int *sl)
+{
+    rt_uint32_t fl_map, sl_map;
+
+    if (*fl >= TLSF_FL_INDEX_COUNT)
+        return RT_NULL;
+
+    sl_map = tlsf.sl_bitmap[*fl] & (~0UL << *sl);
+    if (!sl_map)
+    {
+        /* the lists of the first level are empty, go to the upper first level */
+        fl_map = tlsf.fl_bitmap & (~0UL << (*fl + 1));
+        if (!fl_map)
+            return RT_NULL;
+
+        *fl = __rt_ffs(fl_map) - 1;
+        sl_map = tlsf.sl_bitmap[*fl];
+    }
+    *sl = __rt_ffs(sl_map) - 1;
+
+    return tlsf.blocks[*fl][*sl];
+}
+
+static void tlsf_remove_free_block(struct tlsf_block *block, int fl, int sl)
+{
+    struct tlsf_block *prev = block->prev_free;
+    struct tlsf_block *next = block->next_free;
+
+    if (next != RT_NULL)
+        next->prev_free = prev;
+    if (prev != RT_NULL)
+        prev->next_free = next;
+
+    if (tlsf.blocks[fl][sl] == block)
+    {
+        tlsf.blocks[fl][sl] = next;
+        if (next == RT_NULL)
+        {
+            tlsf.sl_bitmap[fl] &= ~(1UL << sl);
+            if (!tlsf.sl_bitmap[fl])
+                tlsf.fl_bitmap &= ~(1UL << fl);
+        }
+    }
+}
+
+static void tlsf_insert_free_block(struct tlsf_block *block, int fl, int sl)
+{
+    struct tlsf_block *current = tlsf.blocks[fl][sl];
+
+    block->next_free = current;
+    block->prev_free = RT_NULL;
+    if (current != RT_NULL)
+        current->prev_free = block;
+
+    tlsf.blocks[fl][sl] = block;
+    tlsf.fl_bitmap |= 1UL << fl;
+    tlsf.sl_bitmap[fl] |= 1UL << sl;
+}
+
+static void tlsf_block_remove(struct tlsf_block *block)
+{
+    int fl, sl;
+
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+    tlsf_remove_free_block(block, fl, sl);
+}
+
+static void tlsf_block_insert(struct tlsf_block *block)
+{
+    int fl, sl;
+
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+    tlsf_insert_free_block(block, fl, sl);
+}
+
+rt_inline rt_bool_t tlsf_block_can_split(struct tlsf_block *block, rt_size_t size)
+{
+    return tlsf_block_size(block) >= sizeof(struct tlsf_block) + size;
+}
+
+/* split the block to the size, and return the remaining block */
+static struct tlsf_block *tlsf_block_split(struct tlsf_block *block, rt_size_t size)
+{
+    struct tlsf_block *remaining;
+    rt_size_t remaining_size;
+
+    remaining = (struct tlsf_block *)(tlsf_block_to_ptr(block) + size - sizeof(struct tlsf_block *));
+    remaining_size = tlsf_block_size(block) - (size + TLSF_BLOCK_OVERHEAD);
+
+    RT_ASSERT(remaining_size >= TLSF_BLOCK_SIZE_MIN);
+
+    remaining->size = remaining_size;
+    tlsf_block_set_size(block, size);
+    tlsf_block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/* absorb the free block to the previous physical block */
+static struct tlsf_block *tlsf_block_absorb(struct tlsf_block *prev, struct tlsf_block *block)
+{
+    prev->size += tlsf_block_size(block) + TLSF_BLOCK_OVERHEAD;
+    tlsf_block_link_next(prev);
+
+    return prev;
+}
+
+static struct tlsf_block *tlsf_block_merge_prev(struct tlsf_block *block)
+{
+    struct tlsf_block *prev;
+
+    if (block->size & TLSF_BLOCK_PREV_FREE)
+    {
+        prev = block->prev_phys;
+        RT_ASSERT(prev->size & TLSF_BLOCK_FREE);
+        tlsf_block_remove(prev);
+        block = tlsf_block_absorb(prev, block);
+    }
+
+    return block;
+}
+
+static struct tlsf_block *tlsf_block_merge_next(struct tlsf_block *block)
+{
+    struct tlsf_block *next = tlsf_block_next(block);
+
+    if (next->size & TLSF_BLOCK_FREE)
+    {
+        tlsf_block_remove(next);
+        block = tlsf_block_absorb(block, next);
+    }
+
+    return block;
+}
+
+/* give back the tail of the free block, which will be used */
+static void tlsf_block_trim_free(struct tlsf_block *block, rt_size_t size)
+{
+    struct tlsf_block *remaining;
+
+    if (tlsf_block_can_split(block, size))
+    {
+        remaining = tlsf_block_split(block, size);
+        tlsf_block_link_next(block);
+        remaining->size |= TLSF_BLOCK_PREV_FREE;
+        tlsf_block_insert(remaining);
+    }
+}
+
+/* give back the tail of the used block, it's merged with the next free block */
+static void tlsf_block_trim_used(struct tlsf_block *block, rt_size_t size)
+{
+    struct tlsf_block *remaining;
+
+    if (tlsf_block_can_split(block, size))
+    {
+        remaining = tlsf_block_split(block, size);
+        remaining->size &= ~TLSF_BLOCK_PREV_FREE;
+        remaining = tlsf_block_merge_next(remaining);
+        tlsf_block_insert(remaining);
+    }
+}
+
+/* align the requested size, and 0 is returned if it's too large */
+rt_inline rt_size_t tlsf_adjust_size(rt_size_t size)
+{
+    if (size >= TLSF_BLOCK_SIZE_MAX)
+        return 0;
+
+    size = RT_ALIGN(size, TLSF_ALIGN_SIZE);
+    if (size < TLSF_BLOCK_SIZE_MIN)
+        size = TLSF_BLOCK_SIZE_MIN;
+
+    return size;
+}
+
+/**
+ * @ingroup SystemInit
+ *
+ * This function will initialize system heap memory.
+ *
+ * @param begin_addr the beginning address of system heap memory.
+ * @param end_addr the end address of system heap memory.
+ */
+void rt_system_heap_init(void *begin_addr, void *end_addr)
+{
+    struct tlsf_block *block, *next;
+    rt_ubase_t begin_align = RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN_SIZE);
+    rt_ubase_t end_align = RT_ALIGN_DOWN((rt_ubase_t)end_addr, TLSF_ALIGN_SIZE);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+    RT_ASSERT(RT_ALIGN_SIZE <= TLSF_ALIGN_SIZE);
+
+    /* the first block size and the last sentinel block size are the heap overhead */
+    if ((end_align > (2 * TLSF_BLOCK_OVERHEAD)) &&
+        ((end_align - 2 * TLSF_BLOCK_OVERHEAD) >= begin_align + TLSF_BLOCK_SIZE_MIN))
+    {
+        /* calculate the aligned memory size */
+        mem_size_aligned = end_align - begin_align - 2 * TLSF_BLOCK_OVERHEAD;
+    }
+    else
+    {
+        rt_kprintf("mem init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_uint32_t)begin_addr, (rt_uint32_t)end_addr);
+
+        return;
+    }
+
+    if (mem_size_aligned >= TLSF_BLOCK_SIZE_MAX)
+    {
+        rt_kprintf("mem init, the heap is truncated to %d bytes by RT_TLSF_FL_INDEX_MAX\n",
+                   TLSF_BLOCK_SIZE_MAX - TLSF_ALIGN_SIZE);
+        mem_size_aligned = TLSF_BLOCK_SIZE_MAX - TLSF_ALIGN_SIZE;
+    }
+
+    heap_ptr = (rt_uint8_t *)begin_align;
+    heap_end = heap_ptr + mem_size_aligned + 2 * TLSF_BLOCK_OVERHEAD;
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("mem init, heap begin address 0x%x, size %d\n",
+                                (rt_uint32_t)heap_ptr, mem_size_aligned));
+
+    rt_memset(&tlsf, 0, sizeof(tlsf));
+
+    /* the prev_phys of the first block is out of heap, it's never used */
+    block = (struct tlsf_block *)(heap_ptr - sizeof(struct tlsf_block *));
+    block->size = mem_size_aligned;
+    block->size |= TLSF_BLOCK_FREE;
+    tlsf_block_insert(block);
+
+    /* the last sentinel block is used and its size is 0 */
+    next = tlsf_block_link_next(block);
+    next->size = TLSF_BLOCK_PREV_FREE;
+
+    rt_sem_init(&heap_sem, "heap", 1, RT_IPC_FLAG_FIFO);
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_malloc(rt_size_t size)
+{
+    struct tlsf_block *block;
+    void *ptr = RT_NULL;
+    int fl, sl;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (size == 0)
+        return RT_NULL;
+
+    size = tlsf_adjust_size(size);
+    if (size == 0 || size > mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    /* take memory semaphore */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    tlsf_mapping_search(size, &fl, &sl);
+    block = tlsf_search_suitable_block(&fl, &sl);
+    if (block == RT_NULL)
+    {
+        /* the first block in the list of requested size may be large enough */
+        tlsf_mapping_insert(size, &fl, &sl);
+        block = tlsf.blocks[fl][sl];
+        if (block != RT_NULL && tlsf_block_size(block) < size)
+            block = RT_NULL;
+    }
+    if (block != RT_NULL)
+    {
+        RT_ASSERT(tlsf_block_size(block) >= size);
+
+        tlsf_remove_free_block(block, fl, sl);
+        tlsf_block_trim_free(block, size);
+        tlsf_block_mark_as_used(block);
+        ptr = tlsf_block_to_ptr(block);
+
+#ifdef RT_MEM_STATS
+        used_mem += tlsf_block_size(block) + TLSF_BLOCK_OVERHEAD;
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+#endif
+    }
+
+    rt_sem_release(&heap_sem);
+
+    if (ptr != RT_NULL)
+    {
+        RT_ASSERT((rt_ubase_t)ptr % TLSF_ALIGN_SIZE == 0);
+
+        RT_DEBUG_LOG(RT_DEBUG_MEM,
+                     ("allocate memory at 0x%x, size: %d\n",
+                      (rt_uint32_t)ptr, (rt_uint32_t)tlsf_block_size(block)));
+
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+    }
+
+    return ptr;
+}
+RTM_EXPORT(rt_malloc);
+
+/**
+ * This function will change the previously allocated memory block.
+ *
+ * @param rmem pointer to memory allocated by rt_malloc
+ * @param newsize the required new size
+ *
+ * @return the changed memory block address
+ */
+void *rt_realloc(void *rmem, rt_size_t newsize)
+{
+    struct tlsf_block *block, *next;
+    rt_size_t size, adjust;
+    void *nmem;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+
+    if (newsize == 0)
+    {
+        rt_free(rmem);
+
+        return RT_NULL;
+    }
+
+    adjust = tlsf_adjust_size(newsize);
+    if (adjust == 0 || adjust > mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("realloc: out of memory\n"));
+
+        return RT_NULL;
+    }
+
+    if ((rt_uint8_t *)rmem < heap_ptr || (rt_uint8_t *)rmem >= heap_end)
+    {
+        /* illegal memory */
+        return rmem;
+    }
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    block = tlsf_block_from_ptr(rmem);
+    next = tlsf_block_next(block);
+    size = tlsf_block_size(block);
+
+    RT_ASSERT(!(block->size & TLSF_BLOCK_FREE));
+
+    /* the block is expanded to the next free block in place if it's large enough */
+    if (adjust > size && (!(next->size & TLSF_BLOCK_FREE) ||
+                          adjust > size + tlsf_block_size(next) + TLSF_BLOCK_OVERHEAD))
+    {
+        rt_sem_release(&heap_sem);
+
+        /* expand memory */
+        nmem = rt_malloc(newsize);
+        if (nmem != RT_NULL) /* check memory */
+        {
+            rt_memcpy(nmem, rmem, size < newsize ? size : newsize);
+            rt_free(rmem);
+        }
+
+        return nmem;
+    }
+
+    if (adjust > size)
+    {
+        tlsf_block_merge_next(block);
+        tlsf_block_mark_as_used(block);
+    }
+    tlsf_block_trim_used(block, adjust);
+
+#ifdef RT_MEM_STATS
+    used_mem = used_mem - size + tlsf_block_size(block);
+    if (max_mem < used_mem)
+        max_mem = used_mem;
+#endif
+
+    rt_sem_release(&heap_sem);
+
+    return rmem;
+}
+RTM_EXPORT(rt_realloc);
+
+/**
+ * This function will contiguously allocate enough space for count objects
+ * that are size bytes of memory each and returns a pointer to the allocated
+ * memory.
+ *
+ * The allocated memory is filled with bytes of value zero.
+ *
+ * @param count number of objects to allocate
+ * @param size size of the objects to allocate
+ *
+ * @return pointer to allocated memory / NULL pointer if there is an error
+ */
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    void *p;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate 'count' objects of size 'size' */
+    p = rt_malloc(count * size);
+
+    /* zero the memory */
+    if (p)
+        rt_memset(p, 0, count * size);
+
+    return p;
+}
+RTM_EXPORT(rt_calloc);
+
+/**
+ * This function will release the previously allocated memory block by
+ * rt_malloc. The released memory block is taken back to system heap.
+ *
+ * @param rmem the address of memory which will be released
+ */
+void rt_free(void *rmem)
+{
+    struct tlsf_block *block;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (rmem == RT_NULL)
+        return;
+    RT_ASSERT((((rt_ubase_t)rmem) & (TLSF_ALIGN_SIZE-1)) == 0);
+    RT_ASSERT((rt_uint8_t *)rmem >= heap_ptr && (rt_uint8_t *)rmem < heap_end);
+
+    RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+
+    if ((rt_uint8_t *)rmem < heap_ptr || (rt_uint8_t *)rmem >= heap_end)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("illegal memory\n"));
+
+        return;
+    }
+
+    block = tlsf_block_from_ptr(rmem);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("release memory 0x%x, size: %d\n",
+                  (rt_uint32_t)rmem, (rt_uint32_t)tlsf_block_size(block)));
+
+    /* protect the heap from concurrent access */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    /* the block has to be in a used state */
+    RT_ASSERT(!(block->size & TLSF_BLOCK_FREE));
+
+#ifdef RT_MEM_STATS
+    used_mem -= tlsf_block_size(block) + TLSF_BLOCK_OVERHEAD;
+#endif
+
+    /* merge with the physical neighbors, then put it to the free list */
+    tlsf_block_mark_as_free(block);
+    block = tlsf_block_merge_prev(block);
+    block = tlsf_block_merge_next(block);
+    tlsf_block_insert(block);
+
+    rt_sem_release(&heap_sem);
+}
+RTM_EXPORT(rt_free);
+
+#ifdef RT_MEM_STATS
+void rt_memory_info(rt_uint32_t *total,
+                    rt_uint32_t *used,
+                    rt_uint32_t *max_used)
+{
+    if (total != RT_NULL)
+        *total = mem_size_aligned;
+    if (used  != RT_NULL)
+        *used = used_mem;
+    if (max_used != RT_NULL)
+        *max_used = max_mem;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+void list_mem(void)
+{
+    rt_kprintf("total memory: %d\n", mem_size_aligned);
+    rt_kprintf("used memory : %d\n", used_mem);
+    rt_kprintf("maximum allocated memory: %d\n", max_mem);
+}
+FINSH_FUNCTION_EXPORT(list_mem, list memory usage information)
+#endif
+#endif
+
+/**@}*/
+
+#endif /* end of RT_USING_HEAP */
+#endif /* end of RT_USING_MEMHEAP_AS_HEAP */
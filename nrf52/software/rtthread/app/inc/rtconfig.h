@@ -29,6 +29,27 @@
 #define RT_TIMER_THREAD_PRIO		4
 #define RT_TIMER_THREAD_STACK_SIZE	512
 #define RT_TIMER_TICK_PER_SECOND	1000
+/* Using hierarchical timing wheel, the timer start and stop are O(1) */
+#define RT_USING_TIMER_WHEEL
+/* The max hard timer timeout functions in one tick, the rest is invoked by the next tick */
+#define RT_TIMER_CHECK_BUDGET		32
+/* Using the statistics of the longest interrupt disabled window in timer */
+#define RT_USING_TIMER_IRQOFF_STAT
+
+/* Using tickless idle, the tick is stopped until the next timer timeout.
+ * It's off until the RTC wakeup is verified on nRF52, the simulator enables it in Makefile */
+// #define RT_USING_TICKLESS
+
+/* SECTION: interrupt */
+/* Using BASEPRI in kernel critical section, the interrupts of higher priority than
+ * RT_BASEPRI_THRESHOLD are never masked by kernel, and they can't call kernel.
+ * It's off until the Cortex-M4 port is verified on nRF52, the simulator enables it in Makefile */
+// #define RT_USING_BASEPRI
+/* the highest NVIC priority of the interrupts which call kernel, 1 ~ 7 on nRF52 */
+#define RT_BASEPRI_THRESHOLD		2
+/* Using the statistics of the longest interrupt masked window of each call site, it reads
+ * the cycle counter in every critical section (the thread CPU time in simulator is slow) */
+// #define RT_USING_IRQOFF_STAT
 
 /* SECTION: IPC */
 /* Using Semaphore*/
@@ -46,15 +67,31 @@
 /* Using Message Queue */
 #define RT_USING_MESSAGEQUEUE
 
+/* Using Reader/Writer Lock */
+#define RT_USING_RWLOCK
+
 /* SECTION: Memory Management */
 /* Using Memory Pool Management*/
 #define RT_USING_MEMPOOL
+/* Using lock-free block list, the block is allocated and freed without disabling interrupt.
+ * It's off until the LDREX/STREX path is verified on nRF52, the simulator enables it in Makefile */
+// #define RT_USING_MEMPOOL_LOCKFREE
 
 /* Using Dynamic Heap Management */
 #define RT_USING_HEAP
 
 /* Using Small MM */
 #define RT_USING_SMALL_MEM
+/* Using TLSF MM with O(1) malloc and free, it's instead of RT_USING_SMALL_MEM */
+// #define RT_USING_TLSF
+/* the log2 of TLSF max block size, the heap larger than it is truncated */
+// #define RT_TLSF_FL_INDEX_MAX 16
+/* Using object cache, the memory of deleted objects and thread stacks is reused without heap */
+#define RT_USING_OBJCACHE
+/* Using the name hash index of object container, rt_object_find, rt_device_find and rt_thread_find are O(1) */
+#define RT_USING_OBJECT_HASH
+/* the buckets of name hash index in each object class, it's power of 2 */
+#define RT_OBJECT_HASH_SIZE 16
 
 /* SECTION: Device System */
 /* Using Device System */
@@ -64,6 +101,12 @@
 // <bool name="RT_USING_SERIAL" description="Using Serial" default="true" />
 #define RT_USING_SERIAL
 #define RT_SERIAL_RB_BUFSZ 1024
+/* Using the DMA TX mode of uart0 in nRF52 uart driver, the DMA TX data is sent from the buffer of caller by EasyDMA.
+ * It's off until it's verified on nRF52, the uart_bench of simulator checks it with the UARTE model */
+// #define RT_USING_UART0_DMA_TX
+/* Using the DMA RX mode of uart0 in nRF52 uart driver, the shell receives by EasyDMA blocks.
+ * It's off until it's verified on nRF52, the simulator enables it in Makefile for the uart0 of simulator */
+// #define RT_USING_UART0_DMA_RX
 
 /* SECTION: Console options */
 #define RT_USING_CONSOLE
@@ -81,10 +124,20 @@
 #define FINSH_USING_MSH
 /* Using msh only */
 #define FINSH_USING_MSH_ONLY
+/* Using the sorted index of symbol table, the command is found and completed by binary search */
+#define FINSH_USING_SYMTAB_INDEX
+/* Using script mode, the CRC framed lines after 'script begin' are read in bulk and executed without echo */
+#define FINSH_USING_SCRIPT
 /* Using password authentication */
 //#define FINSH_USING_AUTH
 #define FINSH_DEFAULT_PASSWORD "61866139"
 
+/* SECTION: trace, record the kernel events by hooks.
+ * It's off until it's verified on nRF52 (the timestamp of DWT cycle counter), the simulator enables it in Makefile */
+// #define RT_USING_TRACE
+/* the events in trace ring buffer, it must be power of 2 */
+#define RT_TRACE_BUFFER_SIZE 256
+
 #define RT_USING_COMPONENTS_INIT
 
 #endif
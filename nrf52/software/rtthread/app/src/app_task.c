@@ -1,6 +1,7 @@
 #define LOG_TAG    "APP"
 
 #include <elog.h>
+#include <elog_flash.h>
 #include <rthw.h>
 #include <rtthread.h>
 #include <finsh.h>
@@ -49,6 +50,10 @@ static void rtt_user_assert_hook(const char* ex, const char* func, rt_size_t lin
     elog_output_lock_enabled(false);
     /* output rtt assert information */
     elog_a("rtt", "(%s) has assert failed at %s:%ld.\n", ex, func, line);
+#ifdef ELOG_FLASH_ENABLE
+    /* save the buffered log to flash */
+    elog_flash_flush();
+#endif
 
     while (_continue == 1);
 }
@@ -66,6 +71,10 @@ static rt_err_t exception_hook(void *context) {
 #endif
 
     cm_backtrace_fault(*((uint32_t *)(cmb_get_sp() + sizeof(uint32_t) * 8)), cmb_get_sp() + sizeof(uint32_t) * 9);
+#ifdef ELOG_FLASH_ENABLE
+    /* save the buffered log to flash */
+    elog_flash_flush();
+#endif
 
     while (_continue == 1);
 
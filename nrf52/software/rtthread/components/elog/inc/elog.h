@@ -68,6 +68,12 @@ extern "C" {
     #define ELOG_ASSERT(EXPR)                    ((void)0);
 #endif
 
+/**
+ * elog_x API
+ * NOTE: The tag should be a string literal or another immutable string, such as LOG_TAG. The log prefix is
+ *       cached by the tag address, the tag buffer which is reused with other contents isn't output with a
+ *       stale prefix, but every new content takes a new cache entry (ELOG_PREFIX_CACHE_NUM).
+ */
 #ifndef ELOG_OUTPUT_ENABLE
     #define elog_a(tag, ...)
     #define elog_e(tag, ...)
@@ -119,6 +125,46 @@ extern "C" {
     #endif /* ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE */
 #endif /* ELOG_OUTPUT_ENABLE */
 
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+    /* binary log's sync sign, it's not a printable character so the binary log can mix with text log */
+    #define ELOG_BIN_SYNC_SIGN               0xA5
+    /* binary log's escape sign, the newline and escape bytes after the sync sign are escaped as escape sign
+     * and the byte XOR 0x20, so the console which converts newline to CRLF outputs the binary log as it is */
+    #define ELOG_BIN_ESC_SIGN                0xDB
+    /* binary log's max arguments number */
+    #define ELOG_BIN_ARGS_MAX                8
+    /* count the binary log's arguments, the format string is not included */
+    #define ELOG_BIN_ARGS_NUM(...)           ELOG_BIN_ARGS_NUM_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+    #define ELOG_BIN_ARGS_NUM_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+    /* the binary log's argument is passed as 32-bit word, the floating point and the integer which is
+     * wider than 32-bit are rejected at compile time by the negative array size */
+    #define ELOG_BIN_ARG(x)                  ((uint32_t) (uintptr_t) (x) + 0 * sizeof(char[ \
+            (__builtin_classify_type(x) != 8 && (__builtin_classify_type(x) == 5 || sizeof(x) <= 4)) ? 1 : -1]))
+    #define ELOG_BIN_ARGS(...)               ELOG_BIN_ARGS_(ELOG_BIN_ARGS_NUM(__VA_ARGS__), ##__VA_ARGS__)
+    #define ELOG_BIN_ARGS_(n, ...)           ELOG_BIN_ARGS__(n, ##__VA_ARGS__)
+    #define ELOG_BIN_ARGS__(n, ...)          ELOG_BIN_ARGS_##n(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_0()
+    #define ELOG_BIN_ARGS_1(a)               , ELOG_BIN_ARG(a)
+    #define ELOG_BIN_ARGS_2(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_1(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_3(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_2(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_4(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_3(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_5(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_4(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_6(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_5(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_7(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_6(__VA_ARGS__)
+    #define ELOG_BIN_ARGS_8(a, ...)          , ELOG_BIN_ARG(a) ELOG_BIN_ARGS_7(__VA_ARGS__)
+    /**
+     * Output the binary log. Only the format string address, tag address, tick and arguments will be output.
+     * The log will be formatted by host decoder tool (tools/elog_bin_decode.py) with the ELF file.
+     * @note The arguments must be 32-bit word (integer, character, pointer), the others don't compile.
+     *       The string argument must be constant which is stored in flash.
+     */
+    #define elog_bin(level, tag, format, ...) \
+            elog_bin_output(level, tag, format, ELOG_BIN_ARGS_NUM(__VA_ARGS__) ELOG_BIN_ARGS(__VA_ARGS__))
+#else
+    #define elog_bin(level, tag, ...) \
+            elog_output(level, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+#endif /* ELOG_BIN_OUTPUT_ENABLE */
+
 /* all formats index */
 typedef enum {
     ELOG_FMT_LVL    = 1 << 0, /**< level */
@@ -138,10 +184,23 @@ typedef enum {
 /* output log's filter */
 typedef struct {
     uint8_t level;
+    /* the level which is checked on output, it's the max of global level and the tag levels which are set */
+    uint8_t output_level;
     char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
     char keyword[ELOG_FILTER_KW_MAX_LEN + 1];
+    /* the precompiled KMP partial match table for tag and keyword */
+    uint8_t tag_next[ELOG_FILTER_TAG_MAX_LEN];
+    uint8_t keyword_next[ELOG_FILTER_KW_MAX_LEN];
 } ElogFilter, *ElogFilter_t;
 
+/* output log's tag level filter, every source file which defines LOG_TAG has one */
+typedef struct {
+    const char *tag;
+    uint8_t level;
+    /* the level is set by elog_set_filter_tag_lvl, it's kept when the global level is changed */
+    bool level_is_set;
+} ElogTagLvl, *ElogTagLvl_t;
+
 /* easy logger */
 typedef struct {
     ElogFilter filter;
@@ -174,13 +233,16 @@ void elog_set_filter(uint8_t level, const char *tag, const char *keyword);
 void elog_set_filter_lvl(uint8_t level);
 void elog_set_filter_tag(const char *tag);
 void elog_set_filter_kw(const char *keyword);
+size_t elog_set_filter_tag_lvl(const char *tag, uint8_t level);
 void elog_raw(const char *format, ...);
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...);
+void elog_bin_output(uint8_t level, const char *tag, const char *format, size_t argc, ...);
 void elog_output_lock_enabled(bool enabled);
 extern void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
 void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_t line));
 int8_t elog_find_lvl(const char *log);
+size_t elog_get_dropped_line_num(void);
 const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len);
 
 #define elog_a(tag, ...)     elog_assert(tag, __VA_ARGS__)
@@ -200,36 +262,48 @@ const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len);
 #if !defined(LOG_LVL)
     #define LOG_LVL          ELOG_LVL_VERBOSE
 #endif
+/**
+ * The tag level filter of this source file. It's placed in ElogTagTab section, so the level can be
+ * changed by tag name at runtime (@see elog_set_filter_tag_lvl), and log_x API checks it by one load
+ * before the arguments are evaluated.
+ */
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    static ElogTagLvl elog_tag_lvl __attribute__((section("ElogTagTab"), used)) = { LOG_TAG, ELOG_LVL_VERBOSE, false };
+    #define ELOG_TAG_LVL_ENABLED(lvl)    ((lvl) <= elog_tag_lvl.level)
+#else
+    #define ELOG_TAG_LVL_ENABLED(lvl)    (true)
+#endif
 #if LOG_LVL >= ELOG_LVL_ASSERT
-    #define log_a(...)       elog_a(LOG_TAG, __VA_ARGS__)
+    #define log_a(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_ASSERT)) elog_a(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_a(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_ERROR
-    #define log_e(...)       elog_e(LOG_TAG, __VA_ARGS__)
+    #define log_e(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_ERROR)) elog_e(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_e(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_WARN
-    #define log_w(...)       elog_w(LOG_TAG, __VA_ARGS__)
+    #define log_w(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_WARN)) elog_w(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_w(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_INFO
-    #define log_i(...)       elog_i(LOG_TAG, __VA_ARGS__)
+    #define log_i(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_INFO)) elog_i(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_i(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_DEBUG
-    #define log_d(...)       elog_d(LOG_TAG, __VA_ARGS__)
+    #define log_d(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_DEBUG)) elog_d(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_d(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_VERBOSE
-    #define log_v(...)       elog_v(LOG_TAG, __VA_ARGS__)
+    #define log_v(...)       do { if (ELOG_TAG_LVL_ENABLED(ELOG_LVL_VERBOSE)) elog_v(LOG_TAG, __VA_ARGS__); } while (0)
 #else
     #define log_v(...)       ((void)0);
 #endif
+#define log_bin(level, ...)  do { if (ELOG_TAG_LVL_ENABLED(level)) elog_bin(level, LOG_TAG, __VA_ARGS__); } while (0)
 
 /* assert API short definition */
 #if !defined(assert)
@@ -244,6 +318,7 @@ void elog_flush(void);
 void elog_async_enabled(bool enabled);
 size_t elog_async_get_log(char *log, size_t size);
 size_t elog_async_get_line_log(char *log, size_t size);
+size_t elog_async_get_dropped_size(void);
 
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
@@ -37,15 +37,38 @@
 #define ELOG_ASSERT_ENABLE
 /* buffer size for every line's log */
 #define ELOG_LINE_BUF_SIZE                   1024
+/* number of line buffers in pool, the logging thread which gets a buffer in pool formats without output lock */
+#define ELOG_LINE_BUF_POOL_NUM               2
 /* output line number max length */
 #define ELOG_LINE_NUM_MAX_LEN                5
+/* log prefix (color, level and tag) cache number and every prefix's max length, a level and tag takes one */
+#define ELOG_PREFIX_CACHE_NUM                8
+#define ELOG_PREFIX_CACHE_LEN                32
 /* output filter's tag max length */
 #define ELOG_FILTER_TAG_MAX_LEN              16
 /* output filter's keyword max length */
 #define ELOG_FILTER_KW_MAX_LEN               16
+/* enable tag level filter for every LOG_TAG, the ElogTagTab section must be placed in linker script */
+#define ELOG_FILTER_TAG_LVL_ENABLE
 /* output newline sign */
 #define ELOG_NEWLINE_SIGN                    "\r\n"
 /* enable log color */
 #define ELOG_COLOR_ENABLE
+/* enable binary log output, the log will be formatted by host decoder tool */
+//#define ELOG_BIN_OUTPUT_ENABLE
+/* enable asynchronous output mode */
+#define ELOG_ASYNC_OUTPUT_ENABLE
+/* the highest output level for async mode, other level will sync output */
+#define ELOG_ASYNC_OUTPUT_LVL                ELOG_LVL_WARN
+/* buffer size for asynchronous output mode, it must be power of 2 */
+#define ELOG_ASYNC_OUTPUT_BUF_SIZE           (ELOG_LINE_BUF_SIZE * 4)
+/* output line by line in asynchronous output mode */
+//#define ELOG_ASYNC_LINE_OUTPUT
+/* using RT-Thread thread to output the asynchronous log */
+#define ELOG_ASYNC_OUTPUT_USING_RTTHREAD
+/* asynchronous output thread priority, stack size and the max log size of one output batch */
+#define ELOG_ASYNC_OUTPUT_RTTHREAD_PRIORITY  (RT_THREAD_PRIORITY_MAX - 2)
+#define ELOG_ASYNC_OUTPUT_RTTHREAD_STACK_SIZE 512
+#define ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE     256
 
 #endif /* _ELOG_CFG_H_ */
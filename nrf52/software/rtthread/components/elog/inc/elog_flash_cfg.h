@@ -0,0 +1,43 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, agent, <agent@local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: It is the configure head file for this flash log plugin.
+ * Created on: 2026-10-17
+ */
+
+#ifndef _ELOG_FLASH_CFG_H_
+#define _ELOG_FLASH_CFG_H_
+
+/* enable log output to flash, it's off until the flash port is verified on nRF52, the simulator enables it in Makefile */
+//#define ELOG_FLASH_ENABLE
+/* log area start address, it's the end of FLASH region which is reserved in gcc_nrf52.ld */
+#define ELOG_FLASH_START_ADDR                0x7C000
+/* log area size, it must be an integral multiple of sector size and has 2 sectors at least */
+#define ELOG_FLASH_AREA_SIZE                 (4 * ELOG_FLASH_SECTOR_SIZE)
+/* flash erase sector size, it's the page size on nRF52 */
+#define ELOG_FLASH_SECTOR_SIZE               4096
+/* buffer size for flash write, the log will be written to flash when this buffer is full */
+#define ELOG_FLASH_BUF_SIZE                  512
+
+#endif /* _ELOG_FLASH_CFG_H_ */
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, agent, <agent@local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Portable interface for EasyLogger's flash log plugin on nRF52 NVMC.
+ * Created on: 2026-10-17
+ */
+
+#include <elog_flash.h>
+#include <rtthread.h>
+#include <nrf.h>
+#include <string.h>
+
+#ifdef ELOG_FLASH_ENABLE
+
+static struct rt_mutex flash_lock;
+
+/**
+ * wait the NVMC ready
+ */
+static void nvmc_wait_ready(void) {
+    while (NRF_NVMC->READY == NVMC_READY_READY_Busy);
+}
+
+/**
+ * EasyLogger flash log plugin port initialize
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_init(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    rt_mutex_init(&flash_lock, "elog flash", RT_IPC_FLAG_PRIO);
+
+    return result;
+}
+
+/**
+ * read data from flash
+ * @note This operation's units is word.
+ *
+ * @param addr flash address
+ * @param buf buffer to store read data
+ * @param size read bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, uint32_t *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    memcpy(buf, (const void *) addr, size);
+
+    return result;
+}
+
+/**
+ * erase a flash sector (nRF52 page)
+ *
+ * @param addr sector start address
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Een << NVMC_CONFIG_WEN_Pos;
+    nvmc_wait_ready();
+    NRF_NVMC->ERASEPAGE = addr;
+    nvmc_wait_ready();
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren << NVMC_CONFIG_WEN_Pos;
+    nvmc_wait_ready();
+
+    return result;
+}
+
+/**
+ * write data to flash
+ * @note This operation's units is word.
+ * @note This operation must after erase. @see elog_flash_port_erase.
+ *
+ * @param addr flash address
+ * @param buf the write data buffer
+ * @param size write bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_write(uint32_t addr, const uint32_t *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    size_t i;
+
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Wen << NVMC_CONFIG_WEN_Pos;
+    nvmc_wait_ready();
+    for (i = 0; i < size; i += 4, buf++, addr += 4) {
+        *(volatile uint32_t *) addr = *buf;
+        nvmc_wait_ready();
+        /* check the written data */
+        if (*(volatile uint32_t *) addr != *buf) {
+            result = ELOG_FLASH_WRITE_ERR;
+            break;
+        }
+    }
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren << NVMC_CONFIG_WEN_Pos;
+    nvmc_wait_ready();
+
+    return result;
+}
+
+/**
+ * output flash saved log port interface
+ *
+ * @param log flash saved log
+ * @param size log size
+ */
+void elog_flash_port_output(const char *log, size_t size) {
+    /* output to RT-Thread terminal */
+    rt_kprintf("%.*s", size, log);
+}
+
+/**
+ * flash log lock
+ * @note The interrupt, assert or exception hook can't wait the mutex, so it will run without lock.
+ */
+void elog_flash_port_lock(void) {
+    if (rt_interrupt_get_nest() == 0 && rt_critical_level() == 0) {
+        rt_mutex_take(&flash_lock, RT_WAITING_FOREVER);
+    }
+}
+
+/**
+ * flash log unlock
+ */
+void elog_flash_port_unlock(void) {
+    if (rt_interrupt_get_nest() == 0 && rt_critical_level() == 0) {
+        rt_mutex_release(&flash_lock);
+    }
+}
+
+#endif /* ELOG_FLASH_ENABLE */
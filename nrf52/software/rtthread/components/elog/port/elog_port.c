@@ -27,6 +27,7 @@
  */
 
 #include "elog.h"
+#include <elog_flash.h>
 #include <stdio.h>
 #include <rtthread.h>
 #include <nrf.h>
@@ -45,33 +46,59 @@ ElogErrCode elog_port_init(void) {
 
     rt_mutex_init(&output_lock, "elog lock", RT_IPC_FLAG_PRIO);
 
+#ifdef ELOG_FLASH_ENABLE
+    /* initialize flash log plugin, the log will not be saved when it's failed */
+    elog_flash_init();
+#endif
+
     return result;
 }
 
 /**
  * output log port interface
+ * @note The log is written to console device by its open flag, which is shared with rt_kprintf, so
+ *       it's not changed here. The binary log record has NUL bytes but no newline byte, so it's output
+ *       as it is by the stream mode too.
  *
  * @param log output of log
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
+    rt_device_t console = rt_console_get_device();
+
     /* output to RT-Thread terminal */
-    rt_kprintf("%.*s", size, log);
-    //TODO output to flash
+    if (console != RT_NULL) {
+        rt_device_write(console, 0, log, size);
+    } else {
+        rt_kprintf("%.*s", size, log);
+    }
+#ifdef ELOG_FLASH_ENABLE
+    /* output to flash, the flash operation is too slow for interrupt */
+    if (rt_interrupt_get_nest() == 0) {
+        elog_flash_write(log, size);
+    }
+#endif
 }
 
 /**
  * output lock
+ * @note The interrupt can't wait the mutex, so it doesn't take this lock. The interrupt log uses
+ *       its own line buffer from the pool and reserves its space of the asynchronous ring buffer by
+ *       CAS, so it can be put in the middle of a thread log.
  */
 void elog_port_output_lock(void) {
-    rt_mutex_take(&output_lock, RT_WAITING_FOREVER);
+    if (rt_interrupt_get_nest() == 0) {
+        rt_mutex_take(&output_lock, RT_WAITING_FOREVER);
+    }
 }
 
 /**
  * output unlock
  */
 void elog_port_output_unlock(void) {
-    rt_mutex_release(&output_lock);
+    if (rt_interrupt_get_nest() == 0) {
+        rt_mutex_release(&output_lock);
+    }
 }
 
 /**
@@ -98,6 +125,24 @@ const char *elog_port_get_time(void) {
 #endif
 }
 
+/**
+ * get current tick interface, it's used on binary log
+ *
+ * @return current tick
+ */
+uint32_t elog_port_get_tick(void) {
+    return rt_tick_get();
+}
+
+/**
+ * get the interrupt context interface, the log in interrupt can't take the output lock
+ *
+ * @return true when it's in interrupt
+ */
+bool elog_port_is_in_isr(void) {
+    return rt_interrupt_get_nest() != 0;
+}
+
 /**
  * get current process name interface
  *
@@ -149,6 +194,19 @@ static void elog_lvl(uint8_t argc, char **argv) {
 MSH_CMD_EXPORT(elog_lvl, Set EasyLogger filter level);
 
 static void elog_tag(uint8_t argc, char **argv) {
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    if (argc > 2) {
+        /* set the level of the tag which is defined by LOG_TAG */
+        if ((atoi(argv[2]) <= ELOG_LVL_VERBOSE) && (atoi(argv[2]) >= 0)) {
+            if (!elog_set_filter_tag_lvl(argv[1], atoi(argv[2]))) {
+                rt_kprintf("The tag %s is not found.\n", argv[1]);
+            }
+        } else {
+            rt_kprintf("Please input correct level(0-5).\n");
+        }
+        return;
+    }
+#endif /* ELOG_FILTER_TAG_LVL_ENABLE */
     if (argc > 1) {
         if (rt_strlen(argv[1]) <= ELOG_FILTER_TAG_MAX_LEN) {
             elog_set_filter_tag(argv[1]);
@@ -159,7 +217,7 @@ static void elog_tag(uint8_t argc, char **argv) {
         elog_set_filter_tag("");
     }
 }
-MSH_CMD_EXPORT(elog_tag, Set EasyLogger filter tag);
+MSH_CMD_EXPORT(elog_tag, Set EasyLogger filter tag [tag] [level]);
 
 static void elog_kw(uint8_t argc, char **argv) {
     if (argc > 1) {
@@ -173,4 +231,23 @@ static void elog_kw(uint8_t argc, char **argv) {
     }
 }
 MSH_CMD_EXPORT(elog_kw, Set EasyLogger filter keyword);
+
+#ifdef ELOG_FLASH_ENABLE
+static void elog_flash(uint8_t argc, char **argv) {
+    if (argc > 1) {
+        if (!strcmp(argv[1], "read")) {
+            elog_flash_output_all();
+        } else if (!strcmp(argv[1], "flush")) {
+            elog_flash_flush();
+        } else if (!strcmp(argv[1], "clean")) {
+            elog_flash_clean();
+        } else {
+            rt_kprintf("Please input elog_flash read, flush or clean.\n");
+        }
+    } else {
+        rt_kprintf("The flash saved log size is %d bytes.\n", elog_flash_get_used_size());
+    }
+}
+MSH_CMD_EXPORT(elog_flash, EasyLogger flash saved log [read/flush/clean]);
+#endif /* ELOG_FLASH_ENABLE */
 #endif /* defined(RT_USING_FINSH) && defined(FINSH_USING_MSH) */
@@ -57,6 +57,18 @@
     #error "Please configure output newline sign (in elog_cfg.h)"
 #endif
 
+#if !defined(ELOG_LINE_BUF_POOL_NUM)
+    #define ELOG_LINE_BUF_POOL_NUM             0
+#endif
+
+#if !defined(ELOG_PREFIX_CACHE_NUM)
+    #define ELOG_PREFIX_CACHE_NUM              0
+#endif
+
+#if (ELOG_PREFIX_CACHE_NUM > 0) && !defined(ELOG_PREFIX_CACHE_LEN)
+    #error "Please configure the log prefix cache's max length (in elog_cfg.h)"
+#endif
+
 #ifdef ELOG_COLOR_ENABLE
 /**
  * CSI(Control Sequence Introducer/Initiator) sign
@@ -111,8 +123,33 @@
 
 /* EasyLogger object */
 static EasyLogger elog;
-/* every line log's buffer */
+/* every line log's buffer, it's shared by all threads and protected by output lock */
 static char log_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+#if ELOG_LINE_BUF_POOL_NUM > 0
+/* line log's buffer pool, the thread which gets a free buffer will format log without output lock */
+static char line_buf_pool[ELOG_LINE_BUF_POOL_NUM][ELOG_LINE_BUF_SIZE];
+/* line log's buffer pool used flag */
+static volatile uint8_t line_buf_pool_used[ELOG_LINE_BUF_POOL_NUM] = { 0 };
+#endif
+/* the number of line log which is dropped in interrupt when all buffers in pool are used */
+static volatile size_t dropped_line_num = 0;
+#if ELOG_PREFIX_CACHE_NUM > 0
+/* log prefix cache, the color, level and tag info is packaged once for every level and tag */
+typedef struct {
+    const char *tag;
+    uint8_t level;
+    /* the position and length of tag in prefix, the tag contents is checked on cache hit */
+    bool has_tag;
+    uint8_t tag_pos;
+    uint8_t tag_len;
+    volatile size_t len;
+    char prefix[ELOG_PREFIX_CACHE_LEN];
+} ElogPrefixCache;
+static ElogPrefixCache prefix_cache[ELOG_PREFIX_CACHE_NUM];
+/* log prefix cache used number */
+static volatile size_t prefix_cache_used_num = 0;
+static void prefix_cache_clean(void);
+#endif
 /* level output info */
 static const char *level_output_info[] = {
         [ELOG_LVL_ASSERT]  = "A/",
@@ -136,6 +173,15 @@ static const char *color_output_info[] = {
 #endif /* ELOG_COLOR_ENABLE */
 
 static bool get_fmt_enabled(uint8_t level, size_t set);
+static void filter_pattern_compile(const char *pattern, uint8_t *next);
+static bool filter_pattern_match(const char *text, const char *pattern, const uint8_t *next);
+static size_t package_prefix(uint8_t level, const char *tag, char *buf);
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+static void filter_tag_lvl_update(void);
+#endif
+static char *line_buf_take(void);
+static void line_buf_release(char *buf);
+static void line_buf_output(uint8_t level, char *buf, size_t size);
 
 /* EasyLogger assert hook */
 void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
@@ -221,6 +267,9 @@ void elog_set_output_enabled(bool enabled) {
  */
 void elog_set_text_color_enabled(bool enabled) {
     elog.text_color_enabled = enabled;
+#if ELOG_PREFIX_CACHE_NUM > 0
+    prefix_cache_clean();
+#endif
 }
 
 /**
@@ -252,6 +301,9 @@ void elog_set_fmt(uint8_t level, size_t set) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     elog.enabled_fmt_set[level] = set;
+#if ELOG_PREFIX_CACHE_NUM > 0
+    prefix_cache_clean();
+#endif
 }
 
 /**
@@ -271,6 +323,8 @@ void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
 
 /**
  * set log filter's level
+ * @note The tag level which is set by elog_set_filter_tag_lvl is kept, this level only applies to
+ *       the tags without an explicit level.
  *
  * @param level level
  */
@@ -278,6 +332,11 @@ void elog_set_filter_lvl(uint8_t level) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     elog.filter.level = level;
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    filter_tag_lvl_update();
+#else
+    elog.filter.output_level = level;
+#endif
 }
 
 /**
@@ -287,6 +346,7 @@ void elog_set_filter_lvl(uint8_t level) {
  */
 void elog_set_filter_tag(const char *tag) {
     strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    filter_pattern_compile(elog.filter.tag, elog.filter.tag_next);
 }
 
 /**
@@ -296,6 +356,114 @@ void elog_set_filter_tag(const char *tag) {
  */
 void elog_set_filter_kw(const char *keyword) {
     strncpy(elog.filter.keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
+    filter_pattern_compile(elog.filter.keyword, elog.filter.keyword_next);
+}
+
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+/* the tag level filter section is defined in linker script */
+extern ElogTagLvl __elog_tag_start[], __elog_tag_end[];
+
+/**
+ * set the level filter of the tag which is defined by LOG_TAG
+ * @note The tag level is kept when the global level is changed by elog_set_filter_lvl. The log which
+ *       is output by elog_x API with other tag is filtered by the max of global level and tag levels.
+ *
+ * @param tag tag, NULL: all tags, their levels are reset to follow the global level, it's set to level
+ * @param level level
+ *
+ * @return the number of source file which is using this tag
+ */
+size_t elog_set_filter_tag_lvl(const char *tag, uint8_t level) {
+    ElogTagLvl_t tag_lvl;
+    size_t num = 0;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    if (!tag) {
+        elog.filter.level = level;
+    }
+    for (tag_lvl = __elog_tag_start; tag_lvl < __elog_tag_end; tag_lvl++) {
+        if (!tag || !strcmp(tag_lvl->tag, tag)) {
+            tag_lvl->level = level;
+            tag_lvl->level_is_set = (tag != NULL);
+            num++;
+        }
+    }
+    filter_tag_lvl_update();
+
+    return num;
+}
+
+/**
+ * The tags without an explicit level follow the global level, then update the output level filter.
+ */
+static void filter_tag_lvl_update(void) {
+    ElogTagLvl_t tag_lvl;
+    uint8_t output_level = elog.filter.level;
+
+    for (tag_lvl = __elog_tag_start; tag_lvl < __elog_tag_end; tag_lvl++) {
+        if (!tag_lvl->level_is_set) {
+            tag_lvl->level = elog.filter.level;
+        } else if (tag_lvl->level > output_level) {
+            output_level = tag_lvl->level;
+        }
+    }
+    elog.filter.output_level = output_level;
+}
+#endif /* ELOG_FILTER_TAG_LVL_ENABLE */
+
+/**
+ * compile the filter pattern to KMP partial match table
+ *
+ * @param pattern tag or keyword
+ * @param next partial match table
+ */
+static void filter_pattern_compile(const char *pattern, uint8_t *next) {
+    size_t i, k = 0;
+
+    if (!pattern[0]) {
+        return;
+    }
+    next[0] = 0;
+    for (i = 1; pattern[i]; i++) {
+        while (k > 0 && pattern[i] != pattern[k]) {
+            k = next[k - 1];
+        }
+        if (pattern[i] == pattern[k]) {
+            k++;
+        }
+        next[i] = k;
+    }
+}
+
+/**
+ * find the filter pattern in the text by precompiled KMP partial match table
+ *
+ * @param text text
+ * @param pattern tag or keyword, the empty pattern matches all text
+ * @param next partial match table
+ *
+ * @return true: found
+ */
+static bool filter_pattern_match(const char *text, const char *pattern, const uint8_t *next) {
+    size_t k = 0;
+
+    if (!pattern[0]) {
+        return true;
+    }
+    for (; *text; text++) {
+        while (k > 0 && *text != pattern[k]) {
+            k = next[k - 1];
+        }
+        if (*text == pattern[k]) {
+            k++;
+        }
+        if (!pattern[k]) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 /**
@@ -315,8 +483,8 @@ void elog_output_lock(void) {
  */
 void elog_output_unlock(void) {
     if (elog.output_lock_enabled) {
-        elog_port_output_unlock();
         elog.output_is_locked_before_disable = false;
+        elog_port_output_unlock();
     } else {
         elog.output_is_locked_before_enable = false;
     }
@@ -332,6 +500,7 @@ void elog_raw(const char *format, ...) {
     va_list args;
     size_t log_len = 0;
     int fmt_result;
+    char *line_buf;
 
     /* check output enabled */
     if (!elog.output_enabled) {
@@ -341,11 +510,15 @@ void elog_raw(const char *format, ...) {
     /* args point to the first variable parameter */
     va_start(args, format);
 
-    /* lock output */
-    elog_output_lock();
+    /* take a line buffer, it will lock output when the buffer is shared */
+    line_buf = line_buf_take();
+    if (!line_buf) {
+        va_end(args);
+        return;
+    }
 
     /* package log data to buffer */
-    fmt_result = vsnprintf(log_buf, ELOG_LINE_BUF_SIZE, format, args);
+    fmt_result = vsnprintf(line_buf, ELOG_LINE_BUF_SIZE, format, args);
 
     /* output converted log */
     if ((fmt_result > -1) && (fmt_result <= ELOG_LINE_BUF_SIZE)) {
@@ -353,18 +526,8 @@ void elog_raw(const char *format, ...) {
     } else {
         log_len = ELOG_LINE_BUF_SIZE;
     }
-    /* output log */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(const char *log, size_t size);
-    elog_async_output(log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
-#else
-    elog_port_output(log_buf, log_len);
-#endif
-    /* unlock output */
-    elog_port_output_unlock();
+    /* output log and release the line buffer */
+    line_buf_output(ELOG_LVL_VERBOSE, line_buf, log_len);
 
     va_end(args);
 }
@@ -387,11 +550,11 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     extern const char *elog_port_get_p_info(void);
     extern const char *elog_port_get_t_info(void);
 
-    size_t tag_len = strlen(tag), log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
+    size_t log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
     char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
-    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
     va_list args;
     int fmt_result;
+    char *line_buf;
 
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
@@ -399,131 +562,385 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     if (!elog.output_enabled) {
         return;
     }
-    /* level filter */
-    if (level > elog.filter.level) {
+    /* level filter, the log of LOG_TAG has been filtered by its tag level */
+    if (level > elog.filter.output_level) {
         return;
-    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
-        //TODO ԿǲKMPģʽƥַ
+    } else if (!filter_pattern_match(tag, elog.filter.tag, elog.filter.tag_next)) { /* tag filter */
         return;
     }
     /* args point to the first variable parameter */
     va_start(args, format);
-    /* lock output */
-    elog_output_lock();
-
-#ifdef ELOG_COLOR_ENABLE
-    /* add CSI start sign and color info */
-    if (elog.text_color_enabled) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, CSI_START);
-        log_len += elog_strcpy(log_len, log_buf + log_len, color_output_info[level]);
+    /* take a line buffer, it will lock output when the buffer is shared */
+    line_buf = line_buf_take();
+    if (!line_buf) {
+        va_end(args);
+        return;
     }
-#endif
 
-    /* package level info */
-    if (get_fmt_enabled(level, ELOG_FMT_LVL)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, level_output_info[level]);
-    }
-    /* package tag info */
-    if (get_fmt_enabled(level, ELOG_FMT_TAG)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, tag);
-        /* if the tag length is less than 50% ELOG_FILTER_TAG_MAX_LEN, then fill space */
-        if (tag_len <= ELOG_FILTER_TAG_MAX_LEN / 2) {
-            memset(tag_sapce, ' ', ELOG_FILTER_TAG_MAX_LEN / 2 - tag_len);
-            log_len += elog_strcpy(log_len, log_buf + log_len, tag_sapce);
-        }
-        log_len += elog_strcpy(log_len, log_buf + log_len, " ");
-    }
+    /* package color, level and tag info */
+    log_len += package_prefix(level, tag, line_buf);
+
     /* package time, process and thread info */
     if (get_fmt_enabled(level, ELOG_FMT_TIME | ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "[");
+        log_len += elog_strcpy(log_len, line_buf + log_len, "[");
         /* package time info */
         if (get_fmt_enabled(level, ELOG_FMT_TIME)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_time());
+            /* the port time interface maybe uses a static buffer, so copy it under output lock */
+            if (line_buf != log_buf) {
+                elog_output_lock();
+            }
+            log_len += elog_strcpy(log_len, line_buf + log_len, elog_port_get_time());
+            if (line_buf != log_buf) {
+                elog_output_unlock();
+            }
             if (get_fmt_enabled(level, ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, line_buf + log_len, " ");
             }
         }
         /* package process info */
         if (get_fmt_enabled(level, ELOG_FMT_P_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_p_info());
+            log_len += elog_strcpy(log_len, line_buf + log_len, elog_port_get_p_info());
             if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, line_buf + log_len, " ");
             }
         }
         /* package thread info */
         if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_t_info());
+            log_len += elog_strcpy(log_len, line_buf + log_len, elog_port_get_t_info());
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, "] ");
+        log_len += elog_strcpy(log_len, line_buf + log_len, "] ");
     }
     /* package file directory and name, function name and line number info */
     if (get_fmt_enabled(level, ELOG_FMT_DIR | ELOG_FMT_FUNC | ELOG_FMT_LINE)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "(");
+        log_len += elog_strcpy(log_len, line_buf + log_len, "(");
         /* package time info */
         if (get_fmt_enabled(level, ELOG_FMT_DIR)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, file);
+            log_len += elog_strcpy(log_len, line_buf + log_len, file);
             if (get_fmt_enabled(level, ELOG_FMT_FUNC)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, line_buf + log_len, " ");
             } else if (get_fmt_enabled(level, ELOG_FMT_LINE)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, ":");
+                log_len += elog_strcpy(log_len, line_buf + log_len, ":");
             }
         }
         /* package process info */
         if (get_fmt_enabled(level, ELOG_FMT_FUNC)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, func);
+            log_len += elog_strcpy(log_len, line_buf + log_len, func);
             if (get_fmt_enabled(level, ELOG_FMT_LINE)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, ":");
+                log_len += elog_strcpy(log_len, line_buf + log_len, ":");
             }
         }
         /* package thread info */
         if (get_fmt_enabled(level, ELOG_FMT_LINE)) {
             //TODO snprintfԴռÿܽϸߣŻ
             snprintf(line_num, ELOG_LINE_NUM_MAX_LEN, "%ld", line);
-            log_len += elog_strcpy(log_len, log_buf + log_len, line_num);
+            log_len += elog_strcpy(log_len, line_buf + log_len, line_num);
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, ")");
+        log_len += elog_strcpy(log_len, line_buf + log_len, ")");
     }
     /* package other log data to buffer. '\0' must be added in the end by vsnprintf. */
-    fmt_result = vsnprintf(log_buf + log_len, ELOG_LINE_BUF_SIZE - log_len - newline_len + 1, format, args);
+    fmt_result = vsnprintf(line_buf + log_len, ELOG_LINE_BUF_SIZE - log_len - newline_len + 1, format, args);
 
     va_end(args);
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI end sign */
     if (elog.text_color_enabled) {
-        log_len += elog_strcpy(log_len, log_buf + log_len + fmt_result, CSI_END);
+        log_len += elog_strcpy(log_len, line_buf + log_len + fmt_result, CSI_END);
+        /* the CSI end sign is copied over the '\0' of vsnprintf, the line buffer has the last line behind it */
+        if ((fmt_result > -1) && (fmt_result + log_len + newline_len <= ELOG_LINE_BUF_SIZE)) {
+            line_buf[log_len + fmt_result] = '\0';
+        }
     }
 #endif
 
     /* keyword filter */
-    if (!strstr(log_buf, elog.filter.keyword)) {
-        //TODO ԿǲKMPģʽƥַ
-        /* unlock output */
-        elog_output_unlock();
+    if (!filter_pattern_match(line_buf, elog.filter.keyword, elog.filter.keyword_next)) {
+        /* release the line buffer */
+        line_buf_release(line_buf);
         return;
     }
     /* package newline sign */
     if ((fmt_result > -1) && (fmt_result + log_len + newline_len <= ELOG_LINE_BUF_SIZE)) {
         log_len += fmt_result;
-        log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
+        log_len += elog_strcpy(log_len, line_buf + log_len, ELOG_NEWLINE_SIGN);
     } else {
         log_len = ELOG_LINE_BUF_SIZE;
         /* copy newline sign */
-        strcpy(log_buf + ELOG_LINE_BUF_SIZE - newline_len, ELOG_NEWLINE_SIGN);
+        strcpy(line_buf + ELOG_LINE_BUF_SIZE - newline_len, ELOG_NEWLINE_SIGN);
+    }
+    /* output log and release the line buffer */
+    line_buf_output(level, line_buf, log_len);
+}
+
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+/**
+ * output the binary log
+ * @note The log line isn't formatted on the caller, it's only packaged to a compact record:
+ *       sync sign(1) + level and arguments number(1) + tick(4) + tag address(4) + format address(4)
+ *       + arguments(4 * argc). The newline and escape bytes after the sync sign are escaped by
+ *       ELOG_BIN_ESC_SIGN, so the record can be output by the console which converts newline to
+ *       CRLF. The host decoder tool will format it by the ELF file.
+ *
+ * @param level level
+ * @param tag tag
+ * @param format output format
+ * @param argc arguments number, the max number is ELOG_BIN_ARGS_MAX
+ * @param ... args, every argument is a 32-bit word which is converted by elog_bin
+ */
+void elog_bin_output(uint8_t level, const char *tag, const char *format, size_t argc, ...) {
+    extern uint32_t elog_port_get_tick(void);
+
+    uint8_t raw[1 + 3 * sizeof(uint32_t) + ELOG_BIN_ARGS_MAX * sizeof(uint32_t)];
+    /* every byte after the sync sign may be escaped to 2 bytes */
+    uint8_t record[1 + 2 * sizeof(raw)];
+    size_t raw_len = 0, record_len = 0, i;
+    uint32_t word;
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(argc <= ELOG_BIN_ARGS_MAX);
+
+    /* check output enabled */
+    if (!elog.output_enabled) {
+        return;
+    }
+    /* level filter, the log of LOG_TAG has been filtered by its tag level */
+    if (level > elog.filter.output_level) {
+        return;
+    } else if (!filter_pattern_match(tag, elog.filter.tag, elog.filter.tag_next)) { /* tag filter */
+        return;
     }
+    /* package the record header */
+    raw[raw_len++] = (level << 4) | argc;
+    word = elog_port_get_tick();
+    memcpy(raw + raw_len, &word, sizeof(uint32_t));
+    raw_len += sizeof(uint32_t);
+    word = (uint32_t) (uintptr_t) tag;
+    memcpy(raw + raw_len, &word, sizeof(uint32_t));
+    raw_len += sizeof(uint32_t);
+    word = (uint32_t) (uintptr_t) format;
+    memcpy(raw + raw_len, &word, sizeof(uint32_t));
+    raw_len += sizeof(uint32_t);
+    /* package the raw arguments */
+    va_start(args, argc);
+    for (i = 0; i < argc; i++) {
+        word = va_arg(args, uint32_t);
+        memcpy(raw + raw_len, &word, sizeof(uint32_t));
+        raw_len += sizeof(uint32_t);
+    }
+    va_end(args);
+    /* escape the record */
+    record[record_len++] = ELOG_BIN_SYNC_SIGN;
+    for (i = 0; i < raw_len; i++) {
+        if (raw[i] == '\n' || raw[i] == ELOG_BIN_ESC_SIGN) {
+            record[record_len++] = ELOG_BIN_ESC_SIGN;
+            record[record_len++] = raw[i] ^ 0x20;
+        } else {
+            record[record_len++] = raw[i];
+        }
+    }
+
+    /* lock output */
+    elog_output_lock();
     /* output log */
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(const char *log, size_t size);
-    elog_async_output(log_buf, log_len);
+    extern void elog_async_output(uint8_t level, const char *log, size_t size);
+    elog_async_output(level, (const char *) record, record_len);
 #elif defined(ELOG_BUF_OUTPUT_ENABLE)
     extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
+    elog_buf_output((const char *) record, record_len);
 #else
-    elog_port_output(log_buf, log_len);
+    elog_port_output((const char *) record, record_len);
 #endif
     /* unlock output */
     elog_output_unlock();
 }
+#endif /* ELOG_BIN_OUTPUT_ENABLE */
+
+/**
+ * package the log prefix: color, level and tag info
+ * @note The prefix will be cached by level and tag address when ELOG_PREFIX_CACHE_NUM > 0, so the tag
+ *       should be a constant string, such as LOG_TAG. The tag in cached prefix is compared with the tag
+ *       contents on cache hit, so the tag buffer which is reused with other contents gets a new prefix.
+ *
+ * @param level level
+ * @param tag tag
+ * @param buf line buffer
+ *
+ * @return prefix length
+ */
+static size_t package_prefix(uint8_t level, const char *tag, char *buf) {
+    size_t tag_len, log_len = 0;
+    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
+
+#if ELOG_PREFIX_CACHE_NUM > 0
+    size_t i, cached_len, cached_num = prefix_cache_used_num, tag_pos = 0;
+    bool has_tag = false;
+
+    /* find the prefix in cache */
+    for (i = 0; i < cached_num; i++) {
+        cached_len = prefix_cache[i].len;
+        if (cached_len && prefix_cache[i].tag == tag && prefix_cache[i].level == level
+                && (!prefix_cache[i].has_tag
+                        || (!strncmp(prefix_cache[i].prefix + prefix_cache[i].tag_pos, tag, prefix_cache[i].tag_len)
+                                && tag[prefix_cache[i].tag_len] == '\0'))) {
+            memcpy(buf, prefix_cache[i].prefix, cached_len);
+            return cached_len;
+        }
+    }
+#endif /* ELOG_PREFIX_CACHE_NUM > 0 */
+
+    tag_len = strlen(tag);
+
+#ifdef ELOG_COLOR_ENABLE
+    /* add CSI start sign and color info */
+    if (elog.text_color_enabled) {
+        log_len += elog_strcpy(log_len, buf + log_len, CSI_START);
+        log_len += elog_strcpy(log_len, buf + log_len, color_output_info[level]);
+    }
+#endif
+
+    /* package level info */
+    if (get_fmt_enabled(level, ELOG_FMT_LVL)) {
+        log_len += elog_strcpy(log_len, buf + log_len, level_output_info[level]);
+    }
+    /* package tag info */
+    if (get_fmt_enabled(level, ELOG_FMT_TAG)) {
+#if ELOG_PREFIX_CACHE_NUM > 0
+        has_tag = true;
+        tag_pos = log_len;
+#endif
+        log_len += elog_strcpy(log_len, buf + log_len, tag);
+        /* if the tag length is less than 50% ELOG_FILTER_TAG_MAX_LEN, then fill space */
+        if (tag_len <= ELOG_FILTER_TAG_MAX_LEN / 2) {
+            memset(tag_sapce, ' ', ELOG_FILTER_TAG_MAX_LEN / 2 - tag_len);
+            log_len += elog_strcpy(log_len, buf + log_len, tag_sapce);
+        }
+        log_len += elog_strcpy(log_len, buf + log_len, " ");
+    }
+
+#if ELOG_PREFIX_CACHE_NUM > 0
+    /* take an entry by CAS, so the used number never goes beyond the cache size with concurrent loggers */
+    i = ELOG_PREFIX_CACHE_NUM;
+    if (log_len <= ELOG_PREFIX_CACHE_LEN) {
+        do {
+            i = prefix_cache_used_num;
+        } while (i < ELOG_PREFIX_CACHE_NUM && !__sync_bool_compare_and_swap(&prefix_cache_used_num, i, i + 1));
+    }
+    /* put the prefix to cache, the cache entry is published after the prefix is copied */
+    if (i < ELOG_PREFIX_CACHE_NUM) {
+        memcpy(prefix_cache[i].prefix, buf, log_len);
+        prefix_cache[i].tag = tag;
+        prefix_cache[i].level = level;
+        prefix_cache[i].has_tag = has_tag;
+        prefix_cache[i].tag_pos = tag_pos;
+        prefix_cache[i].tag_len = tag_len;
+        __sync_synchronize();
+        prefix_cache[i].len = log_len;
+    }
+#endif /* ELOG_PREFIX_CACHE_NUM > 0 */
+
+    return log_len;
+}
+
+#if ELOG_PREFIX_CACHE_NUM > 0
+/**
+ * clean the prefix cache, it should be called when the prefix format is changed
+ */
+static void prefix_cache_clean(void) {
+    size_t i;
+
+    for (i = 0; i < ELOG_PREFIX_CACHE_NUM; i++) {
+        prefix_cache[i].len = 0;
+    }
+    __sync_synchronize();
+    prefix_cache_used_num = 0;
+}
+#endif /* ELOG_PREFIX_CACHE_NUM > 0 */
+
+/**
+ * take a line buffer for formatting log
+ * @note It will lock output and return the shared buffer when all buffers in pool are used.
+ *       The interrupt can't take the output lock, so the log in interrupt is dropped then.
+ *
+ * @return line buffer, NULL when the log is dropped
+ */
+static char *line_buf_take(void) {
+    extern bool elog_port_is_in_isr(void);
+
+#if ELOG_LINE_BUF_POOL_NUM > 0
+    size_t i;
+
+    for (i = 0; i < ELOG_LINE_BUF_POOL_NUM; i++) {
+        if (!__sync_lock_test_and_set(&line_buf_pool_used[i], 1)) {
+            return line_buf_pool[i];
+        }
+    }
+#endif
+    /* the shared buffer may be in formatting by the interrupted thread */
+    if (elog_port_is_in_isr()) {
+        __sync_fetch_and_add(&dropped_line_num, 1);
+        return NULL;
+    }
+    /* all buffers in pool are used, so format log on the shared buffer */
+    elog_output_lock();
+    return log_buf;
+}
+
+/**
+ * get the number of line log which is dropped in interrupt when all line buffers are used
+ *
+ * @return dropped line log number
+ */
+size_t elog_get_dropped_line_num(void) {
+    return dropped_line_num;
+}
+
+/**
+ * release the line buffer which is taken by line_buf_take
+ *
+ * @param buf line buffer
+ */
+static void line_buf_release(char *buf) {
+    if (buf == log_buf) {
+        elog_output_unlock();
+    }
+#if ELOG_LINE_BUF_POOL_NUM > 0
+    else {
+        __sync_lock_release(&line_buf_pool_used[(buf - line_buf_pool[0]) / ELOG_LINE_BUF_SIZE]);
+    }
+#endif
+}
+
+/**
+ * output the formatted line log and release the line buffer.
+ * The output lock only covers the log hand-off to output stage when the buffer is from pool.
+ *
+ * @param level level
+ * @param buf line buffer
+ * @param size log size
+ */
+static void line_buf_output(uint8_t level, char *buf, size_t size) {
+    /* lock output, the shared buffer is locked when it's taken */
+    if (buf != log_buf) {
+        elog_output_lock();
+    }
+    /* output log */
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern void elog_async_output(uint8_t level, const char *log, size_t size);
+    elog_async_output(level, buf, size);
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+    extern void elog_buf_output(const char *log, size_t size);
+    elog_buf_output(buf, size);
+#else
+    elog_port_output(buf, size);
+#endif
+    /* unlock output, the shared buffer will be unlocked when it's released */
+    if (buf != log_buf) {
+        elog_output_unlock();
+    }
+    line_buf_release(buf);
+}
 
 /**
  * get format enabled
@@ -34,6 +34,15 @@
     #error "Please configure buffer size for asynchronous output mode (in elog_cfg.h)"
 #endif
 
+#if !defined(ELOG_ASYNC_OUTPUT_LVL)
+    #error "Please configure the highest output level for asynchronous output mode (in elog_cfg.h)"
+#endif
+
+/* output thread poll get log buffer size, it's the max size of log which output in one batch */
+#ifndef ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE
+#define ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE         (ELOG_LINE_BUF_SIZE - 4)
+#endif
+
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
 #include <pthread.h>
 #include <sched.h>
@@ -45,21 +54,52 @@
 #else
 #define ELOG_ASYNC_OUTPUT_PTHREAD_STACK_SIZE     (1*1024)
 #endif
+#endif
 /* thread default priority */
 #ifndef ELOG_ASYNC_OUTPUT_PTHREAD_PRIORITY
 #define ELOG_ASYNC_OUTPUT_PTHREAD_PRIORITY       (sched_get_priority_max(SCHED_RR) - 1)
 #endif
-/* output thread poll get log buffer size  */
-#ifndef ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE
-#define ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE         (ELOG_LINE_BUF_SIZE - 4)
-#endif
-#endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
 
 /* asynchronous output log notice */
 static sem_t output_notice;
 /* asynchronous output pthread thread */
 static pthread_t async_output_thread;
+#endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
+
+#ifdef ELOG_ASYNC_OUTPUT_USING_RTTHREAD
+#include <rtthread.h>
+/* thread default stack size */
+#ifndef ELOG_ASYNC_OUTPUT_RTTHREAD_STACK_SIZE
+#define ELOG_ASYNC_OUTPUT_RTTHREAD_STACK_SIZE    512
+#endif
+/* thread default priority */
+#ifndef ELOG_ASYNC_OUTPUT_RTTHREAD_PRIORITY
+#define ELOG_ASYNC_OUTPUT_RTTHREAD_PRIORITY      (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+/* thread default time slice */
+#ifndef ELOG_ASYNC_OUTPUT_RTTHREAD_TICK
+#define ELOG_ASYNC_OUTPUT_RTTHREAD_TICK          10
 #endif
+/* asynchronous output log notice event flag */
+#define ASYNC_OUTPUT_NOTICE_FLAG                 (1 << 0)
+
+/* asynchronous output log notice, the event won't overflow like semaphore when a lot of logs is put */
+static struct rt_event output_notice;
+/* asynchronous output RT-Thread thread */
+static struct rt_thread async_output_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t async_output_thread_stack[ELOG_ASYNC_OUTPUT_RTTHREAD_STACK_SIZE];
+#endif /* ELOG_ASYNC_OUTPUT_USING_RTTHREAD */
+
+/* the ring buffer indexes are masked, so the buffer size must be power of 2 */
+#if (ELOG_ASYNC_OUTPUT_BUF_SIZE & (ELOG_ASYNC_OUTPUT_BUF_SIZE - 1)) != 0
+    #error "The asynchronous output buffer size must be power of 2 (in elog_cfg.h)"
+#endif
+
+/* ring buffer index mask */
+#define ASYNC_BUF_MASK                           (ELOG_ASYNC_OUTPUT_BUF_SIZE - 1)
+/* make sure the ring buffer data is visible before the index is published */
+#define ASYNC_MEMORY_BARRIER()                   __sync_synchronize()
 
 /* Initialize OK flag */
 static bool init_ok = false;
@@ -67,49 +107,45 @@ static bool init_ok = false;
 static bool is_enabled = false;
 /* asynchronous output mode's ring buffer */
 static char log_buf[ELOG_ASYNC_OUTPUT_BUF_SIZE] = { 0 };
-/* log ring buffer write index */
-static size_t write_index = 0;
-/* log ring buffer read index */
-static size_t read_index = 0;
-/* log ring buffer full flag */
-static bool buf_is_full = false;
-/* log ring buffer empty flag */
-static bool buf_is_empty = true;
+/* log ring buffer reserve index, the producer reserves the space for log by CAS on it */
+static volatile size_t reserve_index = 0;
+/* log ring buffer write index, the reserved log before it is copied and published to consumer */
+static volatile size_t write_index = 0;
+/* the number of producers which are copying log to the reserved space */
+static volatile size_t putting_num = 0;
+/* log ring buffer read index, it only increased by the consumer (log get side) */
+static volatile size_t read_index = 0;
+/* the total size of dropped log when the ring buffer has no space */
+static volatile size_t dropped_size = 0;
 
 extern void elog_port_output(const char *log, size_t size);
-extern void elog_output_lock(void);
-extern void elog_output_unlock(void);
 
 /**
  * asynchronous output ring buffer used size
+ * @note The indexes are monotonic counters, so the unsigned subtraction is right after overflow.
  *
  * @return used size
  */
 static size_t elog_async_get_buf_used(void) {
-    if (write_index > read_index) {
-        return write_index - read_index;
-    } else {
-        if (!buf_is_full && !buf_is_empty) {
-            return ELOG_ASYNC_OUTPUT_BUF_SIZE - (read_index - write_index);
-        } else if (buf_is_full) {
-            return ELOG_ASYNC_OUTPUT_BUF_SIZE;
-        } else {
-            return 0;
-        }
-    }
+    return write_index - read_index;
 }
 
 /**
- * asynchronous output ring buffer remain space
+ * asynchronous output ring buffer remain space for producer, the reserved space is used
  *
  * @return remain space
  */
 static size_t async_get_buf_space(void) {
-    return ELOG_ASYNC_OUTPUT_BUF_SIZE - elog_async_get_buf_used();
+    return ELOG_ASYNC_OUTPUT_BUF_SIZE - (reserve_index - read_index);
 }
 
 /**
  * put log to asynchronous output ring buffer
+ * @note The space is reserved by CAS and the log is copied without any lock, so the interrupt is
+ *       never disabled here. The thread callers are serialized by output lock, but the interrupt
+ *       doesn't take it, so an interrupt log can be put in the middle of a thread put. The reserved
+ *       log is published by the last producer which finishes copying, the nested producers have
+ *       finished before it, so the consumer never reads a reserved log which is still copying.
  *
  * @param log put log buffer
  * @param size log size
@@ -117,41 +153,51 @@ static size_t async_get_buf_space(void) {
  * @return put log size, the log which beyond ring buffer space will be dropped
  */
 static size_t async_put_log(const char *log, size_t size) {
-    size_t space = 0;
-
-    space = async_get_buf_space();
-    /* no space */
-    if (!space) {
-        size = 0;
-        goto __exit;
-    }
+    size_t space = 0, put_size = 0, reserve, write_pos, publish, written;
+
+    __sync_add_and_fetch(&putting_num, 1);
+    /* reserve the space, it's retried when a nested producer reserved first */
+    do {
+        reserve = reserve_index;
+        space = async_get_buf_space();
+        put_size = size < space ? size : space;
+    } while (put_size && !__sync_bool_compare_and_swap(&reserve_index, reserve, reserve + put_size));
     /* drop some log */
-    if (space <= size) {
-        size = space;
-        buf_is_full = true;
+    if (put_size < size) {
+        __sync_fetch_and_add(&dropped_size, size - put_size);
     }
 
-    if (write_index + size < ELOG_ASYNC_OUTPUT_BUF_SIZE) {
-        memcpy(log_buf + write_index, log, size);
-        write_index += size;
-    } else {
-        memcpy(log_buf + write_index, log, ELOG_ASYNC_OUTPUT_BUF_SIZE - write_index);
-        memcpy(log_buf, log + ELOG_ASYNC_OUTPUT_BUF_SIZE - write_index,
-                size - (ELOG_ASYNC_OUTPUT_BUF_SIZE - write_index));
-        write_index += size - ELOG_ASYNC_OUTPUT_BUF_SIZE;
+    if (put_size) {
+        write_pos = reserve & ASYNC_BUF_MASK;
+        if (write_pos + put_size <= ELOG_ASYNC_OUTPUT_BUF_SIZE) {
+            memcpy(log_buf + write_pos, log, put_size);
+        } else {
+            memcpy(log_buf + write_pos, log, ELOG_ASYNC_OUTPUT_BUF_SIZE - write_pos);
+            memcpy(log_buf, log + ELOG_ASYNC_OUTPUT_BUF_SIZE - write_pos,
+                    put_size - (ELOG_ASYNC_OUTPUT_BUF_SIZE - write_pos));
+        }
     }
 
-    buf_is_empty = false;
-
-__exit:
+    /* the log must be copied before it is published */
+    ASYNC_MEMORY_BARRIER();
+    if (__sync_sub_and_fetch(&putting_num, 1) == 0) {
+        /* publish all reserved log to consumer, the producer which comes now will publish it again */
+        do {
+            written = write_index;
+            publish = reserve_index;
+            ASYNC_MEMORY_BARRIER();
+        } while (putting_num == 0 && written != publish
+                && !__sync_bool_compare_and_swap(&write_index, written, publish));
+    }
 
-    return size;
+    return put_size;
 }
 
 #ifdef ELOG_ASYNC_LINE_OUTPUT
 /**
  * Get line log from asynchronous output ring buffer.
  * It will copy all log when the newline sign isn't find.
+ * @note It's the only consumer of the ring buffer, so it never takes the output lock.
  *
  * @param log get line log buffer
  * @param size line log size
@@ -159,49 +205,39 @@ __exit:
  * @return get line log size, the log size is less than ring buffer used size
  */
 size_t elog_async_get_line_log(char *log, size_t size) {
-    size_t used = 0, cpy_log_size = 0;
-    /* lock output */
-    elog_output_lock();
+    size_t used = 0, cpy_log_size = 0, read_pos = read_index & ASYNC_BUF_MASK;
+
     used = elog_async_get_buf_used();
+    /* the log must be read after the write index */
+    ASYNC_MEMORY_BARRIER();
 
     /* no log */
     if (!used || !size) {
-        goto __exit;
+        return 0;
     }
     /* less log */
     if (used <= size) {
         size = used;
     }
 
-    if (read_index + size < ELOG_ASYNC_OUTPUT_BUF_SIZE) {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, size);
-        read_index += cpy_log_size;
+    if (read_pos + size <= ELOG_ASYNC_OUTPUT_BUF_SIZE) {
+        cpy_log_size = elog_cpyln(log, log_buf + read_pos, size);
     } else {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, ELOG_ASYNC_OUTPUT_BUF_SIZE - read_index);
-        if (cpy_log_size == ELOG_ASYNC_OUTPUT_BUF_SIZE - read_index) {
+        cpy_log_size = elog_cpyln(log, log_buf + read_pos, ELOG_ASYNC_OUTPUT_BUF_SIZE - read_pos);
+        if (cpy_log_size == ELOG_ASYNC_OUTPUT_BUF_SIZE - read_pos) {
             cpy_log_size += elog_cpyln(log + cpy_log_size, log_buf, size - cpy_log_size);
-            read_index += cpy_log_size - ELOG_ASYNC_OUTPUT_BUF_SIZE;
-        } else {
-            read_index += cpy_log_size;
         }
     }
+    /* release the space to producer */
+    ASYNC_MEMORY_BARRIER();
+    read_index += cpy_log_size;
 
-    if (used == cpy_log_size) {
-        buf_is_empty = true;
-    }
-
-    if (cpy_log_size) {
-        buf_is_full = false;
-    }
-
-__exit:
-    /* lock output */
-    elog_output_unlock();
     return cpy_log_size;
 }
 #else
 /**
  * get log from asynchronous output ring buffer
+ * @note It's the only consumer of the ring buffer, so it never takes the output lock.
  *
  * @param log get log buffer
  * @param size log size
@@ -209,46 +245,59 @@ __exit:
  * @return get log size, the log size is less than ring buffer used size
  */
 size_t elog_async_get_log(char *log, size_t size) {
-    size_t used = 0;
-    /* lock output */
-    elog_output_lock();
+    size_t used = 0, read_pos = read_index & ASYNC_BUF_MASK;
+
     used = elog_async_get_buf_used();
+    /* the log must be read after the write index */
+    ASYNC_MEMORY_BARRIER();
     /* no log */
     if (!used || !size) {
-        size = 0;
-        goto __exit;
+        return 0;
     }
     /* less log */
     if (used <= size) {
         size = used;
-        buf_is_empty = true;
     }
 
-    if (read_index + size < ELOG_ASYNC_OUTPUT_BUF_SIZE) {
-        memcpy(log, log_buf + read_index, size);
-        read_index += size;
+    if (read_pos + size <= ELOG_ASYNC_OUTPUT_BUF_SIZE) {
+        memcpy(log, log_buf + read_pos, size);
     } else {
-        memcpy(log, log_buf + read_index, ELOG_ASYNC_OUTPUT_BUF_SIZE - read_index);
-        memcpy(log + ELOG_ASYNC_OUTPUT_BUF_SIZE - read_index, log_buf,
-                size - (ELOG_ASYNC_OUTPUT_BUF_SIZE - read_index));
-        read_index += size - ELOG_ASYNC_OUTPUT_BUF_SIZE;
+        memcpy(log, log_buf + read_pos, ELOG_ASYNC_OUTPUT_BUF_SIZE - read_pos);
+        memcpy(log + ELOG_ASYNC_OUTPUT_BUF_SIZE - read_pos, log_buf,
+                size - (ELOG_ASYNC_OUTPUT_BUF_SIZE - read_pos));
     }
+    /* release the space to producer */
+    ASYNC_MEMORY_BARRIER();
+    read_index += size;
 
-    buf_is_full = false;
-
-__exit:
-    /* lock output */
-    elog_output_unlock();
     return size;
 }
 #endif /* ELOG_ASYNC_LINE_OUTPUT */
 
-void elog_async_output(const char *log, size_t size) {
-    /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
+/**
+ * get the total size of log which is dropped by asynchronous output ring buffer full
+ *
+ * @return dropped log size
+ */
+size_t elog_async_get_dropped_size(void) {
+    return dropped_size;
+}
+
+/**
+ * output log by asynchronous output mode
+ * @note The log which level is higher than ELOG_ASYNC_OUTPUT_LVL will output directly,
+ *       so the assert and exception information can output when the output thread is not running.
+ *
+ * @param level log level
+ * @param log output log
+ * @param size log size
+ */
+void elog_async_output(uint8_t level, const char *log, size_t size) {
+    /* this function must be implement by user when there is no built-in output thread */
     extern void elog_async_output_notice(void);
     size_t put_size;
 
-    if (is_enabled) {
+    if (is_enabled && level >= ELOG_ASYNC_OUTPUT_LVL) {
         put_size = async_put_log(log, size);
         /* notify output log thread */
         if (put_size > 0) {
@@ -259,39 +308,67 @@ void elog_async_output(const char *log, size_t size) {
     }
 }
 
+/**
+ * get all logs from asynchronous output ring buffer and output them by batch
+ */
+static void async_output_poll(void) {
+    size_t get_log_size = 0;
+    static char poll_get_buf[ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE];
+
+    /* polling gets and outputs the log */
+    while(true) {
+
+#ifdef ELOG_ASYNC_LINE_OUTPUT
+        get_log_size = elog_async_get_line_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#else
+        get_log_size = elog_async_get_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#endif
+
+        if (get_log_size) {
+            elog_port_output(poll_get_buf, get_log_size);
+        } else {
+            break;
+        }
+    }
+}
+
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
 void elog_async_output_notice(void) {
     sem_post(&output_notice);
 }
 
 static void *async_output(void *arg) {
-    size_t get_log_size = 0;
-    static char poll_get_buf[ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE];
-
     ELOG_ASSERT(init_ok);
 
     while(true) {
         /* waiting log */
         sem_wait(&output_notice);
         /* polling gets and outputs the log */
-        while(true) {
+        async_output_poll();
+    }
+    return NULL;
+}
+#endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
 
-#ifdef ELOG_ASYNC_LINE_OUTPUT
-            get_log_size = elog_async_get_line_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
-#else
-            get_log_size = elog_async_get_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
-#endif
+#ifdef ELOG_ASYNC_OUTPUT_USING_RTTHREAD
+void elog_async_output_notice(void) {
+    rt_event_send(&output_notice, ASYNC_OUTPUT_NOTICE_FLAG);
+}
 
-            if (get_log_size) {
-                elog_port_output(poll_get_buf, get_log_size);
-            } else {
-                break;
-            }
-        }
+static void async_output(void *arg) {
+    rt_uint32_t recved;
+
+    ELOG_ASSERT(init_ok);
+
+    while(true) {
+        /* waiting log */
+        rt_event_recv(&output_notice, ASYNC_OUTPUT_NOTICE_FLAG, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                RT_WAITING_FOREVER, &recved);
+        /* polling gets and outputs the log */
+        async_output_poll();
     }
-    return NULL;
 }
-#endif
+#endif /* ELOG_ASYNC_OUTPUT_USING_RTTHREAD */
 
 /**
  * enable or disable asynchronous output mode
@@ -314,6 +391,8 @@ ElogErrCode elog_async_init(void) {
     if (init_ok) {
         return result;
     }
+    /* the output thread will check this flag when it startup */
+    init_ok = true;
 
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
     pthread_attr_t thread_attr;
@@ -331,7 +410,13 @@ ElogErrCode elog_async_init(void) {
     pthread_attr_destroy(&thread_attr);
 #endif
 
-    init_ok = true;
+#ifdef ELOG_ASYNC_OUTPUT_USING_RTTHREAD
+    rt_event_init(&output_notice, "elog_async", RT_IPC_FLAG_PRIO);
+    rt_thread_init(&async_output_thread, "elog_async", async_output, RT_NULL, async_output_thread_stack,
+            sizeof(async_output_thread_stack), ELOG_ASYNC_OUTPUT_RTTHREAD_PRIORITY,
+            ELOG_ASYNC_OUTPUT_RTTHREAD_TICK);
+    rt_thread_startup(&async_output_thread);
+#endif
 
     return result;
 }
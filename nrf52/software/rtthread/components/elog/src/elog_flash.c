@@ -0,0 +1,365 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, agent, <agent@local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Save logs to a sector ring in flash.
+ *           Every sector has a header (magic + sequence number), the logs are appended to the sector
+ *           as chunks (chunk header + log data). The oldest sector will be erased when all sectors are
+ *           used, so every sector has the same erase count. The newest sector is found by the sector
+ *           headers and its write position is found by walking the chunk headers when initialize.
+ * Created on: 2026-10-17
+ */
+
+#include <elog_flash.h>
+#include <string.h>
+
+#ifdef ELOG_FLASH_ENABLE
+
+#if (ELOG_FLASH_AREA_SIZE % ELOG_FLASH_SECTOR_SIZE != 0) || (ELOG_FLASH_AREA_SIZE / ELOG_FLASH_SECTOR_SIZE < 2)
+    #error "The flash log area size must be an integral multiple of sector size and has 2 sectors at least"
+#endif
+
+#if (ELOG_FLASH_BUF_SIZE % 4 != 0) || (ELOG_FLASH_BUF_SIZE + 12 > ELOG_FLASH_SECTOR_SIZE)
+    #error "The flash write buffer size must be word aligned and less than sector size"
+#endif
+
+/* sector header magic word: 'E' 'L' 'O' 'G' */
+#define SECTOR_MAGIC                   0x474F4C45
+/* sector header size: magic word + sequence number */
+#define SECTOR_HEADER_SIZE             8
+/* chunk header: high 16 bits is magic, low 16 bits is log data size */
+#define CHUNK_MAGIC                    0xE1C6
+#define CHUNK_HEADER_SIZE              4
+/* the erased flash word */
+#define FLASH_ERASED_WORD              0xFFFFFFFF
+/* sector total number in log area */
+#define SECTOR_NUM                     (ELOG_FLASH_AREA_SIZE / ELOG_FLASH_SECTOR_SIZE)
+/* align the size to word */
+#define ALIGN_WORD(size)               (((size) + 3) & ~3)
+
+#define SECTOR_ADDR(index)             (ELOG_FLASH_START_ADDR + (index) * ELOG_FLASH_SECTOR_SIZE)
+
+/* initialize OK flag */
+static bool init_ok = false;
+/* the newest sector index, logs are written to it */
+static size_t cur_sector = 0;
+/* the newest sector sequence number, it's increased when switch to next sector */
+static uint32_t cur_sector_seq = 0;
+/* the write offset in the newest sector */
+static size_t cur_sector_offset = SECTOR_HEADER_SIZE;
+/* flash write buffer, the chunk header is at the beginning */
+static uint32_t write_buf[(CHUNK_HEADER_SIZE + ELOG_FLASH_BUF_SIZE) / 4];
+/* flash write buffer used size, the chunk header is not included */
+static size_t write_buf_used = 0;
+
+static ElogFlashErrCode sector_format(size_t index, uint32_t seq);
+static ElogFlashErrCode sector_find_end(size_t index, size_t *offset);
+
+/**
+ * EasyLogger flash log plugin initialize.
+ * It only reads every sector header and the chunk headers in the newest sector.
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_init(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    uint32_t header[SECTOR_HEADER_SIZE / 4];
+    bool found = false;
+    size_t i;
+
+    if (init_ok) {
+        return result;
+    }
+
+    result = elog_flash_port_init();
+    if (result != ELOG_FLASH_NO_ERR) {
+        return result;
+    }
+    /* find the newest sector which has the biggest sequence number */
+    for (i = 0; i < SECTOR_NUM; i++) {
+        result = elog_flash_port_read(SECTOR_ADDR(i), header, sizeof(header));
+        if (result != ELOG_FLASH_NO_ERR) {
+            return result;
+        }
+        if (header[0] == SECTOR_MAGIC && (!found || (int32_t)(header[1] - cur_sector_seq) > 0)) {
+            cur_sector = i;
+            cur_sector_seq = header[1];
+            found = true;
+        }
+    }
+
+    if (found) {
+        result = sector_find_end(cur_sector, &cur_sector_offset);
+    } else {
+        /* the log area is not used */
+        cur_sector = 0;
+        cur_sector_seq = 0;
+        cur_sector_offset = SECTOR_HEADER_SIZE;
+        result = sector_format(cur_sector, cur_sector_seq);
+    }
+
+    if (result == ELOG_FLASH_NO_ERR) {
+        init_ok = true;
+    }
+
+    return result;
+}
+
+/**
+ * erase the sector and write the sector header
+ *
+ * @param index sector index
+ * @param seq sector sequence number
+ *
+ * @return result
+ */
+static ElogFlashErrCode sector_format(size_t index, uint32_t seq) {
+    ElogFlashErrCode result;
+    uint32_t header[SECTOR_HEADER_SIZE / 4] = { SECTOR_MAGIC, seq };
+
+    result = elog_flash_port_erase(SECTOR_ADDR(index));
+    if (result == ELOG_FLASH_NO_ERR) {
+        result = elog_flash_port_write(SECTOR_ADDR(index), header, sizeof(header));
+    }
+
+    return result;
+}
+
+/**
+ * find the end of the written chunks in sector
+ *
+ * @param index sector index
+ * @param offset the end offset in sector
+ *
+ * @return result
+ */
+static ElogFlashErrCode sector_find_end(size_t index, size_t *offset) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    uint32_t header;
+
+    *offset = SECTOR_HEADER_SIZE;
+    while (*offset + CHUNK_HEADER_SIZE <= ELOG_FLASH_SECTOR_SIZE) {
+        result = elog_flash_port_read(SECTOR_ADDR(index) + *offset, &header, sizeof(header));
+        if (result != ELOG_FLASH_NO_ERR || header == FLASH_ERASED_WORD) {
+            break;
+        }
+        if ((header >> 16) != CHUNK_MAGIC
+                || *offset + CHUNK_HEADER_SIZE + ALIGN_WORD(header & 0xFFFF) > ELOG_FLASH_SECTOR_SIZE) {
+            /* the chunk is broken, so the remain space in this sector will not be used */
+            *offset = ELOG_FLASH_SECTOR_SIZE;
+            break;
+        }
+        *offset += CHUNK_HEADER_SIZE + ALIGN_WORD(header & 0xFFFF);
+    }
+
+    return result;
+}
+
+/**
+ * write all buffered logs to flash as a chunk.
+ * It will switch to next sector and erase it when the newest sector has no space.
+ *
+ * @return result
+ */
+static ElogFlashErrCode write_buf_flush(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    size_t chunk_size = CHUNK_HEADER_SIZE + ALIGN_WORD(write_buf_used);
+
+    if (!write_buf_used) {
+        return result;
+    }
+    /* the newest sector has no space, switch to next sector */
+    if (cur_sector_offset + chunk_size > ELOG_FLASH_SECTOR_SIZE) {
+        cur_sector = (cur_sector + 1) % SECTOR_NUM;
+        cur_sector_seq++;
+        cur_sector_offset = SECTOR_HEADER_SIZE;
+        result = sector_format(cur_sector, cur_sector_seq);
+        if (result != ELOG_FLASH_NO_ERR) {
+            return result;
+        }
+    }
+    /* fill the padding and chunk header */
+    memset((char *) write_buf + CHUNK_HEADER_SIZE + write_buf_used, 0xFF, ALIGN_WORD(write_buf_used) - write_buf_used);
+    write_buf[0] = ((uint32_t) CHUNK_MAGIC << 16) | write_buf_used;
+    result = elog_flash_port_write(SECTOR_ADDR(cur_sector) + cur_sector_offset, write_buf, chunk_size);
+    cur_sector_offset += chunk_size;
+    write_buf_used = 0;
+
+    return result;
+}
+
+/**
+ * Write log to flash. The log will be buffered, and written to flash when the buffer is full.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_flash_write(const char *log, size_t size) {
+    size_t write_size;
+
+    if (!init_ok) {
+        return;
+    }
+
+    elog_flash_port_lock();
+    while (size) {
+        write_size = ELOG_FLASH_BUF_SIZE - write_buf_used;
+        if (write_size > size) {
+            write_size = size;
+        }
+        memcpy((char *) write_buf + CHUNK_HEADER_SIZE + write_buf_used, log, write_size);
+        write_buf_used += write_size;
+        log += write_size;
+        size -= write_size;
+        /* buffer is full */
+        if (write_buf_used == ELOG_FLASH_BUF_SIZE) {
+            write_buf_flush();
+        }
+    }
+    elog_flash_port_unlock();
+}
+
+/**
+ * write all buffered logs to flash
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_flush(void) {
+    ElogFlashErrCode result;
+
+    if (!init_ok) {
+        return ELOG_FLASH_NO_ERR;
+    }
+
+    elog_flash_port_lock();
+    result = write_buf_flush();
+    elog_flash_port_unlock();
+
+    return result;
+}
+
+/**
+ * clean all logs which is saved in flash
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_clean(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    size_t i;
+
+    if (!init_ok) {
+        return result;
+    }
+
+    elog_flash_port_lock();
+    write_buf_used = 0;
+    /* the sequence number is kept increasing */
+    for (i = 0; i < SECTOR_NUM && result == ELOG_FLASH_NO_ERR; i++) {
+        if (i == cur_sector) {
+            result = sector_format(i, ++cur_sector_seq);
+        } else {
+            result = elog_flash_port_erase(SECTOR_ADDR(i));
+        }
+    }
+    cur_sector_offset = SECTOR_HEADER_SIZE;
+    elog_flash_port_unlock();
+
+    return result;
+}
+
+/**
+ * output all logs which is saved in flash from the oldest to the newest.
+ * The buffered logs which is not written to flash will be output at last.
+ */
+void elog_flash_output_all(void) {
+    uint32_t header[SECTOR_HEADER_SIZE / 4], buf[32];
+    size_t i, index, offset, end, data_size, read_size;
+
+    if (!init_ok) {
+        return;
+    }
+
+    elog_flash_port_lock();
+    /* the sector after the newest sector is the oldest sector */
+    for (i = 1; i <= SECTOR_NUM; i++) {
+        index = (cur_sector + i) % SECTOR_NUM;
+        if (elog_flash_port_read(SECTOR_ADDR(index), header, sizeof(header)) != ELOG_FLASH_NO_ERR
+                || header[0] != SECTOR_MAGIC) {
+            continue;
+        }
+        if (index == cur_sector) {
+            end = cur_sector_offset;
+        } else if (sector_find_end(index, &end) != ELOG_FLASH_NO_ERR) {
+            continue;
+        }
+        /* output every chunk */
+        for (offset = SECTOR_HEADER_SIZE; offset + CHUNK_HEADER_SIZE <= end; ) {
+            if (elog_flash_port_read(SECTOR_ADDR(index) + offset, header, CHUNK_HEADER_SIZE) != ELOG_FLASH_NO_ERR
+                    || (header[0] >> 16) != CHUNK_MAGIC) {
+                break;
+            }
+            data_size = header[0] & 0xFFFF;
+            offset += CHUNK_HEADER_SIZE;
+            while (data_size) {
+                read_size = data_size < sizeof(buf) ? data_size : sizeof(buf);
+                elog_flash_port_read(SECTOR_ADDR(index) + offset, buf, ALIGN_WORD(read_size));
+                elog_flash_port_output((const char *) buf, read_size);
+                offset += read_size;
+                data_size -= read_size;
+            }
+            offset = ALIGN_WORD(offset);
+        }
+    }
+    /* output the buffered logs */
+    elog_flash_port_output((const char *) write_buf + CHUNK_HEADER_SIZE, write_buf_used);
+    elog_flash_port_unlock();
+}
+
+/**
+ * get the size of all logs which is saved in flash, the buffered logs is included
+ *
+ * @return used size
+ */
+size_t elog_flash_get_used_size(void) {
+    uint32_t header[SECTOR_HEADER_SIZE / 4];
+    size_t i, end, used = write_buf_used;
+
+    if (!init_ok) {
+        return 0;
+    }
+
+    elog_flash_port_lock();
+    for (i = 0; i < SECTOR_NUM; i++) {
+        if (i == cur_sector) {
+            used += cur_sector_offset - SECTOR_HEADER_SIZE;
+        } else if (elog_flash_port_read(SECTOR_ADDR(i), header, sizeof(header)) == ELOG_FLASH_NO_ERR
+                && header[0] == SECTOR_MAGIC && sector_find_end(i, &end) == ELOG_FLASH_NO_ERR) {
+            used += end - SECTOR_HEADER_SIZE;
+        }
+    }
+    elog_flash_port_unlock();
+
+    return used;
+}
+
+#endif /* ELOG_FLASH_ENABLE */
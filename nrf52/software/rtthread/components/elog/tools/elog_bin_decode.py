@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+# This file is part of the EasyLogger Library.
+#
+# Function: Decode the EasyLogger binary log (ELOG_BIN_OUTPUT_ENABLE) by the firmware ELF file.
+#           The text log which is mixed with binary log will be output directly.
+#
+# Usage: elog_bin_decode.py <firmware.elf> [log file, default is stdin]
+#
+
+import re
+import struct
+import sys
+
+ELOG_BIN_SYNC_SIGN = 0xA5
+ELOG_BIN_ESC_SIGN = 0xDB
+ELOG_BIN_ARGS_MAX = 8
+# sync sign(1) + level and arguments number(1) + tick(4) + tag address(4) + format address(4), the bytes
+# after sync sign are escaped: the newline and escape sign byte is escape sign + (byte ^ 0x20)
+RECORD_HEAD_SIZE = 14
+LEVEL_OUTPUT_INFO = ['A/', 'E/', 'W/', 'I/', 'D/', 'V/']
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+C_FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf(object):
+    """Only the little-endian ELF file is supported, the ELF64 is used on host simulator"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[5] != 1:
+            raise ValueError('%s is not a little-endian ELF file' % path)
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2E)
+            sh_format = '<IIIII'
+        else:
+            shoff, = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from('<HH', self.data, 0x3A)
+            sh_format = '<IQQQQ'
+        # all the loaded sections which has data, the constant strings is in them
+        self.sections = []
+        for i in range(shnum):
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(sh_format, self.data,
+                                                                                shoff + i * shentsize + 4)
+            if sh_type == SHT_PROGBITS and sh_flags & SHF_ALLOC and sh_size:
+                self.sections.append((sh_addr, sh_size, sh_offset))
+
+    def string(self, addr):
+        """get the constant string by address, it will return None when the address is not in ELF"""
+        for sh_addr, sh_size, sh_offset in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + addr - sh_addr
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('utf-8', 'replace')
+        return None
+
+
+def format_log(elf, fmt, args):
+    """format the log like C printf, every argument is a 32-bit word"""
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(next_arg())
+        if precision == '*':
+            precision = str(next_arg())
+        spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+        arg = next_arg()
+        if conv in 'di':
+            return (spec + 'd') % (arg - (1 << 32) if arg & 0x80000000 else arg)
+        elif conv == 'u':
+            return (spec + 'd') % arg
+        elif conv == 'c':
+            return (spec + 'c') % chr(arg & 0xFF)
+        elif conv == 's':
+            string = elf.string(arg)
+            return (spec + 's') % (string if string is not None else '<0x%08x>' % arg)
+        elif conv == 'p':
+            return '0x%08x' % arg
+        else:
+            return (spec + conv) % arg
+
+    return C_FORMAT_SPEC.sub(convert, fmt)
+
+
+def unescape(data, start, size):
+    """unescape the size bytes of record from start, it will return None when the data is not enough"""
+    record = bytearray()
+    i = start
+    while len(record) < size:
+        if i >= len(data):
+            return None, i
+        if data[i] == ELOG_BIN_ESC_SIGN:
+            if i + 1 >= len(data):
+                return None, i
+            record.append(data[i + 1] ^ 0x20)
+            i += 2
+        else:
+            record.append(data[i])
+            i += 1
+    return bytes(record), i
+
+
+def decode(elf, stream, out):
+    data = stream.read()
+    text_start = 0
+    i = 0
+    while i < len(data):
+        if data[i] != ELOG_BIN_SYNC_SIGN:
+            i += 1
+            continue
+        # the bytes after sync sign are escaped, the newline byte is never in the record
+        head, end = unescape(data, i + 1, RECORD_HEAD_SIZE - 1)
+        tag = fmt = None
+        if head is not None:
+            level, argc = head[0] >> 4, head[0] & 0x0F
+            if level < len(LEVEL_OUTPUT_INFO) and argc <= ELOG_BIN_ARGS_MAX:
+                raw_args, end = unescape(data, end, argc * 4)
+                if raw_args is not None:
+                    tick, tag_addr, fmt_addr = struct.unpack_from('<III', head, 1)
+                    tag, fmt = elf.string(tag_addr), elf.string(fmt_addr)
+        # it's not a binary log record or the record is broken, so resync from next byte
+        if tag is None or fmt is None:
+            i += 1
+            continue
+        out.write(data[text_start:i].decode('utf-8', 'replace'))
+        args = struct.unpack('<%dI' % argc, raw_args)
+        out.write('%s%s [tick:%010d] %s\n' % (LEVEL_OUTPUT_INFO[level], tag, tick, format_log(elf, fmt, args)))
+        i = end
+        text_start = i
+    out.write(data[text_start:].decode('utf-8', 'replace'))
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write('Usage: %s <firmware.elf> [log file]\n' % sys.argv[0])
+        return 1
+    elf = Elf(sys.argv[1])
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], 'rb') as stream:
+            decode(elf, stream, sys.stdout)
+    else:
+        decode(elf, sys.stdin.buffer, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
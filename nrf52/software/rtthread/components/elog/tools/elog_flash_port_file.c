@@ -0,0 +1,171 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, agent, <agent@local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Portable interface for EasyLogger's flash log plugin on a file, it's used to test and simulate the
+ *           flash log on Linux host. The file has the same layout with the log area on flash, it's erased to 0xFF
+ *           and the written bit only can be changed from 1 to 0 like NOR flash.
+ *           Build it with ELOG_FLASH_PORT_USING_FILE defined, the file path is ELOG_FLASH_PORT_FILE_PATH.
+ * Created on: 2026-10-17
+ */
+
+#include <elog_flash.h>
+
+#if defined(ELOG_FLASH_ENABLE) && defined(ELOG_FLASH_PORT_USING_FILE)
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifndef ELOG_FLASH_PORT_FILE_PATH
+#define ELOG_FLASH_PORT_FILE_PATH            "elog_flash.bin"
+#endif
+
+static FILE *flash_file = NULL;
+static pthread_mutex_t flash_lock;
+
+/**
+ * EasyLogger flash log plugin port initialize
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_init(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    uint8_t erased[64];
+    size_t i;
+
+    pthread_mutex_init(&flash_lock, NULL);
+
+    flash_file = fopen(ELOG_FLASH_PORT_FILE_PATH, "r+b");
+    if (!flash_file) {
+        /* the new file is same as erased flash */
+        flash_file = fopen(ELOG_FLASH_PORT_FILE_PATH, "w+b");
+        if (!flash_file) {
+            return ELOG_FLASH_WRITE_ERR;
+        }
+        memset(erased, 0xFF, sizeof(erased));
+        for (i = 0; i < ELOG_FLASH_AREA_SIZE; i += sizeof(erased)) {
+            fwrite(erased, 1, sizeof(erased), flash_file);
+        }
+        fflush(flash_file);
+    }
+
+    return result;
+}
+
+/**
+ * read data from flash file
+ *
+ * @param addr flash address
+ * @param buf buffer to store read data
+ * @param size read bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, uint32_t *buf, size_t size) {
+    if (fseek(flash_file, addr - ELOG_FLASH_START_ADDR, SEEK_SET)
+            || fread(buf, 1, size, flash_file) != size) {
+        return ELOG_FLASH_READ_ERR;
+    }
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * erase a flash sector, it's filled with 0xFF
+ *
+ * @param addr sector start address
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr) {
+    uint8_t erased[64];
+    size_t i;
+
+    memset(erased, 0xFF, sizeof(erased));
+    if (fseek(flash_file, addr - ELOG_FLASH_START_ADDR, SEEK_SET)) {
+        return ELOG_FLASH_ERASE_ERR;
+    }
+    for (i = 0; i < ELOG_FLASH_SECTOR_SIZE; i += sizeof(erased)) {
+        if (fwrite(erased, 1, sizeof(erased), flash_file) != sizeof(erased)) {
+            return ELOG_FLASH_ERASE_ERR;
+        }
+    }
+    fflush(flash_file);
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * write data to flash file, the bit only can be changed from 1 to 0
+ *
+ * @param addr flash address
+ * @param buf the write data buffer
+ * @param size write bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_write(uint32_t addr, const uint32_t *buf, size_t size) {
+    uint32_t word;
+    size_t i;
+
+    for (i = 0; i < size; i += 4, buf++) {
+        if (elog_flash_port_read(addr + i, &word, sizeof(word)) != ELOG_FLASH_NO_ERR) {
+            return ELOG_FLASH_WRITE_ERR;
+        }
+        word &= *buf;
+        if (fseek(flash_file, addr + i - ELOG_FLASH_START_ADDR, SEEK_SET)
+                || fwrite(&word, 1, sizeof(word), flash_file) != sizeof(word)) {
+            return ELOG_FLASH_WRITE_ERR;
+        }
+    }
+    fflush(flash_file);
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * output flash saved log port interface
+ *
+ * @param log flash saved log
+ * @param size log size
+ */
+void elog_flash_port_output(const char *log, size_t size) {
+    fwrite(log, 1, size, stdout);
+}
+
+/**
+ * flash log lock
+ */
+void elog_flash_port_lock(void) {
+    pthread_mutex_lock(&flash_lock);
+}
+
+/**
+ * flash log unlock
+ */
+void elog_flash_port_unlock(void) {
+    pthread_mutex_unlock(&flash_lock);
+}
+
+#endif /* defined(ELOG_FLASH_ENABLE) && defined(ELOG_FLASH_PORT_USING_FILE) */
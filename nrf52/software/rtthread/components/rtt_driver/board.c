@@ -10,6 +10,9 @@
  * Change Logs:
  * Date           Author		Notes
  * 2015-11-11     Xue Liu		Initial for nRF52
+ * 2026-10-17     agent        add tickless sleep by RTC1
+ * 2026-10-17     agent        add the trace timestamp by DWT cycle counter
+ * 2026-10-17     agent        wake up from tickless sleep with BASEPRI critical section
  */
 
 #include <rthw.h>
@@ -19,9 +22,27 @@
 #include <nrf52_bitfields.h>
 #include <boards.h>
 
+#include <stdint.h>
+
 #include "board.h"
 #include "uart.h"
 
+#ifdef RT_USING_TICKLESS
+/* the RTC1 is clocked by LFCLK without prescaler, it keeps counting when SysTick is stopped */
+#define RTC_FREQUENCY                  32768
+#define RTC_COUNTER_MASK               0x00FFFFFF
+/* the CC must be 2 counts later than the COUNTER at least, otherwise the compare event maybe lost */
+#define RTC_COMPARE_MIN_COUNT          2
+/* the longest sleep, it's far less than the COUNTER overflow period (512s) */
+#define TICKLESS_SLEEP_MAX_COUNT       (RTC_COUNTER_MASK / 2)
+#define TICKLESS_SLEEP_MAX_TICK        ((uint64_t)TICKLESS_SLEEP_MAX_COUNT * RT_TICK_PER_SECOND / RTC_FREQUENCY)
+/* the sleep which is shorter than it is waited with the periodic SysTick */
+#define TICKLESS_SLEEP_MIN_TICK        2
+
+/* the passed time which is not counted to system tick yet, the unit is 1/RTC_FREQUENCY tick */
+static uint32_t tickless_remainder = 0;
+#endif /* RT_USING_TICKLESS */
+
 /**
  * @addtogroup NRF52832
  */
@@ -39,6 +60,139 @@ void SysTick_Handler(void)
     rt_interrupt_leave();
 }
 
+#ifdef RT_USING_TICKLESS
+/** @brief: Function for handling the RTC1 interrupts, it's only used to wake up the CPU.
+ */
+void RTC1_IRQHandler(void)
+{
+    NRF_RTC1->EVENTS_COMPARE[0] = 0;
+}
+
+static void rt_hw_rtc_init(void)
+{
+    /* start the 32.768kHz crystal oscillator */
+    NRF_CLOCK->LFCLKSRC = CLOCK_LFCLKSRC_SRC_Xtal << CLOCK_LFCLKSRC_SRC_Pos;
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_LFCLKSTART = 1;
+    while (NRF_CLOCK->EVENTS_LFCLKSTARTED == 0);
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+
+    NRF_RTC1->PRESCALER = 0;
+    NRF_RTC1->INTENCLR = RTC_INTENCLR_COMPARE0_Msk;
+    NVIC_ClearPendingIRQ(RTC1_IRQn);
+    NVIC_EnableIRQ(RTC1_IRQn);
+    NRF_RTC1->TASKS_START = 1;
+}
+
+/* sleep until interrupt, it's invoked with interrupt disabled */
+static void rt_hw_wfi(void)
+{
+#ifdef RT_USING_BASEPRI
+    /* the interrupt which is masked by BASEPRI doesn't wake up WFI, so it's masked by PRIMASK in sleep */
+    uint32_t basepri = __get_BASEPRI();
+
+    __disable_irq();
+    __set_BASEPRI(0);
+    __DSB();
+    __WFI();
+    __set_BASEPRI(basepri);
+    __enable_irq();
+#else
+    __DSB();
+    __WFI();
+#endif
+}
+
+/**
+ * This function will stop the SysTick and sleep until the RTC1 compare event
+ * or other interrupt, it's invoked by idle thread with interrupt disabled.
+ *
+ * @param timeout the tick to the next timer timeout
+ *
+ * @return the tick which is passed in sleep
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t timeout)
+{
+    uint32_t start, count, reload;
+    uint64_t passed;
+
+    if (timeout < TICKLESS_SLEEP_MIN_TICK)
+    {
+        rt_hw_wfi();
+        return 0;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    /* the tick is reached before stop, it will be counted by SysTick_Handler */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return 0;
+    }
+    /* the passed part of the current tick */
+    reload = SysTick->LOAD + 1;
+    tickless_remainder += (uint64_t)(reload - 1 - SysTick->VAL) * RTC_FREQUENCY / reload;
+
+    if (timeout > TICKLESS_SLEEP_MAX_TICK)
+    {
+        timeout = TICKLESS_SLEEP_MAX_TICK;
+    }
+    /* the count to the timeout: count * RT_TICK_PER_SECOND + remainder >= timeout * RTC_FREQUENCY */
+    passed = (uint64_t)timeout * RTC_FREQUENCY;
+    count = passed > tickless_remainder ?
+            (passed - tickless_remainder + RT_TICK_PER_SECOND - 1) / RT_TICK_PER_SECOND : 0;
+    if (count < RTC_COMPARE_MIN_COUNT)
+    {
+        count = RTC_COMPARE_MIN_COUNT;
+    }
+
+    start = NRF_RTC1->COUNTER;
+    NRF_RTC1->CC[0] = (start + count) & RTC_COUNTER_MASK;
+    NRF_RTC1->EVENTS_COMPARE[0] = 0;
+    NRF_RTC1->INTENSET = RTC_INTENSET_COMPARE0_Msk;
+
+    rt_hw_wfi();
+
+    NRF_RTC1->INTENCLR = RTC_INTENCLR_COMPARE0_Msk;
+    NRF_RTC1->EVENTS_COMPARE[0] = 0;
+    NVIC_ClearPendingIRQ(RTC1_IRQn);
+
+    /* catch up the passed tick, the part less than one tick is left for the next sleep */
+    passed = (uint64_t)((NRF_RTC1->COUNTER - start) & RTC_COUNTER_MASK) * RT_TICK_PER_SECOND
+            + tickless_remainder;
+    tickless_remainder = passed % RTC_FREQUENCY;
+
+    /* restart the SysTick with a whole tick period */
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    return (rt_tick_t)(passed / RTC_FREQUENCY);
+}
+#endif /* RT_USING_TICKLESS */
+
+#ifdef RT_USING_TRACE
+/**
+ * This function will get the timestamp of trace event, it's the DWT cycle
+ * counter which is enabled in board initialization.
+ *
+ * @return the CPU cycles
+ */
+rt_uint32_t rt_hw_trace_timestamp(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * This function will get the frequency of trace timestamp.
+ *
+ * @return the CPU clock in Hz
+ */
+rt_uint32_t rt_hw_trace_frequency(void)
+{
+    return SystemCoreClock;
+}
+#endif /* RT_USING_TRACE */
+
 
 /**
  * This function will initial NRF52832 board.
@@ -51,6 +205,17 @@ void rt_hw_board_init()
     /* configure the SysTick */
 	SysTick_Config(SystemCoreClock / RT_TICK_PER_SECOND);
 
+#ifdef RT_USING_TICKLESS
+    /* configure the RTC1 for wakeup from tickless sleep */
+    rt_hw_rtc_init();
+#endif
+
+#ifdef RT_USING_TRACE
+    /* enable the DWT cycle counter for trace timestamp */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
 	/* components init for board */
 	rt_components_board_init();
 
@@ -10,6 +10,9 @@
  * Change Logs:
  * Date           Author       Notes
  * 2017-05-01     armink       the first version
+ * 2026-10-17     agent        send the contiguous TX data by one EasyDMA transfer, add DMA TX mode
+ * 2026-10-17     agent        add double buffered EasyDMA RX mode with idle line flush
+ * 2026-10-17     agent        start the idle line flush timer by the first received byte, no tick when RX is idle
  */
 
 #include <stdbool.h>
@@ -21,6 +24,7 @@
 
 #include <nrf.h>
 #include <nrf_drv_uart.h>
+#include <nrf_drv_common.h>
 #include <nordic_common.h>
 
 #include "board.h"
@@ -32,6 +36,17 @@
 #define UART0_RX_PIN                   19
 #define UART0_RTS_PIN                  0xFFFFFFFF
 #define UART0_CTS_PIN                  0xFFFFFFFF
+/* the max size of one EasyDMA transfer, the UARTE TXD.MAXCNT is 8 bits on nRF52832 */
+#define UART_DMA_TX_MAX_SIZE           255
+/* the serial device RX fifo is received in blocks by EasyDMA, the fifo size must be an integral multiple of it */
+#define UART_DMA_RX_BLOCK_SIZE         128
+/* the received data will be flushed to serial device when RX line is idle for this ticks */
+#define UART_DMA_RX_IDLE_TICK          1
+/* the TIMER and PPI channel which count the received bytes of uart0 in DMA RX mode */
+#define UART0_DMA_RX_TIMER             NRF_TIMER1
+#define UART0_DMA_RX_TIMER_IRQn        TIMER1_IRQn
+#define UART0_DMA_RX_TIMER_IRQHandler  TIMER1_IRQHandler
+#define UART0_DMA_RX_PPI_CH            0
 
 #if defined(RT_USING_UART0)
 static nrf_drv_uart_t uart0_dev = NRF_DRV_UART_INSTANCE(UART0_INSTANCE_INDEX);
@@ -43,15 +58,362 @@ struct nrf52_uart
     nrf_drv_uart_t *device;
     struct rt_ringbuffer tx_rb;
     rt_uint8_t tx_buffer[RT_SERIAL_RB_BUFSZ];
+    /* the size of the transfer which is in progress, 0: UART is idle */
+    rt_size_t tx_sending;
+    /* the transfer which is in progress is from tx_rb */
+    bool tx_sending_rb;
+    /* the DMA TX data which is from serial device DMA TX data queue */
+    const rt_uint8_t *dma_tx_buf;
+    rt_size_t dma_tx_size;
+    rt_size_t dma_tx_sent;
+    /* the EasyDMA can't read the flash, so the DMA TX data which is in flash will be copied to here */
+    rt_uint8_t dma_tx_bounce[UART_DMA_TX_MAX_SIZE];
     bool has_recved;
     uint8_t recved_data;
+    /* the single byte RX buffer for interrupt mode, the EasyDMA writes it after nrf_drv_uart_rx returned */
+    uint8_t rx_byte;
+    /* DMA RX mode: the received bytes counter */
+    NRF_TIMER_Type *rx_counter;
+    IRQn_Type rx_counter_irqn;
+    rt_uint8_t rx_counter_ppi_ch;
+    /* DMA RX mode: the idle line flush timer, it's started by the counter compare interrupt of first received byte */
+    struct rt_timer rx_idle_timer;
+    rt_uint32_t rx_idle_last_count;
+    bool dma_rx_activated;
+    /* DMA RX mode: the current block (primary buffer) and the next block (secondary buffer) in RX fifo */
+    rt_size_t rx_cur_pos;
+    rt_size_t rx_cur_len;
+    rt_size_t rx_next_pos;
+    rt_size_t rx_next_len;
+    /* DMA RX mode: the counter value when current block is started */
+    rt_uint32_t rx_cur_count;
+    /* DMA RX mode: the RX fifo position which has been reported to serial device, it's in current block */
+    rt_size_t rx_put_pos;
 };
 
+/**
+ * Start next transfer when UART is idle. The DMA TX data is sent first, then the contiguous data in tx_rb.
+ * @note It must be called with interrupt disabled.
+ *
+ * @param uart nRF52 UART
+ */
+static void uart_tx_start(struct nrf52_uart *uart)
+{
+    struct rt_ringbuffer *rb = &uart->tx_rb;
+    const rt_uint8_t *buf;
+    rt_size_t size;
+
+    if (uart->tx_sending) {
+        return;
+    }
+
+    if (uart->dma_tx_buf) {
+        buf = uart->dma_tx_buf + uart->dma_tx_sent;
+        size = uart->dma_tx_size - uart->dma_tx_sent;
+        if (size > UART_DMA_TX_MAX_SIZE) {
+            size = UART_DMA_TX_MAX_SIZE;
+        }
+        if (!nrf_drv_is_in_RAM(buf)) {
+            rt_memcpy(uart->dma_tx_bounce, buf, size);
+            buf = uart->dma_tx_bounce;
+        }
+        uart->tx_sending_rb = false;
+    } else {
+        /* the contiguous data from read index, the data is kept in tx_rb until the transfer is done */
+        buf = rb->buffer_ptr + rb->read_index;
+        if (rb->read_mirror == rb->write_mirror) {
+            size = rb->write_index - rb->read_index;
+        } else {
+            size = rb->buffer_size - rb->read_index;
+        }
+        if (size > UART_DMA_TX_MAX_SIZE) {
+            size = UART_DMA_TX_MAX_SIZE;
+        }
+        uart->tx_sending_rb = true;
+    }
+
+    if (size) {
+        uart->tx_sending = size;
+        nrf_drv_uart_tx(uart->device, (uint8_t *) buf, size);
+    }
+}
+
+/**
+ * The transfer which is in progress is done, then release the sent data.
+ *
+ * @param serial serial device
+ * @param uart nRF52 UART
+ */
+static void uart_tx_done(struct rt_serial_device *serial, struct nrf52_uart *uart)
+{
+    struct rt_ringbuffer *rb = &uart->tx_rb;
+    rt_size_t size;
+    rt_base_t level;
+
+    /* the higher priority interrupt maybe put data to tx_rb */
+    level = rt_hw_interrupt_disable();
+    size = uart->tx_sending;
+    uart->tx_sending = 0;
+    if (uart->tx_sending_rb) {
+        /* remove the sent data from tx_rb */
+        if (rb->read_index + size >= rb->buffer_size) {
+            rb->read_mirror = ~rb->read_mirror;
+            rb->read_index = rb->read_index + size - rb->buffer_size;
+        } else {
+            rb->read_index += size;
+        }
+    } else if (uart->dma_tx_buf) {
+        uart->dma_tx_sent += size;
+        if (uart->dma_tx_sent >= uart->dma_tx_size) {
+            uart->dma_tx_buf = RT_NULL;
+            /* the serial device will start next DMA TX data by dma_transmit */
+            rt_hw_serial_isr(serial, RT_SERIAL_EVENT_TX_DMADONE);
+        }
+    }
+    uart_tx_start(uart);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * get the total received bytes from counter
+ *
+ * @param uart nRF52 UART
+ *
+ * @return received bytes
+ */
+static rt_uint32_t uart_dma_rx_count(struct nrf52_uart *uart)
+{
+    uart->rx_counter->TASKS_CAPTURE[0] = 1;
+    return uart->rx_counter->CC[0];
+}
+
+/**
+ * get the length of block from the RX fifo position
+ *
+ * @param serial serial device
+ * @param pos RX fifo position
+ *
+ * @return block length
+ */
+static rt_size_t uart_dma_rx_block_len(struct rt_serial_device *serial, rt_size_t pos)
+{
+    rt_size_t len = serial->config.bufsz - pos;
+
+    return len > UART_DMA_RX_BLOCK_SIZE ? UART_DMA_RX_BLOCK_SIZE : len;
+}
+
+/**
+ * Get the length of new received data which is not reported to serial device, then mark it reported.
+ * @note It must be called with interrupt disabled.
+ *
+ * @param uart nRF52 UART
+ * @param end the received data end position in current block
+ *
+ * @return new received data length
+ */
+static rt_size_t uart_dma_rx_take(struct nrf52_uart *uart, rt_size_t end)
+{
+    rt_size_t len = 0;
+
+    if (end > uart->rx_put_pos) {
+        len = end - uart->rx_put_pos;
+        uart->rx_put_pos = end;
+    }
+
+    return len;
+}
+
+/**
+ * Start DMA RX from the RX fifo position. Current block and next block are both set to UART, so the
+ * UARTE switches to the next block without losing data when current block is full.
+ * @note It must be called with interrupt disabled.
+ *
+ * @param serial serial device
+ * @param uart nRF52 UART
+ * @param pos RX fifo position
+ */
+static void uart_dma_rx_start(struct rt_serial_device *serial, struct nrf52_uart *uart, rt_size_t pos)
+{
+    struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+
+    uart->rx_cur_pos = pos;
+    uart->rx_cur_len = uart_dma_rx_block_len(serial, pos);
+    uart->rx_next_pos = (pos + uart->rx_cur_len) % serial->config.bufsz;
+    uart->rx_next_len = uart_dma_rx_block_len(serial, uart->rx_next_pos);
+    uart->rx_cur_count = uart_dma_rx_count(uart);
+    uart->rx_put_pos = pos;
+
+    nrf_drv_uart_rx(uart->device, rx_fifo->buffer + uart->rx_cur_pos, uart->rx_cur_len);
+    nrf_drv_uart_rx(uart->device, rx_fifo->buffer + uart->rx_next_pos, uart->rx_next_len);
+}
+
+/**
+ * The DMA RX block is done, the next block will be current block, and a new block is set as next block.
+ *
+ * @param serial serial device
+ * @param uart nRF52 UART
+ * @param buf the block buffer
+ * @param bytes received bytes in this block
+ */
+static void uart_dma_rx_done(struct rt_serial_device *serial, struct nrf52_uart *uart, uint8_t *buf, rt_size_t bytes)
+{
+    struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    rt_size_t len;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (!uart->dma_rx_activated || buf != rx_fifo->buffer + uart->rx_cur_pos) {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+    len = uart_dma_rx_take(uart, uart->rx_cur_pos + bytes);
+    if (bytes == uart->rx_cur_len) {
+        /* the UARTE has switched to the next block */
+        uart->rx_cur_pos = uart->rx_next_pos;
+        uart->rx_cur_len = uart->rx_next_len;
+        uart->rx_cur_count += bytes;
+        uart->rx_next_pos = (uart->rx_cur_pos + uart->rx_cur_len) % serial->config.bufsz;
+        uart->rx_next_len = uart_dma_rx_block_len(serial, uart->rx_next_pos);
+        uart->rx_put_pos = uart->rx_cur_pos;
+        nrf_drv_uart_rx(uart->device, rx_fifo->buffer + uart->rx_next_pos, uart->rx_next_len);
+    } else {
+        /* the RX is stopped by error, restart it from the end of received data */
+        uart_dma_rx_start(serial, uart, uart->rx_put_pos % serial->config.bufsz);
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (len) {
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_DMADONE | (len << 8));
+    }
+}
+
+/**
+ * Wait the next received byte when RX line is idle. The counter compare interrupt of next byte will
+ * start the idle line flush timer, so there is no tick when RX line is idle.
+ * @note It must be called with interrupt disabled.
+ *
+ * @param uart nRF52 UART
+ */
+static void uart_dma_rx_idle_wait(struct nrf52_uart *uart)
+{
+    uart->rx_counter->EVENTS_COMPARE[1] = 0;
+    uart->rx_counter->CC[1] = uart->rx_idle_last_count + 1;
+    uart->rx_counter->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+    /* the byte which is received before the compare value is set doesn't generate compare event */
+    if (uart_dma_rx_count(uart) != uart->rx_idle_last_count) {
+        uart->rx_counter->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+        rt_timer_start(&uart->rx_idle_timer);
+    }
+}
+
+/**
+ * The first byte is received after RX line is idle, then start the idle line flush timer.
+ *
+ * @param uart nRF52 UART
+ */
+static void uart_dma_rx_wakeup(struct nrf52_uart *uart)
+{
+    uart->rx_counter->EVENTS_COMPARE[1] = 0;
+    uart->rx_counter->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+    if (uart->dma_rx_activated) {
+        rt_timer_start(&uart->rx_idle_timer);
+    }
+}
+
+/**
+ * The idle line flush timer. The received data in current block will be reported to serial device
+ * when no data is received during last period. The one shot timer is started again when the data
+ * is still being received, otherwise it waits the next received byte.
+ *
+ * @param parameter serial device
+ */
+static void uart_dma_rx_idle_timeout(void *parameter)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *) parameter;
+    struct nrf52_uart *uart = (struct nrf52_uart *) serial->parent.user_data;
+    rt_uint32_t count, recved;
+    rt_size_t len = 0;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    count = uart_dma_rx_count(uart);
+    if (uart->dma_rx_activated && count == uart->rx_idle_last_count) {
+        recved = count - uart->rx_cur_count;
+        /* the remaining data is in next block, it will be reported when current block done */
+        if ((rt_int32_t) recved < 0) {
+            recved = 0;
+        } else if (recved > uart->rx_cur_len) {
+            recved = uart->rx_cur_len;
+        }
+        len = uart_dma_rx_take(uart, uart->rx_cur_pos + recved);
+        uart_dma_rx_idle_wait(uart);
+    } else if (uart->dma_rx_activated) {
+        uart->rx_idle_last_count = count;
+        rt_timer_start(&uart->rx_idle_timer);
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (len) {
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_DMADONE | (len << 8));
+    }
+}
+
+/**
+ * enable or disable the DMA RX mode
+ *
+ * @param serial serial device
+ * @param uart nRF52 UART
+ * @param enabled true: enable, false: disable
+ */
+static void uart_dma_rx_enabled(struct rt_serial_device *serial, struct nrf52_uart *uart, bool enabled)
+{
+    rt_base_t level;
+
+    if (enabled) {
+        RT_ASSERT(serial->config.bufsz % UART_DMA_RX_BLOCK_SIZE == 0);
+        /* count the received bytes by TIMER in counter mode, the RXDRDY event is connected to COUNT task by PPI */
+        uart->rx_counter->TASKS_STOP = 1;
+        uart->rx_counter->MODE = TIMER_MODE_MODE_Counter << TIMER_MODE_MODE_Pos;
+        uart->rx_counter->BITMODE = TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos;
+        uart->rx_counter->TASKS_CLEAR = 1;
+        uart->rx_counter->TASKS_START = 1;
+        NRF_PPI->CH[uart->rx_counter_ppi_ch].EEP = (uint32_t) &NRF_UARTE0->EVENTS_RXDRDY;
+        NRF_PPI->CH[uart->rx_counter_ppi_ch].TEP = (uint32_t) &uart->rx_counter->TASKS_COUNT;
+        NRF_PPI->CHENSET = 1UL << uart->rx_counter_ppi_ch;
+        /* the compare event of the counter wakes up the idle line flush timer */
+        uart->rx_counter->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+        uart->rx_counter->EVENTS_COMPARE[1] = 0;
+        nrf_drv_common_irq_enable(uart->rx_counter_irqn, uart->config.interrupt_priority);
+
+        rt_timer_init(&uart->rx_idle_timer, "uart rx", uart_dma_rx_idle_timeout, serial, UART_DMA_RX_IDLE_TICK,
+                RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+        level = rt_hw_interrupt_disable();
+        uart->dma_rx_activated = true;
+        uart->rx_idle_last_count = 0;
+        nrf_drv_uart_rx_enable(uart->device);
+        uart_dma_rx_start(serial, uart, 0);
+        uart_dma_rx_idle_wait(uart);
+        rt_hw_interrupt_enable(level);
+    } else if (uart->dma_rx_activated) {
+        uart->rx_counter->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+        nrf_drv_common_irq_disable(uart->rx_counter_irqn);
+        rt_timer_detach(&uart->rx_idle_timer);
+
+        level = rt_hw_interrupt_disable();
+        uart->dma_rx_activated = false;
+        nrf_drv_uart_rx_abort(uart->device);
+        rt_hw_interrupt_enable(level);
+
+        NRF_PPI->CHENCLR = 1UL << uart->rx_counter_ppi_ch;
+        uart->rx_counter->TASKS_STOP = 1;
+    }
+}
+
 static void uart_event_handler(nrf_drv_uart_event_t * p_event, void * p_context)
 {
     struct rt_serial_device *serial = (struct rt_serial_device *)p_context;
     struct nrf52_uart* uart = (struct nrf52_uart *)serial->parent.user_data;
-    rt_uint8_t ch;
 
     RT_ASSERT(serial);
     RT_ASSERT(uart);
@@ -60,19 +422,29 @@ static void uart_event_handler(nrf_drv_uart_event_t * p_event, void * p_context)
 
     switch (p_event->type) {
     case NRF_DRV_UART_EVT_RX_DONE: {
-        uart->has_recved = true;
-        uart->recved_data = p_event->data.rxtx.p_data[0];
-        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+        if (serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX) {
+            uart_dma_rx_done(serial, uart, p_event->data.rxtx.p_data, p_event->data.rxtx.bytes);
+        } else if (serial->parent.open_flag & RT_DEVICE_FLAG_INT_RX) {
+            /* the aborted transfer of a closed RX mode is reported late, it's dropped */
+            uart->has_recved = true;
+            uart->recved_data = p_event->data.rxtx.p_data[0];
+            rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+        }
         break;
     }
     case NRF_DRV_UART_EVT_TX_DONE: {
-        if (rt_ringbuffer_getchar(&uart->tx_rb, &ch) > 0) {
-            nrf_drv_uart_tx(uart->device, (uint8_t *) &(ch), 1);
-        }
+        uart_tx_done(serial, uart);
         break;
     }
     case NRF_DRV_UART_EVT_ERROR: {
         rt_kprintf("Error: Reported by UART peripheral.\n");
+        if (serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX) {
+            /* the RX is stopped by error, report the received data and restart it */
+            uart_dma_rx_done(serial, uart, p_event->data.rxtx.p_data, p_event->data.rxtx.bytes);
+        } else if (serial->parent.open_flag & RT_DEVICE_FLAG_INT_RX) {
+            /* the RX is aborted by error, start new rx */
+            nrf_drv_uart_rx(uart->device, &uart->rx_byte, 1);
+        }
         break;
     }
     }
@@ -130,7 +502,6 @@ static rt_err_t nrf52_configure(struct rt_serial_device *serial, struct serial_c
 static rt_err_t nrf52_control(struct rt_serial_device *serial, int cmd, void *arg)
 {
     struct nrf52_uart* uart = (struct nrf52_uart *)serial->parent.user_data;
-    char ch;
 
     RT_ASSERT(serial != RT_NULL);
     RT_ASSERT(uart != RT_NULL);
@@ -138,12 +509,22 @@ static rt_err_t nrf52_control(struct rt_serial_device *serial, int cmd, void *ar
     switch (cmd)
     {
     case RT_DEVICE_CTRL_CLR_INT:
-        nrf_drv_uart_rx_disable(uart->device);
+        if ((rt_uint32_t) arg == RT_DEVICE_FLAG_DMA_RX) {
+            uart_dma_rx_enabled(serial, uart, false);
+        } else {
+            nrf_drv_uart_rx_disable(uart->device);
+        }
         break;
     case RT_DEVICE_CTRL_SET_INT:
         nrf_drv_uart_rx_enable(uart->device);
         /* start new rx */
-        nrf_drv_uart_rx(uart->device, (uint8_t *) &ch, 1);
+        nrf_drv_uart_rx(uart->device, &uart->rx_byte, 1);
+        break;
+    case RT_DEVICE_CTRL_CONFIG:
+        /* the RX fifo has been created by serial device */
+        if ((rt_uint32_t) arg == RT_DEVICE_FLAG_DMA_RX) {
+            uart_dma_rx_enabled(serial, uart, true);
+        }
         break;
     }
 
@@ -153,28 +534,23 @@ static rt_err_t nrf52_control(struct rt_serial_device *serial, int cmd, void *ar
 static int nrf52_putc(struct rt_serial_device *serial, char ch)
 {
     struct nrf52_uart* uart = (struct nrf52_uart *)serial->parent.user_data;
+    rt_base_t level;
+    int result = 0;
 
     RT_ASSERT(serial != RT_NULL);
     RT_ASSERT(uart != RT_NULL);
 
+    level = rt_hw_interrupt_disable();
     /* save data to ringbuffer first */
     if (rt_ringbuffer_putchar(&uart->tx_rb, ch)) {
-        // The new byte has been added to ringbuffer. It will be picked up from there
-        // (in 'uart_event_handler') when all preceding bytes are transmitted.
-        // But if UART is not transmitting anything at the moment, we must start
-        // a new transmission here.
-        if (!nrf_drv_uart_tx_in_progress(uart->device)) {
-            // This operation should be almost always successful, since we've
-            // just added a byte to ringbuffer, but if some bigger delay occurred
-            // (some heavy interrupt handler routine has been executed) since
-            // that time, ringbuffer might be empty already.
-            if (rt_ringbuffer_getchar(&uart->tx_rb, (rt_uint8_t *)&ch) > 0) {
-                nrf_drv_uart_tx(uart->device, (uint8_t *) &(ch), 1);
-                return 1;
-            }
-        }
+        /* The new byte will be sent with all following bytes in one transfer when UART is idle. Otherwise
+         * it will be picked up from ringbuffer (in 'uart_event_handler') when preceding transfer is done. */
+        uart_tx_start(uart);
+        result = 1;
     }
-    return 0;
+    rt_hw_interrupt_enable(level);
+
+    return result;
 }
 
 static int nrf52_getc(struct rt_serial_device *serial)
@@ -192,10 +568,10 @@ static int nrf52_getc(struct rt_serial_device *serial)
             ch = uart->recved_data;
             uart->has_recved = false;
             /* start new rx */
-            nrf_drv_uart_rx(uart->device, (uint8_t *) &ch, 1);
+            nrf_drv_uart_rx(uart->device, &uart->rx_byte, 1);
         }
     } else if (serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX) {
-        /* DMA reading */
+        /* DMA reading, the received data is reported by RT_SERIAL_EVENT_RX_DMADONE */
     } else {
         /* poll reading */
         nrf_drv_uart_rx(uart->device, (uint8_t *) &ch, 1);
@@ -204,12 +580,36 @@ static int nrf52_getc(struct rt_serial_device *serial)
     return ch;
 }
 
+static rt_size_t nrf52_dma_transmit(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size, int direction)
+{
+    struct nrf52_uart* uart = (struct nrf52_uart *)serial->parent.user_data;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(uart != RT_NULL);
+
+    if (direction == RT_SERIAL_DMA_TX) {
+        level = rt_hw_interrupt_disable();
+        RT_ASSERT(uart->dma_tx_buf == RT_NULL);
+        /* the data will be sent by EasyDMA in one or more transfers, then RT_SERIAL_EVENT_TX_DMADONE */
+        uart->dma_tx_buf = buf;
+        uart->dma_tx_size = size;
+        uart->dma_tx_sent = 0;
+        uart_tx_start(uart);
+        rt_hw_interrupt_enable(level);
+        return size;
+    }
+
+    return 0;
+}
+
 static const struct rt_uart_ops nrf52_uart_ops =
 {
     nrf52_configure,
     nrf52_control,
     nrf52_putc,
     nrf52_getc,
+    nrf52_dma_transmit,
 };
 
 #if defined(RT_USING_UART0)
@@ -220,12 +620,24 @@ struct nrf52_uart uart0 =
     &uart0_dev,
 };
 struct rt_serial_device serial0;
+
+void UART0_DMA_RX_TIMER_IRQHandler(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    uart_dma_rx_wakeup(&uart0);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
 #endif /* RT_USING_UART0 */
 
 int rt_hw_uart_init(void)
 {
     struct nrf52_uart *uart;
     struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    rt_uint32_t flag;
 
 #ifdef RT_USING_UART0
     uart = &uart0;
@@ -234,12 +646,20 @@ int rt_hw_uart_init(void)
     serial0.config = config;
 
     rt_ringbuffer_init(&(uart->tx_rb), uart->tx_buffer, sizeof(uart->tx_buffer));
+    uart->rx_counter = UART0_DMA_RX_TIMER;
+    uart->rx_counter_irqn = UART0_DMA_RX_TIMER_IRQn;
+    uart->rx_counter_ppi_ch = UART0_DMA_RX_PPI_CH;
+
+    flag = RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX;
+#ifdef RT_USING_UART0_DMA_RX
+    flag |= RT_DEVICE_FLAG_DMA_RX;
+#endif
+#ifdef RT_USING_UART0_DMA_TX
+    flag |= RT_DEVICE_FLAG_DMA_TX;
+#endif
 
     /* register UART0 device */
-    rt_hw_serial_register(&serial0,
-                          "uart0",
-                          RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
-                          uart);
+    rt_hw_serial_register(&serial0, "uart0", flag, uart);
 #endif /* RT_USING_UART0 */
 
     return 0;
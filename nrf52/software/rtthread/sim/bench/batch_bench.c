@@ -0,0 +1,213 @@
+/*
+ * File      : batch_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the single and batch send of mailbox and message queue
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_HOOK) && defined (RT_USING_MAILBOX) \
+    && defined (RT_USING_MESSAGEQUEUE)
+#include <finsh.h>
+
+/* the burst of pipeline stage */
+#define BATCH_BENCH_BURST              32
+#define BATCH_BENCH_QUEUE_SIZE         64
+#define BATCH_BENCH_MSG_SIZE           16
+/* the consumer preempts the producer, like the next stage of pipeline */
+#define BATCH_BENCH_PRODUCER_PRIORITY  21
+#define BATCH_BENCH_CONSUMER_PRIORITY  20
+
+enum batch_bench_ipc
+{
+    BATCH_BENCH_MB,
+    BATCH_BENCH_MQ,
+};
+
+static struct rt_mailbox bench_mb;
+static rt_uint32_t bench_mb_pool[BATCH_BENCH_QUEUE_SIZE];
+static struct rt_messagequeue bench_mq;
+static rt_uint8_t bench_mq_pool[BATCH_BENCH_QUEUE_SIZE * (BATCH_BENCH_MSG_SIZE + sizeof(void *))];
+static struct rt_semaphore bench_done;
+static enum batch_bench_ipc bench_ipc;
+static rt_bool_t bench_batch;
+static rt_uint32_t bench_count, bench_error;
+static volatile rt_uint32_t bench_switch;
+
+static void batch_bench_scheduler_hook(rt_thread_t from, rt_thread_t to)
+{
+    bench_switch ++;
+}
+
+/* the message is the sequence number, so the consumer checks the order */
+static void batch_bench_producer(void *parameter)
+{
+    rt_uint32_t burst[BATCH_BENCH_BURST][BATCH_BENCH_MSG_SIZE / sizeof(rt_uint32_t)];
+    rt_uint32_t mails[BATCH_BENCH_BURST];
+    rt_uint32_t sequence = 0, count, sent, i;
+
+    while (sequence < bench_count)
+    {
+        count = bench_count - sequence;
+        if (count > BATCH_BENCH_BURST)
+            count = BATCH_BENCH_BURST;
+        for (i = 0; i < count; i++)
+            mails[i] = burst[i][0] = sequence + i;
+
+        if (bench_ipc == BATCH_BENCH_MB)
+        {
+            if (bench_batch)
+            {
+                for (i = 0; i < count; i += sent)
+                    sent = rt_mb_send_n(&bench_mb, &mails[i], count - i, RT_WAITING_FOREVER);
+            }
+            else
+            {
+                for (i = 0; i < count; i++)
+                    rt_mb_send_wait(&bench_mb, mails[i], RT_WAITING_FOREVER);
+            }
+        }
+        else
+        {
+            if (bench_batch)
+            {
+                for (i = 0; i < count; i += sent)
+                {
+                    sent = rt_mq_send_n(&bench_mq, burst[i], sizeof(burst[i]), count - i);
+                    if (sent == 0)
+                        rt_thread_delay(1);
+                }
+            }
+            else
+            {
+                for (i = 0; i < count; i++)
+                {
+                    while (rt_mq_send(&bench_mq, burst[i], sizeof(burst[i])) != RT_EOK)
+                        rt_thread_delay(1);
+                }
+            }
+        }
+        sequence += count;
+    }
+}
+
+static void batch_bench_consumer(void *parameter)
+{
+    rt_uint32_t burst[BATCH_BENCH_BURST][BATCH_BENCH_MSG_SIZE / sizeof(rt_uint32_t)];
+    rt_uint32_t mails[BATCH_BENCH_BURST];
+    rt_uint32_t sequence = 0, count, i;
+
+    while (sequence < bench_count)
+    {
+        if (bench_ipc == BATCH_BENCH_MB)
+        {
+            if (bench_batch)
+            {
+                count = rt_mb_recv_n(&bench_mb, mails, BATCH_BENCH_BURST, RT_WAITING_FOREVER);
+            }
+            else
+            {
+                rt_mb_recv(&bench_mb, &mails[0], RT_WAITING_FOREVER);
+                count = 1;
+            }
+            for (i = 0; i < count; i++)
+                burst[i][0] = mails[i];
+        }
+        else
+        {
+            if (bench_batch)
+            {
+                count = rt_mq_recv_n(&bench_mq, burst, sizeof(burst[0]), BATCH_BENCH_BURST, RT_WAITING_FOREVER);
+            }
+            else
+            {
+                rt_mq_recv(&bench_mq, burst[0], sizeof(burst[0]), RT_WAITING_FOREVER);
+                count = 1;
+            }
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            if (burst[i][0] != sequence + i)
+                bench_error ++;
+        }
+        sequence += count;
+    }
+
+    rt_sem_release(&bench_done);
+}
+
+static void batch_bench_run(enum batch_bench_ipc ipc, rt_bool_t batch, rt_uint32_t count)
+{
+    struct timespec start, end;
+    unsigned long long ns;
+    rt_thread_t producer, consumer;
+
+    rt_mb_init(&bench_mb, "bbench", bench_mb_pool, BATCH_BENCH_QUEUE_SIZE, RT_IPC_FLAG_FIFO);
+    rt_mq_init(&bench_mq, "bbench", bench_mq_pool, BATCH_BENCH_MSG_SIZE, sizeof(bench_mq_pool), RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_done, "bbench", 0, RT_IPC_FLAG_FIFO);
+    bench_ipc = ipc;
+    bench_batch = batch;
+    bench_count = count;
+    bench_error = 0;
+
+    consumer = rt_thread_create("bbrecv", batch_bench_consumer, RT_NULL, 2048, BATCH_BENCH_CONSUMER_PRIORITY, 10);
+    producer = rt_thread_create("bbsend", batch_bench_producer, RT_NULL, 2048, BATCH_BENCH_PRODUCER_PRIORITY, 10);
+    RT_ASSERT(consumer != RT_NULL && producer != RT_NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bench_switch = 0;
+    rt_scheduler_sethook(batch_bench_scheduler_hook);
+    rt_thread_startup(consumer);
+    rt_thread_startup(producer);
+    rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    rt_scheduler_sethook(RT_NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    rt_kprintf("%-7s | %-6s | %7d | %10d | %8d | %6d.%02d | %d\n", ipc == BATCH_BENCH_MB ? "mailbox" : "msg",
+               batch ? "batch" : "single", count, (rt_uint32_t)(count * 1000000000ULL / ns),
+               (rt_uint32_t)(ns / count), bench_switch / count, bench_switch * 100 / count % 100, bench_error);
+
+    /* wait the producer exit */
+    rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    rt_sem_detach(&bench_done);
+    rt_mq_detach(&bench_mq);
+    rt_mb_detach(&bench_mb);
+}
+
+static void batch_bench(int argc, char **argv)
+{
+    rt_uint32_t count = 200000;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: batch_bench [count]\n");
+        return;
+    }
+
+    rt_kprintf("IPC batch bench, burst of %d items, %d items in queue.\n", BATCH_BENCH_BURST,
+               BATCH_BENCH_QUEUE_SIZE);
+    rt_kprintf("ipc     | api    |   count | items (/s) | ns/item  | switch/item | out of order\n");
+    rt_kprintf("------- | ------ | ------- | ---------- | -------- | ----------- | ------------\n");
+    batch_bench_run(BATCH_BENCH_MB, RT_FALSE, count);
+    batch_bench_run(BATCH_BENCH_MB, RT_TRUE, count);
+    batch_bench_run(BATCH_BENCH_MQ, RT_FALSE, count);
+    batch_bench_run(BATCH_BENCH_MQ, RT_TRUE, count);
+}
+MSH_CMD_EXPORT(batch_bench, Measure the single and batch send and receive of mailbox and message queue);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_HOOK) && defined (RT_USING_MAILBOX) ... */
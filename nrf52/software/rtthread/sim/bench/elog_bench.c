@@ -0,0 +1,899 @@
+/*
+ * File      : elog_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, check the asynchronous output ring of EasyLogger on overflow
+ * 2026-10-17     agent        measure the caller latency of the asynchronous output thread
+ * 2026-10-17     agent        check the interrupt log when the line buffer pool is used by threads
+ * 2026-10-17     agent        check and measure the log prefix cache
+ * 2026-10-17     agent        check the tag and keyword filter, and the tag level filter
+ * 2026-10-17     agent        decode the binary log by the host decoder tool and check it
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <board.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOG_TAG                        "elog_bench"
+#include <elog.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_DEVICE) && defined (ELOG_OUTPUT_ENABLE)
+#include <finsh.h>
+
+/* the producers of bench line, they are named from 'A' */
+#define ELOG_BENCH_PRODUCER_MAX        8
+/* the interrupt which logs, it calls kernel so it's lower than the board interrupts */
+#define ELOG_BENCH_IRQ                 5
+#define ELOG_BENCH_IRQ_PERIOD_US       50
+#define ELOG_BENCH_PRIORITY            20
+
+#define ELOG_BENCH_RING_THREADS        2
+/* the bits of a byte on UART */
+#define ELOG_BENCH_UART_BITS           10
+
+/* the tags of the prefix bench, the last one is as long as the tag filter */
+static const char *const bench_tags[] =
+{
+    LOG_TAG, "a", "tag_of_16_chars_",
+};
+
+/* the console output is checked line by line instead of written to the terminal */
+struct elog_bench_sink
+{
+    rt_size_t bytes;
+    /* the output is paced like UART at the baud rate, 0: unlimited */
+    rt_uint32_t baud;
+    char line[ELOG_LINE_BUF_SIZE + 1];
+    rt_size_t line_len;
+    /* the last sequence number which is output by every producer */
+    rt_uint32_t last[ELOG_BENCH_PRODUCER_MAX];
+    rt_uint32_t received[ELOG_BENCH_PRODUCER_MAX];
+    rt_uint32_t disordered[ELOG_BENCH_PRODUCER_MAX];
+};
+
+static struct elog_bench_sink bench_sink;
+static rt_size_t (*bench_console_write)(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+static volatile rt_bool_t bench_running;
+static volatile rt_uint32_t bench_exited;
+static rt_uint32_t bench_lines, bench_burst, bench_isr_id;
+static rt_uint32_t bench_logged[ELOG_BENCH_PRODUCER_MAX];
+static rt_uint32_t bench_seed, bench_args;
+
+static long long elog_bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/* the bench line has a "#<producer><sequence number>" mark, the line which is cut by dropping has no mark */
+static void elog_bench_parse(const char *line)
+{
+    const char *mark;
+    rt_uint32_t id, seq, i;
+
+    for (mark = strchr(line, '#'); mark != RT_NULL; mark = strchr(mark + 1, '#'))
+    {
+        if (mark[1] < 'A' || mark[1] >= 'A' + ELOG_BENCH_PRODUCER_MAX)
+            continue;
+        for (i = 0, seq = 0; i < 8 && mark[2 + i] >= '0' && mark[2 + i] <= '9'; i++)
+            seq = seq * 10 + mark[2 + i] - '0';
+        if (i < 8 || (mark[10] >= '0' && mark[10] <= '9'))
+            continue;
+
+        id = mark[1] - 'A';
+        bench_sink.received[id] ++;
+        if (seq <= bench_sink.last[id])
+            bench_sink.disordered[id] ++;
+        bench_sink.last[id] = seq;
+    }
+}
+
+static rt_size_t elog_bench_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    const char *data = buffer;
+    rt_size_t i;
+    rt_base_t level;
+    long long end;
+
+    /* wait the UART sends the bytes, the interrupts are served meanwhile */
+    if (bench_sink.baud)
+    {
+        end = elog_bench_now() + size * ELOG_BENCH_UART_BITS * 1000000000LL / bench_sink.baud;
+        while (elog_bench_now() < end)
+        {
+            level = rt_hw_interrupt_disable();
+            rt_hw_interrupt_enable(level);
+        }
+    }
+
+    bench_sink.bytes += size;
+    for (i = 0; i < size; i++)
+    {
+        if (bench_sink.line_len < sizeof(bench_sink.line) - 1)
+            bench_sink.line[bench_sink.line_len++] = data[i];
+        if (data[i] == '\n')
+        {
+            /* the line is kept until the next write, so the synchronous log can be read after it's returned */
+            bench_sink.line[bench_sink.line_len] = '\0';
+            elog_bench_parse(bench_sink.line);
+            bench_sink.line_len = 0;
+        }
+    }
+
+    return size;
+}
+
+/* the console isn't reopened, so the shell keeps its RX mode */
+static rt_bool_t elog_bench_capture(rt_bool_t enable)
+{
+    rt_device_t console = rt_console_get_device();
+
+    if (console == RT_NULL)
+        return RT_FALSE;
+
+    if (enable)
+    {
+        rt_memset(&bench_sink, 0, sizeof(bench_sink));
+        bench_console_write = console->write;
+        console->write = elog_bench_write;
+    }
+    else
+    {
+        console->write = bench_console_write;
+    }
+
+    return RT_TRUE;
+}
+
+/* the host thread triggers the logging interrupt periodically */
+static void *elog_bench_host_entry(void *parameter)
+{
+    while (bench_running)
+    {
+        rt_hw_sim_interrupt_trigger(ELOG_BENCH_IRQ);
+        usleep(ELOG_BENCH_IRQ_PERIOD_US);
+    }
+
+    return RT_NULL;
+}
+
+static void elog_bench_isr(void)
+{
+    rt_interrupt_enter();
+    log_w("#%c%08d", 'A' + bench_isr_id, ++bench_logged[bench_isr_id]);
+    rt_interrupt_leave();
+}
+
+/* wait the asynchronous output thread drains the ring */
+static void elog_bench_drain(void)
+{
+    rt_size_t bytes;
+
+    do
+    {
+        bytes = bench_sink.bytes;
+        rt_thread_delay(rt_tick_from_millisecond(20));
+    } while (bytes != bench_sink.bytes);
+}
+
+static void elog_bench_producer(void *parameter)
+{
+    rt_uint32_t id = (rt_uint32_t)(rt_ubase_t)parameter, i;
+
+    for (i = 1; i <= bench_lines; i++)
+    {
+        bench_logged[id] = i;
+        log_w("#%c%08d", 'A' + id, i);
+        /* the burst of log, the output thread runs when the producers sleep */
+        if (bench_burst && i % bench_burst == 0)
+            rt_thread_delay(1);
+    }
+
+    bench_exited ++;
+}
+
+/* the threads log the bench lines, and the interrupt logs until they are done */
+static void elog_bench_produce(rt_uint32_t threads, rt_uint32_t tick)
+{
+    pthread_t host;
+    rt_thread_t thread;
+    rt_uint32_t i;
+
+    rt_memset(bench_logged, 0, sizeof(bench_logged));
+    bench_isr_id = threads;
+    bench_running = RT_TRUE;
+    bench_exited = 0;
+
+    rt_hw_sim_interrupt_install(ELOG_BENCH_IRQ, elog_bench_isr);
+    for (i = 0; i < threads; i++)
+    {
+        thread = rt_thread_create("elogbnch", elog_bench_producer, (void *)(rt_ubase_t)i, 2048,
+                                  ELOG_BENCH_PRIORITY, tick);
+        RT_ASSERT(thread != RT_NULL);
+        rt_thread_startup(thread);
+    }
+    pthread_create(&host, RT_NULL, elog_bench_host_entry, RT_NULL);
+
+    while (bench_exited < threads)
+        rt_thread_delay(10);
+
+    bench_running = RT_FALSE;
+    pthread_join(host, RT_NULL);
+    rt_hw_sim_interrupt_install(ELOG_BENCH_IRQ, RT_NULL);
+    elog_bench_drain();
+}
+
+static void elog_bench_report(void)
+{
+    rt_uint32_t i;
+
+    rt_kprintf("producer    | logged | output | lost   | disordered\n");
+    rt_kprintf("----------- | ------ | ------ | ------ | ----------\n");
+    for (i = 0; i <= bench_isr_id; i++)
+    {
+        rt_kprintf("%-9s %c | %6d | %6d | %6d | %d\n", i < bench_isr_id ? "thread" : "interrupt", 'A' + i,
+                   bench_logged[i], bench_sink.received[i], bench_logged[i] - bench_sink.received[i],
+                   bench_sink.disordered[i]);
+    }
+}
+
+/* the threads are preempted while they format log in the pool buffers, then the interrupt log has no buffer */
+static void elog_bench_pool(int argc, char **argv)
+{
+    rt_uint32_t threads = 4, logged = 0, received = 0, i;
+    rt_size_t dropped_line;
+    long long ns;
+
+    bench_lines = 5000;
+    if (argc > 2)
+        bench_lines = atoi(argv[2]);
+    if (argc > 3)
+        threads = atoi(argv[3]);
+    if (bench_lines == 0 || threads == 0 || threads >= ELOG_BENCH_PRODUCER_MAX)
+    {
+        rt_kprintf("Usage: elog_bench pool [lines of each thread] [threads, 1 to %d]\n", ELOG_BENCH_PRODUCER_MAX - 1);
+        return;
+    }
+    if (!elog_bench_capture(RT_TRUE))
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    /* the synchronous output, so every line of thread must be output */
+    elog_async_enabled(false);
+#endif
+    bench_burst = 0;
+    dropped_line = elog_get_dropped_line_num();
+    ns = elog_bench_now();
+    /* the time slice is 1 tick, so the threads are switched in formatting */
+    elog_bench_produce(threads, 1);
+    ns = elog_bench_now() - ns;
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(true);
+#endif
+    elog_bench_capture(RT_FALSE);
+
+    dropped_line = elog_get_dropped_line_num() - dropped_line;
+    for (i = 0; i <= bench_isr_id; i++)
+    {
+        logged += bench_logged[i];
+        received += bench_sink.received[i];
+    }
+
+    rt_kprintf("Elog line buffer pool bench, %d threads log %d lines, an interrupt logs per %d us, %d buffers in pool.\n",
+               threads, bench_lines, ELOG_BENCH_IRQ_PERIOD_US, ELOG_LINE_BUF_POOL_NUM);
+    elog_bench_report();
+    rt_kprintf("%d lines per second, %d lines dropped in interrupt by the empty pool.\n",
+               (rt_uint32_t)(logged * 1000000000LL / ns), dropped_line);
+    rt_kprintf("The lost lines are %s the dropped lines.\n",
+               logged - received == dropped_line ? "equal to" : "NOT equal to");
+}
+
+#if defined (ELOG_COLOR_ENABLE) && (ELOG_PREFIX_CACHE_NUM > 0)
+/* the prefix cache is cleaned when the prefix format is changed */
+static void elog_bench_prefix_clean(void)
+{
+    elog_set_text_color_enabled(elog_get_text_color_enabled());
+}
+
+/* all bench lines are logged on the same line of file, so only the time differs */
+static void elog_bench_prefix_log(uint8_t level, const char *tag, rt_uint32_t seq)
+{
+    char *time;
+
+    elog_output(level, tag, __FILE__, __FUNCTION__, __LINE__, "#%c%08d", 'A', seq);
+    time = strstr(bench_sink.line, "tick:");
+    if (time != RT_NULL)
+        rt_memset(time + 5, '0', 10);
+}
+
+/* the prefix is packaged on every line when the cache is cleaned before it, the levels and tags fit in cache */
+static rt_uint32_t elog_bench_prefix_run(rt_uint32_t count, rt_bool_t clean, rt_bool_t output)
+{
+    rt_uint32_t i, pair, pairs, tags = sizeof(bench_tags) / sizeof(bench_tags[0]), lines = 0;
+    long long ns;
+
+    pairs = ELOG_LVL_TOTAL_NUM * tags;
+    if (pairs > ELOG_PREFIX_CACHE_NUM)
+        pairs = ELOG_PREFIX_CACHE_NUM;
+    ns = elog_bench_now();
+    for (i = 0; i < count; i++)
+    {
+        for (pair = 0; pair < pairs; pair++)
+        {
+            if (clean)
+                elog_bench_prefix_clean();
+            if (output)
+                elog_bench_prefix_log(ELOG_LVL_ASSERT + pair / tags, bench_tags[pair % tags], ++lines);
+        }
+    }
+    ns = elog_bench_now() - ns;
+
+    return (rt_uint32_t)(ns / (count * pairs));
+}
+
+static void elog_bench_prefix(int argc, char **argv)
+{
+    char packaged[ELOG_LINE_BUF_SIZE + 1], tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+    rt_uint32_t count = 20000, checked = 0, differ = 0, level, i, cached_ns, packaged_ns, clean_ns;
+    rt_bool_t stale;
+
+    if (argc > 2)
+        count = atoi(argv[2]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: elog_bench prefix [rounds]\n");
+        return;
+    }
+    if (!elog_bench_capture(RT_TRUE))
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(false);
+#endif
+
+    /* the line with the packaged prefix is same as the next line with the cached prefix */
+    for (level = ELOG_LVL_ASSERT; level <= ELOG_LVL_VERBOSE; level++)
+    {
+        for (i = 0; i < sizeof(bench_tags) / sizeof(bench_tags[0]); i++)
+        {
+            elog_bench_prefix_clean();
+            elog_bench_prefix_log(level, bench_tags[i], 0);
+            rt_strncpy(packaged, bench_sink.line, sizeof(packaged));
+            elog_bench_prefix_log(level, bench_tags[i], 0);
+            if (strcmp(packaged, bench_sink.line))
+                differ ++;
+            checked ++;
+        }
+    }
+
+    /* no line has this keyword, so the line is formatted but not output, the flash log isn't measured */
+    elog_set_filter_kw("#Z");
+    elog_bench_prefix_clean();
+    elog_bench_prefix_run(1, RT_FALSE, RT_TRUE);
+    cached_ns = elog_bench_prefix_run(count, RT_FALSE, RT_TRUE);
+    packaged_ns = elog_bench_prefix_run(count, RT_TRUE, RT_TRUE);
+    clean_ns = elog_bench_prefix_run(count, RT_TRUE, RT_FALSE);
+    elog_set_filter_kw("");
+
+    /* the tag buffer is reused with another contents after its prefix is cached */
+    rt_strncpy(tag, "AAA", sizeof(tag));
+    elog_bench_prefix_log(ELOG_LVL_WARN, tag, 0);
+    rt_strncpy(tag, "BBBB", sizeof(tag));
+    elog_bench_prefix_log(ELOG_LVL_WARN, tag, 0);
+    stale = strstr(bench_sink.line, "W/BBBB ") == RT_NULL;
+    elog_bench_prefix_clean();
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(true);
+#endif
+    elog_bench_capture(RT_FALSE);
+
+    rt_kprintf("Elog prefix cache bench, %d levels and %d tags, %d cache entries of %d bytes.\n", ELOG_LVL_TOTAL_NUM,
+               sizeof(bench_tags) / sizeof(bench_tags[0]), ELOG_PREFIX_CACHE_NUM, ELOG_PREFIX_CACHE_LEN);
+    rt_kprintf("prefix   | ns / line\n");
+    rt_kprintf("-------- | ---------\n");
+    rt_kprintf("cached   | %d\n", cached_ns);
+    rt_kprintf("packaged | %d\n", packaged_ns > clean_ns ? packaged_ns - clean_ns : 0);
+    rt_kprintf("%d lines of cached prefix are compared with the packaged prefix, %d differ.\n", checked, differ);
+    rt_kprintf("The reused tag buffer is output with %s prefix.\n", stale ? "a stale" : "its current");
+}
+#endif /* defined (ELOG_COLOR_ENABLE) && (ELOG_PREFIX_CACHE_NUM > 0) */
+
+static rt_uint32_t elog_bench_rand(void)
+{
+    bench_seed = bench_seed * 1103515245 + 12345;
+
+    return bench_seed >> 16;
+}
+
+/* the random string of 'a' and 'b', it has many partial matches */
+static void elog_bench_random(char *buf, rt_size_t min, rt_size_t max)
+{
+    rt_size_t i, len = min + elog_bench_rand() % (max - min + 1);
+
+    for (i = 0; i < len; i++)
+        buf[i] = "aab"[elog_bench_rand() % 3];
+    buf[len] = '\0';
+}
+
+static int elog_bench_arg(void)
+{
+    return ++bench_args;
+}
+
+static rt_bool_t elog_bench_filter_output(const char *tag, const char *text)
+{
+    rt_size_t bytes = bench_sink.bytes;
+
+    elog_w(tag, "%s", text);
+
+    return bench_sink.bytes != bytes;
+}
+
+/* the time of a log call which isn't output */
+static rt_uint32_t elog_bench_filter_run(rt_uint32_t count, int level)
+{
+    rt_uint32_t i;
+    long long ns;
+
+    ns = elog_bench_now();
+    for (i = 0; i < count; i++)
+    {
+        if (level == ELOG_LVL_DEBUG)
+            log_d("#%c%08d", 'A', elog_bench_arg());
+        else
+            log_w("#%c%08d", 'A', elog_bench_arg());
+    }
+    ns = elog_bench_now() - ns;
+
+    return (rt_uint32_t)(ns / count);
+}
+
+/* the KMP match of the tag and keyword filter is checked against strstr on the same line */
+static void elog_bench_filter(int argc, char **argv)
+{
+    char line[ELOG_LINE_BUF_SIZE + 1], text[48], tag[ELOG_FILTER_TAG_MAX_LEN / 2 + 1];
+    char pattern[ELOG_FILTER_KW_MAX_LEN + 1];
+    rt_uint32_t count = 1000, i, kw_wrong = 0, tag_wrong = 0;
+    rt_uint32_t tag_ns, tag_args, kw_ns, kw_args;
+    rt_size_t len;
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    ElogTagLvl saved = elog_tag_lvl;
+    /* the tag without an explicit level follows the global level */
+    uint8_t global = saved.level_is_set ? ELOG_LVL_VERBOSE : saved.level;
+    rt_uint32_t lvl_ns, lvl_args;
+    rt_size_t files;
+    rt_bool_t kept;
+#endif
+
+    if (argc > 2)
+        count = atoi(argv[2]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: elog_bench filter [cases]\n");
+        return;
+    }
+    if (!elog_bench_capture(RT_TRUE))
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(false);
+#endif
+
+    bench_seed = 1;
+    for (i = 0; i < count; i++)
+    {
+        /* the keyword is matched on the whole line without newline */
+        elog_bench_random(text, 0, sizeof(text) - 1);
+        elog_bench_random(pattern, 1, 6);
+        elog_set_filter_kw("");
+        elog_bench_filter_output(LOG_TAG, text);
+        rt_strncpy(line, bench_sink.line, sizeof(line));
+        len = rt_strlen(line);
+        if (len >= rt_strlen(ELOG_NEWLINE_SIGN))
+            line[len - rt_strlen(ELOG_NEWLINE_SIGN)] = '\0';
+        elog_set_filter_kw(pattern);
+        if (elog_bench_filter_output(LOG_TAG, text) != (strstr(line, pattern) != RT_NULL))
+            kw_wrong ++;
+        elog_set_filter_kw("");
+
+        elog_bench_random(tag, 1, sizeof(tag) - 1);
+        elog_bench_random(pattern, 1, 4);
+        elog_set_filter_tag(pattern);
+        if (elog_bench_filter_output(tag, "tag") != (strstr(tag, pattern) != RT_NULL))
+            tag_wrong ++;
+        elog_set_filter_tag("");
+    }
+
+    /* the tag filter rejects the line before it's formatted, the keyword filter after it */
+    elog_set_filter_tag("#Z");
+    bench_args = 0;
+    tag_ns = elog_bench_filter_run(count * 100, ELOG_LVL_WARN);
+    tag_args = bench_args;
+    elog_set_filter_tag("");
+    elog_set_filter_kw("#Z");
+    bench_args = 0;
+    kw_ns = elog_bench_filter_run(count * 100, ELOG_LVL_WARN);
+    kw_args = bench_args;
+    elog_set_filter_kw("");
+
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    /* the disabled log site checks the tag level before the arguments are evaluated */
+    files = elog_set_filter_tag_lvl(LOG_TAG, ELOG_LVL_INFO);
+    bench_args = 0;
+    lvl_ns = elog_bench_filter_run(count * 100, ELOG_LVL_DEBUG);
+    lvl_args = bench_args;
+    /* the tag level which is set is kept when the global level is changed */
+    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    kept = elog_tag_lvl.level == ELOG_LVL_INFO;
+    bench_args = 0;
+    elog_bench_filter_run(1, ELOG_LVL_DEBUG);
+    kept = kept && bench_args == 0;
+    elog_set_filter_lvl(ELOG_LVL_ERROR);
+    kept = kept && elog_bench_filter_output(LOG_TAG, "level");
+    elog_tag_lvl = saved;
+    elog_set_filter_lvl(global);
+#endif
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(true);
+#endif
+    elog_bench_capture(RT_FALSE);
+
+    rt_kprintf("Elog filter bench, %d random keywords and tags of 'a' and 'b' are checked against strstr.\n", count);
+    rt_kprintf("filter  | checked | wrong\n");
+    rt_kprintf("------- | ------- | -----\n");
+    rt_kprintf("keyword | %7d | %d\n", count, kw_wrong);
+    rt_kprintf("tag     | %7d | %d\n", count, tag_wrong);
+    rt_kprintf("log site rejected by | ns / call | arguments evaluated\n");
+    rt_kprintf("-------------------- | --------- | -------------------\n");
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    rt_kprintf("tag level            | %9d | %d\n", lvl_ns, lvl_args);
+#endif
+    rt_kprintf("tag filter           | %9d | %d\n", tag_ns, tag_args);
+    rt_kprintf("keyword filter       | %9d | %d\n", kw_ns, kw_args);
+#ifdef ELOG_FILTER_TAG_LVL_ENABLE
+    rt_kprintf("The level of tag %s is set in %d files, it's %s when the global level is changed.\n", LOG_TAG, files,
+               kept ? "kept" : "NOT kept");
+#endif
+}
+
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+/* the host decoder tool of binary log, it's found by the path of simulator: sim/build/rtthread-sim */
+#define ELOG_BENCH_BIN_DECODER         "/../../components/elog/tools/elog_bin_decode.py"
+#define ELOG_BENCH_BIN_CASES           10
+#define ELOG_BENCH_BIN_TEXT            "the text log between the binary logs"
+
+/* the binary log is logged and formatted by snprintf as the expected line of decoder */
+#define ELOG_BENCH_BIN(...)                                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        log_bin(ELOG_LVL_INFO, __VA_ARGS__);                                                \
+        snprintf(bench_bin_expected[bench_bin_cases++], ELOG_LINE_BUF_SIZE, __VA_ARGS__);   \
+    } while (0)
+
+/* the bytes of the uart, they are after the stream mode of serial device */
+static rt_uint8_t bench_bin_wire[4096];
+static rt_size_t bench_bin_wire_len;
+static char bench_bin_expected[ELOG_BENCH_BIN_CASES][ELOG_LINE_BUF_SIZE];
+static rt_uint32_t bench_bin_cases;
+
+static int elog_bench_bin_putc(struct rt_serial_device *serial, char c)
+{
+    if (bench_bin_wire_len < sizeof(bench_bin_wire))
+        bench_bin_wire[bench_bin_wire_len++] = c;
+
+    return 1;
+}
+
+/* the binary log is captured on the uart, so the newline of the stream mode is converted as on the target */
+static void elog_bench_bin(int argc, char **argv)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *) rt_console_get_device();
+    const struct rt_uart_ops *uart_ops;
+    struct rt_uart_ops bin_ops;
+    char exe[256], path[256], file[] = "/tmp/elog_bench_bin_XXXXXX", command[800];
+    char line[ELOG_LINE_BUF_SIZE + 64], *message;
+    rt_uint32_t records = 0, equal = 0, escaped = 0, text = 0, i;
+    ssize_t exe_len;
+    FILE *decoder;
+    int fd;
+
+    if (serial == RT_NULL)
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+    exe_len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (exe_len <= 0)
+    {
+        rt_kprintf("The simulator path is unknown.\n");
+        return;
+    }
+    exe[exe_len] = '\0';
+    rt_snprintf(path, sizeof(path), "%s", exe);
+    *strrchr(path, '/') = '\0';
+
+    bench_bin_wire_len = 0;
+    bench_bin_cases = 0;
+    uart_ops = serial->ops;
+    bin_ops = *uart_ops;
+    bin_ops.putc = elog_bench_bin_putc;
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(false);
+#endif
+    serial->ops = &bin_ops;
+
+    /* the arguments have the newline, escape sign and sync sign bytes */
+    ELOG_BENCH_BIN("no arguments");
+    ELOG_BENCH_BIN("%d %i", -1, 10);
+    ELOG_BENCH_BIN("%u %x %X", 0xDBu, 0x0A0AA5DBu, 0xA5u);
+    ELOG_BENCH_BIN("%08x|%-6d|%6d", 0xDB, 42, -42);
+    log_i(ELOG_BENCH_BIN_TEXT);
+    ELOG_BENCH_BIN("%c%c%c", 'b', 'i', 'n');
+    ELOG_BENCH_BIN("%s and %s", "constant", LOG_TAG);
+    ELOG_BENCH_BIN("%5s|%-5s|", "ab", "cd");
+    ELOG_BENCH_BIN("%d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 10, -10, 0x0A0A0A0A);
+    ELOG_BENCH_BIN("%%d %d%%", 0xDBDBDBDB);
+
+    serial->ops = uart_ops;
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_enabled(true);
+#endif
+
+    for (i = 0; i < bench_bin_wire_len; i++)
+    {
+        if (bench_bin_wire[i] == ELOG_BIN_ESC_SIGN)
+            escaped ++;
+    }
+
+    fd = mkstemp(file);
+    if (fd < 0 || write(fd, bench_bin_wire, bench_bin_wire_len) != (ssize_t) bench_bin_wire_len)
+    {
+        rt_kprintf("The binary log file can't be written.\n");
+        if (fd >= 0)
+        {
+            close(fd);
+            unlink(file);
+        }
+        return;
+    }
+    close(fd);
+    rt_snprintf(command, sizeof(command), "python3 %s%s %s %s", path, ELOG_BENCH_BIN_DECODER, exe, file);
+    decoder = popen(command, "r");
+    while (decoder != RT_NULL && fgets(line, sizeof(line), decoder) != RT_NULL)
+    {
+        if (strstr(line, ELOG_BENCH_BIN_TEXT) != RT_NULL)
+        {
+            text ++;
+            continue;
+        }
+        if (strncmp(line, "I/" LOG_TAG " [tick:", strlen("I/" LOG_TAG " [tick:")) != 0)
+            continue;
+        message = strstr(line, "] ") + 2;
+        message[strcspn(message, "\n")] = '\0';
+        if (records < bench_bin_cases && !strcmp(message, bench_bin_expected[records]))
+            equal ++;
+        else
+            rt_kprintf("decoded: %s\n", message);
+        records ++;
+    }
+    if (decoder == RT_NULL || pclose(decoder) != 0)
+        rt_kprintf("The decoder %s%s failed.\n", path, ELOG_BENCH_BIN_DECODER);
+    unlink(file);
+
+    rt_kprintf("Elog binary log bench, %d binary logs and a text log are output by the console in stream mode.\n",
+               bench_bin_cases);
+    rt_kprintf("%d bytes on uart, %d bytes escaped, %d records decoded, %d equal to snprintf, text log %s.\n",
+               bench_bin_wire_len, escaped, records, equal, text == 1 ? "kept" : "NOT kept");
+}
+#endif /* ELOG_BIN_OUTPUT_ENABLE */
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+/* the threads and the interrupt log more than the ring holds, the lost log must be counted as dropped */
+static void elog_bench_ring(int argc, char **argv)
+{
+    rt_size_t line_size, dropped_size, dropped_line, logged = 0, expected;
+    rt_uint32_t i;
+
+    bench_lines = 10000;
+    bench_burst = 32;
+    if (argc > 2)
+        bench_lines = atoi(argv[2]);
+    if (argc > 3)
+        bench_burst = atoi(argv[3]);
+    if (bench_lines == 0 || bench_burst == 0)
+    {
+        rt_kprintf("Usage: elog_bench ring [lines of each thread] [lines of each thread per tick]\n");
+        return;
+    }
+    if (!elog_bench_capture(RT_TRUE))
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+
+    /* every bench line has the same size, it's measured by the synchronous output */
+    elog_async_enabled(false);
+    log_w("#%c%08d", 'A', 0);
+    line_size = bench_sink.bytes;
+    elog_async_enabled(true);
+
+    rt_memset(&bench_sink, 0, sizeof(bench_sink));
+    dropped_size = elog_async_get_dropped_size();
+    dropped_line = elog_get_dropped_line_num();
+    elog_bench_produce(ELOG_BENCH_RING_THREADS, 10);
+    elog_bench_capture(RT_FALSE);
+
+    dropped_size = elog_async_get_dropped_size() - dropped_size;
+    dropped_line = elog_get_dropped_line_num() - dropped_line;
+    for (i = 0; i <= bench_isr_id; i++)
+        logged += bench_logged[i];
+    /* the line which is dropped in interrupt never enters the ring */
+    expected = line_size * (logged - dropped_line);
+
+    rt_kprintf("Elog async ring bench, %d threads log %d lines (%d lines per tick), an interrupt logs per %d us.\n",
+               ELOG_BENCH_RING_THREADS, bench_lines, bench_burst, ELOG_BENCH_IRQ_PERIOD_US);
+    elog_bench_report();
+    rt_kprintf("%d bytes per line, %d bytes output, %d bytes dropped by the full ring, "
+               "%d lines dropped in interrupt by the empty pool.\n",
+               line_size, bench_sink.bytes, dropped_size, dropped_line);
+    rt_kprintf("The output and dropped bytes are %s the logged bytes (%d).\n",
+               bench_sink.bytes + dropped_size == expected ? "equal to" : "NOT equal to", expected);
+}
+
+/* the time of a log call on the caller with the synchronous output and the asynchronous output thread */
+static void elog_bench_latency_run(const char *name, rt_bool_t async, rt_uint32_t baud, rt_tick_t interval)
+{
+    rt_uint32_t i, ns, max = 0, lost;
+    unsigned long long sum = 0;
+    long long start;
+
+    rt_memset(&bench_sink, 0, sizeof(bench_sink));
+    bench_sink.baud = baud;
+    elog_async_enabled(async);
+    for (i = 1; i <= bench_lines; i++)
+    {
+        start = elog_bench_now();
+        log_w("#%c%08d", 'A', i);
+        ns = (rt_uint32_t)(elog_bench_now() - start);
+        sum += ns;
+        if (ns > max)
+            max = ns;
+        rt_thread_delay(interval);
+    }
+    elog_bench_drain();
+    elog_async_enabled(true);
+
+    lost = bench_lines - bench_sink.received[0];
+    elog_bench_capture(RT_FALSE);
+    rt_kprintf("%-12s | %8d | %8d | %6d | %d\n", name, (rt_uint32_t)(sum / bench_lines), max,
+               bench_sink.received[0], lost);
+    elog_bench_capture(RT_TRUE);
+}
+
+static void elog_bench_latency(int argc, char **argv)
+{
+    rt_size_t line_size;
+    rt_uint32_t baud = 115200;
+    rt_tick_t interval;
+
+    bench_lines = 200;
+    if (argc > 2)
+        bench_lines = atoi(argv[2]);
+    if (argc > 3)
+        baud = atoi(argv[3]);
+    if (bench_lines == 0 || baud == 0)
+    {
+        rt_kprintf("Usage: elog_bench latency [lines] [baud rate of console]\n");
+        return;
+    }
+    if (!elog_bench_capture(RT_TRUE))
+    {
+        rt_kprintf("No console device.\n");
+        return;
+    }
+
+    elog_async_enabled(false);
+    log_w("#%c%08d", 'A', 0);
+    line_size = bench_sink.bytes;
+    elog_async_enabled(true);
+    /* the line is logged per 2 line times, so the output thread keeps up with it */
+    interval = rt_tick_from_millisecond(line_size * ELOG_BENCH_UART_BITS * 2000 / baud) + 1;
+
+    elog_bench_capture(RT_FALSE);
+    rt_kprintf("Elog caller latency bench, %d lines of %d bytes per %d ticks, the console is paced at %d baud.\n",
+               bench_lines, line_size, interval, baud);
+    rt_kprintf("output       | avg (ns) | max (ns) | output | lost\n");
+    rt_kprintf("------------ | -------- | -------- | ------ | ----\n");
+    elog_bench_capture(RT_TRUE);
+
+    elog_bench_latency_run("synchronous", RT_FALSE, baud, interval);
+    elog_bench_latency_run("asynchronous", RT_TRUE, baud, interval);
+
+    elog_bench_capture(RT_FALSE);
+}
+#endif /* ELOG_ASYNC_OUTPUT_ENABLE */
+
+static void elog_bench(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "";
+
+    if (!strcmp(mode, "filter"))
+    {
+        elog_bench_filter(argc, argv);
+        return;
+    }
+    if (!strcmp(mode, "pool"))
+    {
+        elog_bench_pool(argc, argv);
+        return;
+    }
+#if defined (ELOG_COLOR_ENABLE) && (ELOG_PREFIX_CACHE_NUM > 0)
+    if (!strcmp(mode, "prefix"))
+    {
+        elog_bench_prefix(argc, argv);
+        return;
+    }
+#endif
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+    if (!strcmp(mode, "bin"))
+    {
+        elog_bench_bin(argc, argv);
+        return;
+    }
+#endif
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    if (!strcmp(mode, "ring"))
+    {
+        elog_bench_ring(argc, argv);
+        return;
+    }
+    if (!strcmp(mode, "latency"))
+    {
+        elog_bench_latency(argc, argv);
+        return;
+    }
+#endif
+
+    rt_kprintf("Usage: elog_bench <mode> [options]\n");
+    rt_kprintf("  filter [cases]                 check the tag and keyword filter, and the tag level filter\n");
+    rt_kprintf("  pool [lines] [threads]         check the interrupt log when the line buffer pool is used by threads\n");
+#if defined (ELOG_COLOR_ENABLE) && (ELOG_PREFIX_CACHE_NUM > 0)
+    rt_kprintf("  prefix [rounds]                check and measure the log prefix cache\n");
+#endif
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+    rt_kprintf("  bin                            decode the binary log by the host decoder tool and check it\n");
+#endif
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    rt_kprintf("  ring [lines] [lines per tick]  check the lost log of the full asynchronous ring is dropped\n");
+    rt_kprintf("  latency [lines] [baud]         measure the caller latency of synchronous and asynchronous output\n");
+#endif
+}
+MSH_CMD_EXPORT(elog_bench, Check and measure EasyLogger: filter pool prefix bin ring latency);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_DEVICE) && defined (ELOG_OUTPUT_ENABLE) */
@@ -0,0 +1,304 @@
+/*
+ * File      : heap_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the latency and fragmentation of system heap
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_HEAP)
+#include <finsh.h>
+
+/* the count of live memory blocks in trace file */
+#define HEAP_BENCH_SLOT_MAX            1024
+/* the live memory blocks and operations of the synthetic trace */
+#define HEAP_BENCH_SYNTHETIC_SLOT      128
+#define HEAP_BENCH_OP_COUNT            20000
+/* the latency histogram for the 99th percentile, the max latency is noisy on host */
+#define HEAP_BENCH_HIST_NS             100
+#define HEAP_BENCH_HIST_COUNT          100
+
+#if defined (RT_USING_MEMHEAP_AS_HEAP)
+#define HEAP_BENCH_NAME                "memheap"
+#elif defined (RT_USING_SLAB)
+#define HEAP_BENCH_NAME                "slab"
+#elif defined (RT_USING_TLSF)
+#define HEAP_BENCH_NAME                "TLSF"
+#else
+#define HEAP_BENCH_NAME                "small mem"
+#endif
+
+enum heap_bench_op
+{
+    HEAP_BENCH_MALLOC,
+    HEAP_BENCH_REALLOC,
+    HEAP_BENCH_FREE,
+    HEAP_BENCH_OP_MAX,
+};
+
+struct heap_bench_stat
+{
+    rt_uint32_t count;
+    rt_uint32_t fail;
+    rt_uint32_t max_ns;
+    unsigned long long total_ns;
+    rt_uint32_t hist[HEAP_BENCH_HIST_COUNT];
+};
+
+static void *bench_slot[HEAP_BENCH_SLOT_MAX];
+static struct heap_bench_stat bench_stat[HEAP_BENCH_OP_MAX];
+static rt_uint32_t bench_seed;
+
+static rt_uint32_t heap_bench_rand(void)
+{
+    /* the same LCG on every host, so the synthetic trace is same for each allocator */
+    bench_seed = bench_seed * 1103515245UL + 12345UL;
+
+    return (bench_seed >> 8) & 0xFFFFFF;
+}
+
+/* most of blocks are small, a few of them are large, like the kernel objects and buffers */
+static rt_size_t heap_bench_rand_size(void)
+{
+    rt_uint32_t weight = heap_bench_rand() % 100;
+
+    if (weight < 50)
+        return 8 + heap_bench_rand() % 57;
+    else if (weight < 80)
+        return 65 + heap_bench_rand() % 192;
+    else if (weight < 95)
+        return 257 + heap_bench_rand() % 768;
+    else
+        return 1025 + heap_bench_rand() % 3072;
+}
+
+static rt_uint32_t heap_bench_elapsed_ns(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+
+    return (now.tv_sec - start->tv_sec) * 1000000000UL + now.tv_nsec - start->tv_nsec;
+}
+
+/* run an operation of trace with interrupt disabled, so the tick is not counted in the latency */
+static void heap_bench_op(enum heap_bench_op op, rt_uint32_t slot, rt_size_t size)
+{
+    struct heap_bench_stat *stat = &bench_stat[op];
+    struct timespec start;
+    rt_base_t level;
+    rt_uint32_t elapsed;
+    void *ptr = RT_NULL;
+
+    if (slot >= HEAP_BENCH_SLOT_MAX)
+        return;
+    /* the malloc of a used slot and the free of an empty slot are skipped */
+    if ((op == HEAP_BENCH_MALLOC && bench_slot[slot] != RT_NULL) ||
+        (op == HEAP_BENCH_FREE && bench_slot[slot] == RT_NULL))
+        return;
+
+    level = rt_hw_interrupt_disable();
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    switch (op)
+    {
+    case HEAP_BENCH_MALLOC:
+        ptr = rt_malloc(size);
+        break;
+    case HEAP_BENCH_REALLOC:
+        ptr = rt_realloc(bench_slot[slot], size);
+        break;
+    case HEAP_BENCH_FREE:
+        rt_free(bench_slot[slot]);
+        break;
+    default:
+        break;
+    }
+    elapsed = heap_bench_elapsed_ns(&start);
+    rt_hw_interrupt_enable(level);
+
+    stat->count ++;
+    stat->total_ns += elapsed;
+    if (elapsed > stat->max_ns)
+        stat->max_ns = elapsed;
+    if (elapsed / HEAP_BENCH_HIST_NS < HEAP_BENCH_HIST_COUNT)
+        stat->hist[elapsed / HEAP_BENCH_HIST_NS] ++;
+    else
+        stat->hist[HEAP_BENCH_HIST_COUNT - 1] ++;
+
+    if (op == HEAP_BENCH_FREE)
+        bench_slot[slot] = RT_NULL;
+    else if (ptr != RT_NULL)
+        bench_slot[slot] = ptr;
+    else
+        stat->fail ++;
+}
+
+/* the upper bound of latency which 99% operations are in */
+static rt_uint32_t heap_bench_p99(const struct heap_bench_stat *stat)
+{
+    rt_uint32_t i, count = 0;
+
+    for (i = 0; i < HEAP_BENCH_HIST_COUNT; i++)
+    {
+        count += stat->hist[i];
+        if (count * 100 >= stat->count * 99)
+            break;
+    }
+
+    return (i + 1) * HEAP_BENCH_HIST_NS;
+}
+
+static void heap_bench_synthetic(void)
+{
+    rt_uint32_t i, slot;
+
+    bench_seed = 1;
+    for (i = 0; i < HEAP_BENCH_OP_COUNT; i++)
+    {
+        slot = heap_bench_rand() % HEAP_BENCH_SYNTHETIC_SLOT;
+        if (bench_slot[slot] == RT_NULL)
+            heap_bench_op(HEAP_BENCH_MALLOC, slot, heap_bench_rand_size());
+        else if (heap_bench_rand() % 4 == 0)
+            heap_bench_op(HEAP_BENCH_REALLOC, slot, heap_bench_rand_size());
+        else
+            heap_bench_op(HEAP_BENCH_FREE, slot, 0);
+    }
+}
+
+/**
+ * Replay the trace file, each line is an operation:
+ *   a <slot> <size>   malloc the size to slot
+ *   r <slot> <size>   realloc the slot to size
+ *   f <slot>          free the slot
+ */
+static rt_err_t heap_bench_replay(const char *path)
+{
+    FILE *fp;
+    char line[64], op;
+    unsigned int slot, size;
+
+    fp = fopen(path, "r");
+    if (fp == RT_NULL)
+    {
+        rt_kprintf("Open the trace file %s failed.\n", path);
+        return -RT_ERROR;
+    }
+
+    while (fgets(line, sizeof(line), fp) != RT_NULL)
+    {
+        size = 0;
+        if (sscanf(line, " %c %u %u", &op, &slot, &size) < 2)
+            continue;
+
+        if (op == 'a')
+            heap_bench_op(HEAP_BENCH_MALLOC, slot, size);
+        else if (op == 'r')
+            heap_bench_op(HEAP_BENCH_REALLOC, slot, size);
+        else if (op == 'f')
+            heap_bench_op(HEAP_BENCH_FREE, slot, 0);
+    }
+    fclose(fp);
+
+    return RT_EOK;
+}
+
+static void heap_bench_info(rt_uint32_t *total, rt_uint32_t *used, rt_uint32_t *max_used)
+{
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    struct rt_memheap *heap;
+
+    heap = (struct rt_memheap *)rt_object_find("heap", RT_Object_Class_MemHeap);
+    *total = heap->pool_size;
+    *used = heap->pool_size - heap->available_size;
+    *max_used = heap->max_used_size;
+#else
+    rt_memory_info(total, used, max_used);
+#endif
+}
+
+/* find the largest block which can be allocated by binary search */
+static rt_uint32_t heap_bench_largest(rt_uint32_t free)
+{
+    rt_uint32_t low = 0, high = free, mid;
+    void *ptr;
+
+    while (low < high)
+    {
+        mid = low + (high - low + 1) / 2;
+        ptr = rt_malloc(mid);
+        if (ptr != RT_NULL)
+        {
+            rt_free(ptr);
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return low;
+}
+
+static void heap_bench(int argc, char **argv)
+{
+    static const char * const op_name[HEAP_BENCH_OP_MAX] = { "malloc", "realloc", "free" };
+    rt_uint32_t i, total, used, max_used, free, largest;
+
+    rt_memset(bench_stat, 0, sizeof(bench_stat));
+    rt_memset(bench_slot, 0, sizeof(bench_slot));
+
+    if (argc > 1)
+    {
+        rt_kprintf("Heap bench of %s with the trace file %s.\n", HEAP_BENCH_NAME, argv[1]);
+        if (heap_bench_replay(argv[1]) != RT_EOK)
+            return;
+    }
+    else
+    {
+        rt_kprintf("Heap bench of %s with the synthetic trace, %d operations.\n", HEAP_BENCH_NAME,
+                   HEAP_BENCH_OP_COUNT);
+        heap_bench_synthetic();
+    }
+
+    rt_kprintf("op      |  count |  fail | avg (ns) | p99 (ns) | max (ns)\n");
+    rt_kprintf("------- | ------ | ----- | -------- | -------- | --------\n");
+    for (i = 0; i < HEAP_BENCH_OP_MAX; i++)
+    {
+        if (bench_stat[i].count == 0)
+            continue;
+
+        rt_kprintf("%-7s | %6d | %5d | %8d | %8d | %8d\n", op_name[i], bench_stat[i].count, bench_stat[i].fail,
+                   (rt_uint32_t)(bench_stat[i].total_ns / bench_stat[i].count), heap_bench_p99(&bench_stat[i]),
+                   bench_stat[i].max_ns);
+    }
+
+    /* the fragmentation is the free memory which can't be allocated in a block at the end of trace */
+    heap_bench_info(&total, &used, &max_used);
+    free = total - used;
+    largest = heap_bench_largest(free);
+    rt_kprintf("heap total: %d, used: %d, max used: %d\n", total, used, max_used);
+    rt_kprintf("largest block: %d of %d free (%d%% fragmentation)\n", largest, free,
+               free ? 100 - (rt_uint32_t)((unsigned long long)largest * 100 / free) : 0);
+
+    for (i = 0; i < HEAP_BENCH_SLOT_MAX; i++)
+    {
+        rt_free(bench_slot[i]);
+        bench_slot[i] = RT_NULL;
+    }
+}
+MSH_CMD_EXPORT(heap_bench, Measure the latency and fragmentation of heap with allocation trace);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_HEAP) */
@@ -0,0 +1,230 @@
+/*
+ * File      : irqoff_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the interrupt latency under kernel load
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <board.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_SEMAPHORE) && defined (RT_USING_MESSAGEQUEUE) \
+        && defined (RT_USING_HEAP)
+#include <finsh.h>
+
+/* the radio timing interrupt, it's zero-latency with RT_USING_BASEPRI */
+#define IRQOFF_BENCH_RADIO_IRQ         0
+/* the interrupt which calls kernel, it's lower than the board interrupts */
+#define IRQOFF_BENCH_KERNEL_IRQ        5
+#define IRQOFF_BENCH_PERIOD_US         50
+#define IRQOFF_BENCH_LOAD_COUNT        2
+#define IRQOFF_BENCH_LOAD_PRIORITY     20
+#define IRQOFF_BENCH_MSG_SIZE          64
+#define IRQOFF_BENCH_MSG_COUNT         4
+/* the kernel calls in one long critical section */
+#define IRQOFF_BENCH_BATCH             64
+
+struct irqoff_bench_irq
+{
+    /* the host time of trigger in nanosecond, 0: it's served */
+    volatile long long trigger;
+    rt_uint32_t count;
+    /* it's served when the kernel masks the interrupt */
+    rt_uint32_t in_critical;
+    unsigned long long sum;
+    rt_uint32_t max;
+};
+
+static struct irqoff_bench_irq bench_radio, bench_kernel;
+static volatile rt_bool_t bench_running;
+static volatile rt_uint32_t bench_exited;
+static struct rt_semaphore bench_sem;
+static struct rt_messagequeue bench_mq;
+static rt_uint8_t bench_mq_pool[IRQOFF_BENCH_MSG_COUNT * (IRQOFF_BENCH_MSG_SIZE + sizeof(void *))];
+static struct rt_timer bench_timer;
+static rt_uint32_t bench_ops;
+
+static long long irqoff_bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void irqoff_bench_serve(struct irqoff_bench_irq *irq)
+{
+    rt_uint32_t latency;
+
+    latency = (rt_uint32_t)(irqoff_bench_now() - irq->trigger);
+    irq->count ++;
+    if (rt_hw_sim_interrupt_masked())
+        irq->in_critical ++;
+    irq->sum += latency;
+    if (latency > irq->max)
+        irq->max = latency;
+    irq->trigger = 0;
+}
+
+/* it never calls kernel, so it can be zero-latency */
+static void irqoff_bench_radio_isr(void)
+{
+    irqoff_bench_serve(&bench_radio);
+}
+
+static void irqoff_bench_kernel_isr(void)
+{
+    rt_interrupt_enter();
+    irqoff_bench_serve(&bench_kernel);
+    rt_interrupt_leave();
+}
+
+/* the host thread triggers the interrupts periodically like the hardware, the next one waits the last is served */
+static void *irqoff_bench_host_entry(void *parameter)
+{
+    while (bench_running)
+    {
+        if (bench_radio.trigger == 0)
+        {
+            bench_radio.trigger = irqoff_bench_now();
+            rt_hw_sim_interrupt_trigger(IRQOFF_BENCH_RADIO_IRQ);
+        }
+        if (bench_kernel.trigger == 0)
+        {
+            bench_kernel.trigger = irqoff_bench_now();
+            rt_hw_sim_interrupt_trigger(IRQOFF_BENCH_KERNEL_IRQ);
+        }
+        usleep(IRQOFF_BENCH_PERIOD_US);
+    }
+
+    return RT_NULL;
+}
+
+static void irqoff_bench_timeout(void *parameter)
+{
+}
+
+/* the kernel services which disable interrupt: semaphore, message queue, heap and timer */
+static void irqoff_bench_load(void *parameter)
+{
+    rt_uint8_t msg[IRQOFF_BENCH_MSG_SIZE];
+    rt_uint32_t i = 0, j;
+    rt_base_t level;
+
+    while (bench_running)
+    {
+        rt_sem_release(&bench_sem);
+        rt_sem_take(&bench_sem, 0);
+
+        rt_mq_send(&bench_mq, msg, sizeof(msg));
+        rt_mq_recv(&bench_mq, msg, sizeof(msg), 0);
+
+        rt_free(rt_malloc(16 + (i % 8) * 32));
+
+        rt_timer_start(&bench_timer);
+        rt_timer_stop(&bench_timer);
+
+        bench_ops ++;
+        if (++i % 16 == 0)
+        {
+            /* the long masked window, like a driver which releases the semaphores of a batch in critical section */
+            level = rt_hw_interrupt_disable();
+            for (j = 0; j < IRQOFF_BENCH_BATCH; j++)
+            {
+                rt_sem_release(&bench_sem);
+                rt_sem_take(&bench_sem, 0);
+            }
+            rt_hw_interrupt_enable(level);
+
+            rt_thread_yield();
+        }
+    }
+
+    bench_exited ++;
+}
+
+static void irqoff_bench_report(const char *name, int irq, struct irqoff_bench_irq *result)
+{
+    rt_kprintf("%-12s | %3d | %7d | %11d | %10d | %d\n", name, irq, result->count, result->in_critical,
+               result->count ? (rt_uint32_t)(result->sum / result->count) : 0, result->max);
+}
+
+static void irqoff_bench(int argc, char **argv)
+{
+    pthread_t host;
+    rt_thread_t thread;
+    rt_uint32_t seconds = 1, i;
+
+    if (argc > 1)
+        seconds = atoi(argv[1]);
+    if (seconds == 0)
+    {
+        rt_kprintf("Usage: irqoff_bench [seconds]\n");
+        return;
+    }
+
+    rt_sem_init(&bench_sem, "irqoff", 0, RT_IPC_FLAG_FIFO);
+    rt_mq_init(&bench_mq, "irqoff", bench_mq_pool, IRQOFF_BENCH_MSG_SIZE, sizeof(bench_mq_pool), RT_IPC_FLAG_FIFO);
+    rt_timer_init(&bench_timer, "irqoff", irqoff_bench_timeout, RT_NULL, 100, RT_TIMER_FLAG_ONE_SHOT);
+    rt_memset(&bench_radio, 0, sizeof(bench_radio));
+    rt_memset(&bench_kernel, 0, sizeof(bench_kernel));
+    bench_running = RT_TRUE;
+    bench_exited = 0;
+    bench_ops = 0;
+
+    rt_hw_sim_interrupt_install(IRQOFF_BENCH_RADIO_IRQ, irqoff_bench_radio_isr);
+    rt_hw_sim_interrupt_install(IRQOFF_BENCH_KERNEL_IRQ, irqoff_bench_kernel_isr);
+#ifdef RT_USING_IRQOFF_STAT
+    rt_interrupt_mask_reset();
+#endif
+
+    for (i = 0; i < IRQOFF_BENCH_LOAD_COUNT; i++)
+    {
+        thread = rt_thread_create("irqload", irqoff_bench_load, RT_NULL, 1024, IRQOFF_BENCH_LOAD_PRIORITY, 10);
+        RT_ASSERT(thread != RT_NULL);
+        rt_thread_startup(thread);
+    }
+    pthread_create(&host, RT_NULL, irqoff_bench_host_entry, RT_NULL);
+
+    rt_thread_delay(rt_tick_from_millisecond(seconds * 1000));
+
+    bench_running = RT_FALSE;
+    pthread_join(host, RT_NULL);
+    while (bench_exited < IRQOFF_BENCH_LOAD_COUNT)
+        rt_thread_delay(10);
+
+    rt_hw_sim_interrupt_install(IRQOFF_BENCH_RADIO_IRQ, RT_NULL);
+    rt_hw_sim_interrupt_install(IRQOFF_BENCH_KERNEL_IRQ, RT_NULL);
+
+#ifdef RT_USING_BASEPRI
+    rt_kprintf("Interrupt latency bench, BASEPRI critical section, the interrupts lower than %d are zero-latency.\n",
+               RT_BASEPRI_THRESHOLD);
+#else
+    rt_kprintf("Interrupt latency bench, PRIMASK critical section, all interrupts are masked by kernel.\n");
+#endif
+    rt_kprintf("%d kernel operations (semaphore, message queue, heap and timer) per second.\n", bench_ops / seconds);
+    rt_kprintf("interrupt    | irq | served  | in critical | avg (ns)   | max (ns)\n");
+    rt_kprintf("------------ | --- | ------- | ----------- | ---------- | ----------\n");
+    irqoff_bench_report("radio", IRQOFF_BENCH_RADIO_IRQ, &bench_radio);
+    irqoff_bench_report("kernel-aware", IRQOFF_BENCH_KERNEL_IRQ, &bench_kernel);
+
+    rt_timer_detach(&bench_timer);
+    rt_mq_detach(&bench_mq);
+    rt_sem_detach(&bench_sem);
+}
+MSH_CMD_EXPORT(irqoff_bench, Measure the interrupt latency of zero-latency and kernel-aware interrupts under kernel load);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_SEMAPHORE) && defined (RT_USING_MESSAGEQUEUE) ... */
@@ -0,0 +1,265 @@
+/*
+ * File      : mem_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, check and measure rt_memcpy, rt_memmove and rt_memcmp
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH)
+#include <finsh.h>
+
+#define MEM_BENCH_SIZE_MAX             4096
+#define MEM_BENCH_ALIGN                (sizeof(rt_ubase_t))
+/* the guard bytes around the copied area */
+#define MEM_BENCH_GUARD                (MEM_BENCH_ALIGN * 4)
+#define MEM_BENCH_BUF_SIZE             (MEM_BENCH_SIZE_MAX + MEM_BENCH_GUARD * 2)
+
+static rt_uint8_t bench_src[MEM_BENCH_BUF_SIZE] __attribute__((aligned(64)));
+static rt_uint8_t bench_dst[MEM_BENCH_BUF_SIZE] __attribute__((aligned(64)));
+static rt_uint8_t bench_ref[MEM_BENCH_BUF_SIZE] __attribute__((aligned(64)));
+static volatile int bench_sink;
+
+static void mem_bench_fill(rt_uint8_t *buf, rt_size_t size, rt_uint32_t seed)
+{
+    rt_size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (rt_uint8_t)(seed >> 16);
+    }
+}
+
+static int mem_bench_sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+/* all sizes of 0 to MEM_BENCH_SIZE_MAX with all alignments of source and destination */
+static rt_uint32_t mem_bench_check_copy(rt_uint32_t *checked)
+{
+    rt_size_t size, sa, da;
+    rt_uint32_t errors = 0;
+
+    mem_bench_fill(bench_src, MEM_BENCH_BUF_SIZE, 1);
+    for (size = 0; size <= MEM_BENCH_SIZE_MAX; size++)
+    {
+        for (sa = 0; sa < MEM_BENCH_ALIGN; sa++)
+        {
+            for (da = 0; da < MEM_BENCH_ALIGN; da++)
+            {
+                memset(bench_dst, 0xA5, size + MEM_BENCH_GUARD * 2);
+                memset(bench_ref, 0xA5, size + MEM_BENCH_GUARD * 2);
+                memcpy(&bench_ref[MEM_BENCH_GUARD + da], &bench_src[MEM_BENCH_GUARD + sa], size);
+                if (rt_memcpy(&bench_dst[MEM_BENCH_GUARD + da], &bench_src[MEM_BENCH_GUARD + sa], size)
+                        != &bench_dst[MEM_BENCH_GUARD + da]
+                        || memcmp(bench_dst, bench_ref, size + MEM_BENCH_GUARD * 2) != 0)
+                {
+                    if (errors++ == 0)
+                        rt_kprintf("rt_memcpy failed: size %d, source +%d, destination +%d\n", size, sa, da);
+                }
+                (*checked) ++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+/* the overlapped move in one buffer, the distance is -2 to 2 words */
+static rt_uint32_t mem_bench_check_move(rt_uint32_t *checked)
+{
+    rt_size_t size, sa;
+    rt_base_t distance, window;
+    rt_uint8_t *src, *dst;
+    rt_uint32_t errors = 0;
+
+    for (size = 0; size <= MEM_BENCH_SIZE_MAX - MEM_BENCH_GUARD * 2; size++)
+    {
+        for (sa = 0; sa < MEM_BENCH_ALIGN; sa++)
+        {
+            for (distance = -(rt_base_t)MEM_BENCH_ALIGN * 2; distance <= (rt_base_t)MEM_BENCH_ALIGN * 2; distance++)
+            {
+                /* the window covers the source and destination with the guard bytes */
+                window = size + MEM_BENCH_GUARD * 2;
+                mem_bench_fill(bench_dst, window, size + sa);
+                memcpy(bench_ref, bench_dst, window);
+                src = &bench_dst[MEM_BENCH_GUARD + sa];
+                dst = src + distance;
+                memmove(&bench_ref[dst - bench_dst], &bench_ref[src - bench_dst], size);
+                if (rt_memmove(dst, src, size) != dst || memcmp(bench_dst, bench_ref, window) != 0)
+                {
+                    if (errors++ == 0)
+                        rt_kprintf("rt_memmove failed: size %d, source +%d, distance %d\n", size, sa, distance);
+                }
+                (*checked) ++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+/* the equal areas, and the areas differ at the first, middle and last byte */
+static rt_uint32_t mem_bench_check_compare(rt_uint32_t *checked)
+{
+    rt_size_t size, sa, da, i;
+    rt_size_t diff[3];
+    rt_uint8_t *cs, *ct, saved;
+    rt_uint32_t errors = 0;
+
+    mem_bench_fill(bench_src, MEM_BENCH_BUF_SIZE, 2);
+    for (size = 0; size <= MEM_BENCH_SIZE_MAX; size++)
+    {
+        diff[0] = 0;
+        diff[1] = size / 2;
+        diff[2] = size - 1;
+        for (sa = 0; sa < MEM_BENCH_ALIGN; sa++)
+        {
+            for (da = 0; da < MEM_BENCH_ALIGN; da++)
+            {
+                cs = &bench_src[MEM_BENCH_GUARD + sa];
+                ct = &bench_dst[MEM_BENCH_GUARD + da];
+                memcpy(ct, cs, size);
+                if (rt_memcmp(cs, ct, size) != 0)
+                {
+                    if (errors++ == 0)
+                        rt_kprintf("rt_memcmp failed: size %d, equal, +%d, +%d\n", size, sa, da);
+                }
+                (*checked) ++;
+
+                for (i = 0; size > 0 && i < sizeof(diff) / sizeof(diff[0]); i++)
+                {
+                    saved = ct[diff[i]];
+                    ct[diff[i]] = saved ^ (i == 1 ? 0x80 : 0x01);
+                    if (mem_bench_sign(rt_memcmp(cs, ct, size)) != mem_bench_sign(memcmp(cs, ct, size))
+                            || mem_bench_sign(rt_memcmp(ct, cs, size)) != mem_bench_sign(memcmp(ct, cs, size)))
+                    {
+                        if (errors++ == 0)
+                            rt_kprintf("rt_memcmp failed: size %d, differ at %d, +%d, +%d\n", size, diff[i], sa, da);
+                    }
+                    ct[diff[i]] = saved;
+                    (*checked) ++;
+                }
+            }
+        }
+    }
+
+    return errors;
+}
+
+enum mem_bench_func
+{
+    MEM_BENCH_RT_MEMCPY,
+    MEM_BENCH_MEMCPY,
+    MEM_BENCH_RT_MEMMOVE,
+    MEM_BENCH_MEMMOVE,
+    MEM_BENCH_RT_MEMCMP,
+    MEM_BENCH_MEMCMP,
+    MEM_BENCH_FUNC_MAX,
+};
+
+static const char *const bench_func_name[] =
+{
+    "rt_memcpy", "memcpy", "rt_memmove", "memmove", "rt_memcmp", "memcmp",
+};
+
+/* the throughput in MB/s, the count of calls moves about bytes in total */
+static rt_uint32_t mem_bench_run(enum mem_bench_func func, rt_size_t size, rt_size_t sa, rt_size_t da, rt_uint32_t bytes)
+{
+    struct timespec start, end;
+    rt_uint8_t *src = &bench_src[MEM_BENCH_GUARD + sa], *dst = &bench_dst[MEM_BENCH_GUARD + da];
+    rt_uint32_t i, count = bytes / size;
+    unsigned long long ns;
+    int sink = 0;
+
+    memcpy(dst, src, size);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < count; i++)
+    {
+        switch (func)
+        {
+        case MEM_BENCH_RT_MEMCPY:
+            rt_memcpy(dst, src, size);
+            break;
+        case MEM_BENCH_MEMCPY:
+            memcpy(dst, src, size);
+            break;
+        case MEM_BENCH_RT_MEMMOVE:
+            rt_memmove(dst, src, size);
+            break;
+        case MEM_BENCH_MEMMOVE:
+            memmove(dst, src, size);
+            break;
+        case MEM_BENCH_RT_MEMCMP:
+            sink += rt_memcmp(dst, src, size);
+            break;
+        default:
+            sink += memcmp(dst, src, size);
+            break;
+        }
+        /* keep the copy in loop */
+        __asm volatile ("" ::: "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    bench_sink = sink;
+
+    ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    if (ns == 0)
+        ns = 1;
+
+    return (rt_uint32_t)((unsigned long long)count * size * 1000 / ns);
+}
+
+static void mem_bench(int argc, char **argv)
+{
+    static const rt_size_t sizes[] = {8, 16, 64, 256, 1024, 4096};
+    /* the aligned source and destination, and the different offsets of them */
+    static const rt_size_t aligns[][2] = {{0, 0}, {1, 3}};
+    rt_uint32_t bytes = 64 * 1024 * 1024, checked = 0, errors = 0;
+    rt_size_t i, j, k;
+
+    if (argc > 1)
+        bytes = atoi(argv[1]) * 1024 * 1024;
+    if (bytes == 0)
+    {
+        rt_kprintf("Usage: mem_bench [MB of each measure]\n");
+        return;
+    }
+
+    errors += mem_bench_check_copy(&checked);
+    errors += mem_bench_check_move(&checked);
+    errors += mem_bench_check_compare(&checked);
+    rt_kprintf("Checked %d cases of size 0 to %d with %d byte alignments against libc, %d failed.\n",
+               checked, MEM_BENCH_SIZE_MAX, MEM_BENCH_ALIGN, errors);
+
+    rt_kprintf("function   | offset |     8 B |    16 B |    64 B |   256 B |    1 KB | 4 KB (MB/s)\n");
+    rt_kprintf("---------- | ------ | ------- | ------- | ------- | ------- | ------- | -----------\n");
+    for (i = 0; i < sizeof(aligns) / sizeof(aligns[0]); i++)
+    {
+        for (j = 0; j < MEM_BENCH_FUNC_MAX; j++)
+        {
+            rt_kprintf("%-10s | %2d, %2d", bench_func_name[j], aligns[i][0], aligns[i][1]);
+            for (k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+                rt_kprintf(k + 1 < sizeof(sizes) / sizeof(sizes[0]) ? " | %7d" : " | %d",
+                           mem_bench_run((enum mem_bench_func)j, sizes[k], aligns[i][0], aligns[i][1], bytes));
+            rt_kprintf("\n");
+        }
+    }
+}
+MSH_CMD_EXPORT(mem_bench, Check rt_memcpy rt_memmove rt_memcmp against libc and measure the throughput);
+#endif /* defined (RT_USING_FINSH) */
@@ -0,0 +1,246 @@
+/*
+ * File      : mp_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the allocation rate of memory pool
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_MEMPOOL)
+#include <finsh.h>
+
+#define MP_BENCH_BLOCK_SIZE            32
+/*
+ * The RT-Thread threads share the pool which is smaller than they hold, so some of them are suspended.
+ * It's not dead locked when every thread is waiting its last block.
+ */
+#define MP_BENCH_THREAD_COUNT          4
+#define MP_BENCH_THREAD_HOLD           2
+#define MP_BENCH_THREAD_BLOCKS         (MP_BENCH_THREAD_COUNT * (MP_BENCH_THREAD_HOLD - 1) + 1)
+#define MP_BENCH_THREAD_PRIORITY       25
+/* the blocks which are allocated by the hard timer in every tick, like the radio interrupt */
+#define MP_BENCH_ISR_BURST             2
+/* the host threads run on the host CPUs in parallel, the pool is never empty for them */
+#define MP_BENCH_HOST_COUNT            4
+#define MP_BENCH_HOST_HOLD             4
+#define MP_BENCH_HOST_BLOCKS           (MP_BENCH_HOST_COUNT * MP_BENCH_HOST_HOLD)
+
+struct mp_bench_block
+{
+    rt_ubase_t owner;
+    rt_ubase_t sequence;
+};
+
+static struct rt_mempool bench_mp;
+static rt_uint8_t bench_mp_pool[MP_BENCH_HOST_BLOCKS * (MP_BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *))];
+static volatile rt_bool_t bench_running;
+static volatile rt_uint32_t bench_alloc_count[MP_BENCH_THREAD_COUNT + 1], bench_isr_fail, bench_corrupt;
+static volatile rt_uint32_t bench_host_count[MP_BENCH_HOST_COUNT];
+
+/* stamp the block by its owner, then check it's not allocated by others at the same time */
+static void mp_bench_stamp(void *block, rt_ubase_t owner, rt_ubase_t sequence)
+{
+    struct mp_bench_block *stamp = (struct mp_bench_block *)block;
+
+    stamp->owner = owner;
+    stamp->sequence = sequence;
+}
+
+static void mp_bench_check(void *block, rt_ubase_t owner, rt_ubase_t sequence)
+{
+    struct mp_bench_block *stamp = (struct mp_bench_block *)block;
+
+    if (stamp->owner != owner || stamp->sequence != sequence)
+        __atomic_fetch_add(&bench_corrupt, 1, __ATOMIC_RELAXED);
+}
+
+static void mp_bench_thread_entry(void *parameter)
+{
+    rt_ubase_t id = (rt_ubase_t)parameter, sequence = 0;
+    void *block[MP_BENCH_THREAD_HOLD];
+    int i;
+
+    while (bench_running)
+    {
+        for (i = 0; i < MP_BENCH_THREAD_HOLD; i++)
+        {
+            block[i] = rt_mp_alloc(&bench_mp, RT_WAITING_FOREVER);
+            mp_bench_stamp(block[i], id, sequence + i);
+
+            /* the simulator only serves the interrupt when it's enabled, the lock-free path never enables it */
+            rt_hw_interrupt_enable(rt_hw_interrupt_disable());
+        }
+        for (i = 0; i < MP_BENCH_THREAD_HOLD; i++)
+        {
+            mp_bench_check(block[i], id, sequence + i);
+            rt_mp_free(block[i]);
+        }
+        sequence += MP_BENCH_THREAD_HOLD;
+        bench_alloc_count[id] += MP_BENCH_THREAD_HOLD;
+    }
+}
+
+static void mp_bench_timeout(void *parameter)
+{
+    void *block[MP_BENCH_ISR_BURST];
+    static rt_ubase_t sequence;
+    int i;
+
+    for (i = 0; i < MP_BENCH_ISR_BURST; i++)
+    {
+        block[i] = rt_mp_alloc(&bench_mp, 0);
+        if (block[i] != RT_NULL)
+            mp_bench_stamp(block[i], MP_BENCH_THREAD_COUNT, sequence + i);
+        else
+            bench_isr_fail ++;
+    }
+    for (i = 0; i < MP_BENCH_ISR_BURST; i++)
+    {
+        if (block[i] == RT_NULL)
+            continue;
+
+        mp_bench_check(block[i], MP_BENCH_THREAD_COUNT, sequence + i);
+        rt_mp_free(block[i]);
+        bench_alloc_count[MP_BENCH_THREAD_COUNT] ++;
+    }
+    sequence += MP_BENCH_ISR_BURST;
+}
+
+static void mp_bench_thread(rt_uint32_t seconds)
+{
+    rt_thread_t thread[MP_BENCH_THREAD_COUNT];
+    struct rt_timer timer;
+    rt_uint32_t i, total = 0;
+
+    rt_mp_init(&bench_mp, "mpbench", bench_mp_pool,
+               MP_BENCH_THREAD_BLOCKS * (MP_BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *)), MP_BENCH_BLOCK_SIZE);
+    rt_memset((void *)bench_alloc_count, 0, sizeof(bench_alloc_count));
+    bench_isr_fail = 0;
+    bench_corrupt = 0;
+    bench_running = RT_TRUE;
+
+    rt_timer_init(&timer, "mpbench", mp_bench_timeout, RT_NULL, 1,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    for (i = 0; i < MP_BENCH_THREAD_COUNT; i++)
+    {
+        thread[i] = rt_thread_create("mpbench", mp_bench_thread_entry, (void *)(rt_ubase_t)i, 512,
+                                     MP_BENCH_THREAD_PRIORITY, 2);
+        RT_ASSERT(thread[i] != RT_NULL);
+        rt_thread_startup(thread[i]);
+    }
+    rt_timer_start(&timer);
+
+    rt_thread_delay(rt_tick_from_millisecond(seconds * 1000));
+
+    /* the threads are exited after they free the blocks, and the suspended thread is resumed by them */
+    rt_timer_detach(&timer);
+    bench_running = RT_FALSE;
+    while (bench_mp.block_free_count != bench_mp.block_total_count || bench_mp.suspend_thread_count > 0)
+        rt_thread_delay(1);
+    rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    rt_mp_detach(&bench_mp);
+
+    for (i = 0; i < MP_BENCH_THREAD_COUNT; i++)
+        total += bench_alloc_count[i];
+
+    rt_kprintf("threads | %7d | %10d | isr %d, failed %d | %d\n", MP_BENCH_THREAD_COUNT, total / seconds,
+               bench_alloc_count[MP_BENCH_THREAD_COUNT] / seconds, bench_isr_fail, bench_corrupt);
+}
+
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+static void *mp_bench_host_entry(void *parameter)
+{
+    rt_ubase_t id = (rt_ubase_t)parameter, sequence = 0;
+    void *block[MP_BENCH_HOST_HOLD];
+    int i, count;
+
+    while (bench_running)
+    {
+        /* the count and order of blocks are changed, so the list is shuffled */
+        count = 1 + sequence % MP_BENCH_HOST_HOLD;
+        for (i = 0; i < count; i++)
+        {
+            block[i] = rt_mp_alloc(&bench_mp, 0);
+            RT_ASSERT(block[i] != RT_NULL);
+            mp_bench_stamp(block[i], MP_BENCH_THREAD_COUNT + 1 + id, sequence + i);
+        }
+        for (i = 0; i < count; i++)
+        {
+            mp_bench_check(block[(i + sequence) % count], MP_BENCH_THREAD_COUNT + 1 + id,
+                           sequence + (i + sequence) % count);
+            rt_mp_free(block[(i + sequence) % count]);
+        }
+        sequence += count;
+        bench_host_count[id] += count;
+    }
+
+    return RT_NULL;
+}
+
+/* the host threads call rt_mp_alloc and rt_mp_free in parallel, it's only safe for the lock-free list */
+static void mp_bench_host(rt_uint32_t seconds)
+{
+    pthread_t host[MP_BENCH_HOST_COUNT];
+    rt_uint32_t i, total = 0;
+
+    rt_mp_init(&bench_mp, "mpbench", bench_mp_pool, sizeof(bench_mp_pool), MP_BENCH_BLOCK_SIZE);
+    rt_memset((void *)bench_host_count, 0, sizeof(bench_host_count));
+    bench_corrupt = 0;
+    bench_running = RT_TRUE;
+
+    for (i = 0; i < MP_BENCH_HOST_COUNT; i++)
+        pthread_create(&host[i], RT_NULL, mp_bench_host_entry, (void *)(rt_ubase_t)i);
+
+    rt_thread_delay(rt_tick_from_millisecond(seconds * 1000));
+
+    bench_running = RT_FALSE;
+    for (i = 0; i < MP_BENCH_HOST_COUNT; i++)
+    {
+        pthread_join(host[i], RT_NULL);
+        total += bench_host_count[i];
+    }
+
+    rt_kprintf("host    | %7d | %10d | free %d/%d | %d\n", MP_BENCH_HOST_COUNT, total / seconds,
+               bench_mp.block_free_count, bench_mp.block_total_count, bench_corrupt);
+    rt_mp_detach(&bench_mp);
+}
+#endif /* RT_USING_MEMPOOL_LOCKFREE */
+
+static void mp_bench(int argc, char **argv)
+{
+    rt_uint32_t seconds = 2;
+
+    if (argc > 1)
+        seconds = atoi(argv[1]);
+    if (seconds == 0)
+    {
+        rt_kprintf("Usage: mp_bench [seconds]\n");
+        return;
+    }
+
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    rt_kprintf("Memory pool bench with lock-free block list, %d seconds for each.\n", seconds);
+#else
+    rt_kprintf("Memory pool bench with interrupt disabled block list, %d seconds for each.\n", seconds);
+#endif
+    rt_kprintf("caller  | threads | allocs (/s) | note              | corrupted\n");
+    rt_kprintf("------- | ------- | ----------- | ----------------- | ---------\n");
+    mp_bench_thread(seconds);
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    mp_bench_host(seconds);
+#endif
+}
+MSH_CMD_EXPORT(mp_bench, Measure the allocation rate of memory pool by threads and interrupt);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_MEMPOOL) */
@@ -0,0 +1,219 @@
+/*
+ * File      : mq_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the copy and zero-copy message queue
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#define MQ_BENCH_CYCLES()              __rdtsc()
+#else
+#define MQ_BENCH_CYCLES()              0
+#endif
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_MESSAGEQUEUE)
+#include <finsh.h>
+
+/* the sensor frame, count is rounded up to the messages in queue */
+#define MQ_BENCH_MSG_SIZE              256
+#define MQ_BENCH_MSG_COUNT             8
+#define MQ_BENCH_PRIORITY              20
+
+struct mq_bench_frame
+{
+    rt_uint32_t sequence;
+    rt_uint8_t  payload[MQ_BENCH_MSG_SIZE - sizeof(rt_uint32_t)];
+};
+
+static struct rt_messagequeue bench_mq;
+static rt_uint8_t bench_mq_pool[MQ_BENCH_MSG_COUNT * (MQ_BENCH_MSG_SIZE + sizeof(void *))];
+static struct rt_semaphore bench_done;
+static rt_uint32_t bench_count, bench_error;
+static rt_bool_t bench_zero_copy;
+
+/* the producer fills the frame like the sensor driver, the consumer checks it */
+static void mq_bench_fill(struct mq_bench_frame *frame, rt_uint32_t sequence)
+{
+    frame->sequence = sequence;
+    rt_memset(frame->payload, (rt_uint8_t)sequence, sizeof(frame->payload));
+}
+
+static void mq_bench_check(const struct mq_bench_frame *frame, rt_uint32_t sequence)
+{
+    if (frame->sequence != sequence || frame->payload[0] != (rt_uint8_t)sequence
+            || frame->payload[sizeof(frame->payload) - 1] != (rt_uint8_t)sequence)
+        bench_error ++;
+}
+
+/* the producer sends until the queue is full, then yields to the consumer at the same priority */
+static void mq_bench_producer(void *parameter)
+{
+    struct mq_bench_frame frame, *loan;
+    rt_uint32_t sequence = 0;
+
+    while (sequence < bench_count)
+    {
+        if (bench_zero_copy)
+        {
+            loan = (struct mq_bench_frame *)rt_mq_loan(&bench_mq);
+            if (loan == RT_NULL)
+            {
+                rt_thread_yield();
+                continue;
+            }
+            mq_bench_fill(loan, sequence);
+            rt_mq_commit(&bench_mq, loan);
+        }
+        else
+        {
+            mq_bench_fill(&frame, sequence);
+            if (rt_mq_send(&bench_mq, &frame, sizeof(frame)) != RT_EOK)
+            {
+                rt_thread_yield();
+                continue;
+            }
+        }
+        sequence ++;
+    }
+}
+
+static void mq_bench_consumer(void *parameter)
+{
+    struct mq_bench_frame frame, *ref;
+    rt_uint32_t sequence;
+
+    for (sequence = 0; sequence < bench_count; sequence++)
+    {
+        if (bench_zero_copy)
+        {
+            rt_mq_recv_ref(&bench_mq, (void **)&ref, RT_WAITING_FOREVER);
+            mq_bench_check(ref, sequence);
+            rt_mq_release(&bench_mq, ref);
+        }
+        else
+        {
+            rt_mq_recv(&bench_mq, &frame, sizeof(frame), RT_WAITING_FOREVER);
+            mq_bench_check(&frame, sequence);
+        }
+    }
+
+    rt_sem_release(&bench_done);
+}
+
+/* the queue is filled and drained by the caller, so only the message path is measured without context switch */
+static void mq_bench_inline(rt_uint32_t count)
+{
+    struct mq_bench_frame frame, *buffer;
+    rt_uint32_t sequence, i;
+
+    for (sequence = 0; sequence < count; sequence += MQ_BENCH_MSG_COUNT)
+    {
+        for (i = 0; i < MQ_BENCH_MSG_COUNT; i++)
+        {
+            if (bench_zero_copy)
+            {
+                buffer = (struct mq_bench_frame *)rt_mq_loan(&bench_mq);
+                mq_bench_fill(buffer, sequence + i);
+                rt_mq_commit(&bench_mq, buffer);
+            }
+            else
+            {
+                mq_bench_fill(&frame, sequence + i);
+                rt_mq_send(&bench_mq, &frame, sizeof(frame));
+            }
+        }
+        for (i = 0; i < MQ_BENCH_MSG_COUNT; i++)
+        {
+            if (bench_zero_copy)
+            {
+                rt_mq_recv_ref(&bench_mq, (void **)&buffer, 0);
+                mq_bench_check(buffer, sequence + i);
+                rt_mq_release(&bench_mq, buffer);
+            }
+            else
+            {
+                rt_mq_recv(&bench_mq, &frame, sizeof(frame), 0);
+                mq_bench_check(&frame, sequence + i);
+            }
+        }
+    }
+}
+
+static void mq_bench_run(const char *name, rt_bool_t threads, rt_bool_t zero_copy, rt_uint32_t count)
+{
+    struct timespec start, end;
+    unsigned long long cycles, ns;
+    rt_thread_t producer, consumer;
+
+    rt_mq_init(&bench_mq, "mqbench", bench_mq_pool, MQ_BENCH_MSG_SIZE, sizeof(bench_mq_pool), RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_done, "mqbench", 0, RT_IPC_FLAG_FIFO);
+    bench_zero_copy = zero_copy;
+    bench_count = count;
+    bench_error = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    cycles = MQ_BENCH_CYCLES();
+    if (threads)
+    {
+        consumer = rt_thread_create("mqrecv", mq_bench_consumer, RT_NULL, 1024, MQ_BENCH_PRIORITY, 10);
+        producer = rt_thread_create("mqsend", mq_bench_producer, RT_NULL, 1024, MQ_BENCH_PRIORITY, 10);
+        RT_ASSERT(consumer != RT_NULL && producer != RT_NULL);
+        rt_thread_startup(consumer);
+        rt_thread_startup(producer);
+        rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    }
+    else
+    {
+        mq_bench_inline(count);
+    }
+    cycles = MQ_BENCH_CYCLES() - cycles;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    rt_kprintf("%-7s | %-9s | %7d | %11d | %8d | %8d | %d\n", threads ? "threads" : "inline", name, count,
+               (rt_uint32_t)((unsigned long long)count * MQ_BENCH_MSG_SIZE * 1000000000ULL / ns / 1024),
+               (rt_uint32_t)(ns / count), (rt_uint32_t)(cycles / count), bench_error);
+
+    /* wait the producer exit */
+    if (threads)
+        rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    rt_sem_detach(&bench_done);
+    rt_mq_detach(&bench_mq);
+}
+
+static void mq_bench(int argc, char **argv)
+{
+    rt_uint32_t count = 200000;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: mq_bench [count]\n");
+        return;
+    }
+
+    rt_kprintf("Message queue bench, %d bytes message, %d messages in queue.\n", MQ_BENCH_MSG_SIZE,
+               MQ_BENCH_MSG_COUNT);
+    rt_kprintf("caller  | mode      |   count | KB (/s)     | ns / msg | cycles   | corrupted\n");
+    rt_kprintf("------- | --------- | ------- | ----------- | -------- | -------- | ---------\n");
+    mq_bench_run("copy", RT_FALSE, RT_FALSE, count);
+    mq_bench_run("zero-copy", RT_FALSE, RT_TRUE, count);
+    mq_bench_run("copy", RT_TRUE, RT_FALSE, count);
+    mq_bench_run("zero-copy", RT_TRUE, RT_TRUE, count);
+}
+MSH_CMD_EXPORT(mq_bench, Measure the copy and zero-copy message queue by a producer and a consumer);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_MESSAGEQUEUE) */
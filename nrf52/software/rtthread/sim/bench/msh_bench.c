@@ -0,0 +1,169 @@
+/*
+ * File      : msh_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, replay the command script on msh
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (FINSH_USING_MSH) && defined (RT_USING_DEVICE)
+#include <finsh.h>
+#include <msh.h>
+
+#define MSH_BENCH_LINE_SIZE            80
+
+/* the provisioning script, the last line is an unknown command */
+static const char *const bench_script[] =
+{
+    "__nop",
+    "__nop wifi.ssid \"office ap\"",
+    "__nop wifi.psk 12345678",
+    "__nop ble.name nrf52",
+    "__nop ble.interval 100 200",
+    "__nop log.level 3",
+    "__nop commit",
+    "unknown_cmd 1 2 3",
+};
+
+/* the prefixes of auto completion by TAB */
+static const char *const bench_prefix[] =
+{
+    "li",
+    "list_t",
+    "n",
+    "msh_b",
+    "x",
+};
+
+static int msh_bench_nop(int argc, char **argv)
+{
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(msh_bench_nop, __nop, Do nothing for the script of msh_bench);
+
+static rt_size_t msh_bench_null_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    return size;
+}
+
+static rt_uint32_t msh_bench_ns(struct timespec *start, struct timespec *end)
+{
+    return (rt_uint32_t)((end->tv_sec - start->tv_sec) * 1000000000ULL + end->tv_nsec - start->tv_nsec);
+}
+
+static rt_uint32_t msh_bench_exec(rt_uint32_t count)
+{
+    struct timespec start, end;
+    char line[MSH_BENCH_LINE_SIZE];
+    rt_uint32_t i, j;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < sizeof(bench_script) / sizeof(bench_script[0]); j++)
+        {
+            /* the command line is split in place like the shell */
+            rt_strncpy(line, bench_script[j], sizeof(line));
+            msh_exec(line, rt_strlen(line));
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return msh_bench_ns(&start, &end) / (count * (sizeof(bench_script) / sizeof(bench_script[0])));
+}
+
+static rt_uint32_t msh_bench_complete(rt_uint32_t count)
+{
+    struct timespec start, end;
+    char line[MSH_BENCH_LINE_SIZE];
+    rt_uint32_t i, j;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < sizeof(bench_prefix) / sizeof(bench_prefix[0]); j++)
+        {
+            rt_memset(line, 0, sizeof(line));
+            rt_strncpy(line, bench_prefix[j], sizeof(line));
+            msh_auto_complete(line);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return msh_bench_ns(&start, &end) / (count * (sizeof(bench_prefix) / sizeof(bench_prefix[0])));
+}
+
+static void msh_bench(int argc, char **argv)
+{
+    struct finsh_syscall *index;
+    rt_device_t console;
+    rt_size_t (*console_write)(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size) = RT_NULL;
+    rt_uint32_t count = 10000, commands = 0, symbols = 0, exec_ns, complete_ns;
+#ifdef FINSH_USING_SYMTAB_INDEX
+    struct finsh_syscall **syscall_index;
+    rt_uint32_t index_exec_ns, index_complete_ns;
+#endif
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: msh_bench [count]\n");
+        return;
+    }
+
+    for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
+    {
+        symbols ++;
+        if (strncmp(index->name, "__cmd_", 6) == 0)
+            commands ++;
+    }
+
+    /* the output of commands is dropped, the console isn't reopened, so the shell keeps its RX mode */
+    console = rt_console_get_device();
+    if (console != RT_NULL)
+    {
+        console_write = console->write;
+        console->write = msh_bench_null_write;
+    }
+
+    /* the table scan, same as without FINSH_USING_SYMTAB_INDEX */
+#ifdef FINSH_USING_SYMTAB_INDEX
+    syscall_index = _syscall_index;
+    _syscall_index = RT_NULL;
+#endif
+    exec_ns = msh_bench_exec(count);
+    complete_ns = msh_bench_complete(count);
+#ifdef FINSH_USING_SYMTAB_INDEX
+    _syscall_index = syscall_index;
+    index_exec_ns = msh_bench_exec(count);
+    index_complete_ns = msh_bench_complete(count);
+#endif
+
+    if (console != RT_NULL)
+        console->write = console_write;
+
+    rt_kprintf("msh script replay bench, %d commands in %d symbols, %d lines and %d completions per round.\n",
+               commands, symbols, sizeof(bench_script) / sizeof(bench_script[0]),
+               sizeof(bench_prefix) / sizeof(bench_prefix[0]));
+    rt_kprintf("lookup       | rounds | ns / line | ns / completion\n");
+    rt_kprintf("------------ | ------ | --------- | ---------------\n");
+    rt_kprintf("table scan   | %6d | %9d | %d\n", count, exec_ns, complete_ns);
+#ifdef FINSH_USING_SYMTAB_INDEX
+    rt_kprintf("sorted index | %6d | %9d | %d\n", count, index_exec_ns, index_complete_ns);
+#endif
+}
+MSH_CMD_EXPORT(msh_bench, Replay the command script and the completion on msh with and without symbol index);
+#endif /* defined (RT_USING_FINSH) && defined (FINSH_USING_MSH) && defined (RT_USING_DEVICE) */
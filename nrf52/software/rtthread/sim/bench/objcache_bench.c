@@ -0,0 +1,120 @@
+/*
+ * File      : objcache_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the create and delete of short-lived objects
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_HEAP)
+#include <finsh.h>
+
+/* the objects which are alive at the same time, like the work of a request */
+#define OBJCACHE_BENCH_BATCH           4
+#define OBJCACHE_BENCH_STACK_SIZE      512
+#define OBJCACHE_BENCH_PRIORITY        20
+
+static void objcache_bench_entry(void *parameter)
+{
+}
+
+static unsigned long long objcache_bench_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void objcache_bench_result(const char *name, rt_uint32_t count, unsigned long long ns)
+{
+    rt_uint32_t total, used, max_used;
+
+    rt_memory_info(&total, &used, &max_used);
+    rt_kprintf("%-9s | %6d | %9d | %6d | %8d\n", name, count, (rt_uint32_t)(ns / count), used, max_used);
+}
+
+/* the threads are created and deleted before startup, the idle thread function frees them in place */
+static void objcache_bench_thread(rt_uint32_t count)
+{
+    rt_thread_t thread[OBJCACHE_BENCH_BATCH];
+    unsigned long long start;
+    rt_uint32_t i, j;
+
+    start = objcache_bench_now_ns();
+    for (i = 0; i < count; i += OBJCACHE_BENCH_BATCH)
+    {
+        for (j = 0; j < OBJCACHE_BENCH_BATCH; j++)
+        {
+            thread[j] = rt_thread_create("ocbench", objcache_bench_entry, RT_NULL, OBJCACHE_BENCH_STACK_SIZE,
+                                         OBJCACHE_BENCH_PRIORITY, 10);
+            RT_ASSERT(thread[j] != RT_NULL);
+        }
+        for (j = 0; j < OBJCACHE_BENCH_BATCH; j++)
+            rt_thread_delete(thread[j]);
+        rt_thread_idle_excute();
+    }
+    objcache_bench_result("thread", count, objcache_bench_now_ns() - start);
+}
+
+#ifdef RT_USING_SEMAPHORE
+static void objcache_bench_sem(rt_uint32_t count)
+{
+    rt_sem_t sem[OBJCACHE_BENCH_BATCH];
+    unsigned long long start;
+    rt_uint32_t i, j;
+
+    start = objcache_bench_now_ns();
+    for (i = 0; i < count; i += OBJCACHE_BENCH_BATCH)
+    {
+        for (j = 0; j < OBJCACHE_BENCH_BATCH; j++)
+        {
+            sem[j] = rt_sem_create("ocbench", 0, RT_IPC_FLAG_FIFO);
+            RT_ASSERT(sem[j] != RT_NULL);
+        }
+        for (j = 0; j < OBJCACHE_BENCH_BATCH; j++)
+            rt_sem_delete(sem[j]);
+    }
+    objcache_bench_result("semaphore", count, objcache_bench_now_ns() - start);
+}
+#endif
+
+static void objcache_bench(int argc, char **argv)
+{
+    rt_uint32_t count = 100000;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count < OBJCACHE_BENCH_BATCH)
+    {
+        rt_kprintf("Usage: objcache_bench [count]\n");
+        return;
+    }
+
+#ifdef RT_USING_OBJCACHE
+    rt_kprintf("Object create and delete bench with object cache, %d objects.\n", count);
+#else
+    rt_kprintf("Object create and delete bench without object cache, %d objects.\n", count);
+#endif
+    rt_kprintf("object    |  count | each (ns) |   used | max used\n");
+    rt_kprintf("--------- | ------ | --------- | ------ | --------\n");
+    objcache_bench_thread(count);
+#ifdef RT_USING_SEMAPHORE
+    objcache_bench_sem(count);
+#endif
+}
+MSH_CMD_EXPORT(objcache_bench, Measure the create and delete of short-lived threads and semaphores);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_HEAP) */
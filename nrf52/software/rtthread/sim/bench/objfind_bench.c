@@ -0,0 +1,143 @@
+/*
+ * File      : objfind_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the device lookup by name
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_DEVICE)
+#include <finsh.h>
+
+#define OBJFIND_BENCH_DEVICE_MAX       1000
+
+static struct rt_device bench_device[OBJFIND_BENCH_DEVICE_MAX];
+static char bench_name[OBJFIND_BENCH_DEVICE_MAX][RT_NAME_MAX];
+/* the names aren't registered, the whole list or bucket is walked */
+static char bench_miss[OBJFIND_BENCH_DEVICE_MAX][RT_NAME_MAX];
+
+/* the list walk of rt_device_find without name hash index */
+static rt_device_t objfind_bench_walk(const char *name)
+{
+    struct rt_object_information *information;
+    struct rt_object *object;
+    struct rt_list_node *node;
+
+    rt_enter_critical();
+    information = rt_object_get_information(RT_Object_Class_Device);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            rt_exit_critical();
+            return (rt_device_t)object;
+        }
+    }
+    rt_exit_critical();
+
+    return RT_NULL;
+}
+
+static rt_uint32_t objfind_bench_run(rt_device_t (*find)(const char *name), rt_uint32_t devices,
+                                     rt_uint32_t count, rt_bool_t miss)
+{
+    struct timespec start, end;
+    char (*names)[RT_NAME_MAX] = miss ? bench_miss : bench_name;
+    rt_uint32_t i, found = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < count; i++)
+        found += find(names[(i * 7) % devices]) != RT_NULL;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    RT_ASSERT(found == (miss ? 0 : count));
+
+    return (rt_uint32_t)(((end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec) / count);
+}
+
+#ifdef RT_USING_OBJECT_HASH
+static rt_uint32_t objfind_bench_longest_bucket(void)
+{
+    struct rt_object_information *information;
+    struct rt_object *object;
+    rt_uint32_t i, length, longest = 0;
+
+    information = rt_object_get_information(RT_Object_Class_Device);
+    for (i = 0; i < RT_OBJECT_HASH_SIZE; i++)
+    {
+        length = 0;
+        for (object = information->hash[i]; object != RT_NULL; object = object->hash_next)
+            length ++;
+        if (length > longest)
+            longest = length;
+    }
+
+    return longest;
+}
+#endif
+
+static void objfind_bench(int argc, char **argv)
+{
+    static const rt_uint32_t devices[] = {10, 100, 1000};
+    rt_uint32_t count = 100000, i, j, registered = 0, longest = 0;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: objfind_bench [count]\n");
+        return;
+    }
+
+#ifdef RT_USING_OBJECT_HASH
+    rt_kprintf("Device lookup bench, name hash index with %d buckets of each object class.\n", RT_OBJECT_HASH_SIZE);
+#else
+    rt_kprintf("Device lookup bench, no name hash index, rt_device_find walks the list.\n");
+#endif
+    rt_kprintf("devices | longest bucket | walk hit (ns) | find hit (ns) | walk miss (ns) | find miss (ns)\n");
+    rt_kprintf("------- | -------------- | ------------- | ------------- | -------------- | --------------\n");
+
+    for (i = 0; i < sizeof(devices) / sizeof(devices[0]); i++)
+    {
+        for (; registered < devices[i]; registered++)
+        {
+            rt_snprintf(bench_name[registered], RT_NAME_MAX, "bench%d", registered);
+            rt_snprintf(bench_miss[registered], RT_NAME_MAX, "missing%d", registered);
+            if (rt_device_register(&bench_device[registered], bench_name[registered], RT_DEVICE_FLAG_RDWR) != RT_EOK)
+            {
+                rt_kprintf("Register device %s failed.\n", bench_name[registered]);
+                goto __exit;
+            }
+        }
+#ifdef RT_USING_OBJECT_HASH
+        longest = objfind_bench_longest_bucket();
+#endif
+
+        rt_kprintf("%7d | %14d | %13d | %13d | %14d | %d\n", devices[i], longest,
+                   objfind_bench_run(objfind_bench_walk, devices[i], count, RT_FALSE),
+                   objfind_bench_run(rt_device_find, devices[i], count, RT_FALSE),
+                   objfind_bench_run(objfind_bench_walk, devices[i], count, RT_TRUE),
+                   objfind_bench_run(rt_device_find, devices[i], count, RT_TRUE));
+    }
+
+__exit:
+    for (j = 0; j < registered; j++)
+        rt_device_unregister(&bench_device[j]);
+}
+MSH_CMD_EXPORT(objfind_bench, Measure the device lookup by name with 10 to 1000 registered devices);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_DEVICE) */
@@ -0,0 +1,214 @@
+/*
+ * File      : rwlock_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the read throughput of reader/writer lock and mutex
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_RWLOCK) && defined (RT_USING_MUTEX)
+#include <finsh.h>
+
+#define RWLOCK_BENCH_READER_MAX        8
+/* the configuration table, the words are same after each write */
+#define RWLOCK_BENCH_TABLE_SIZE        256
+/* the simulator serves the tick when the interrupt is enabled, so the reader may be preempted in reading */
+#define RWLOCK_BENCH_IRQ_WINDOW        32
+#define RWLOCK_BENCH_READER_PRIORITY   22
+#define RWLOCK_BENCH_WRITER_PRIORITY   21
+#define RWLOCK_BENCH_WRITE_PERIOD      10
+
+static struct rt_rwlock bench_rwlock;
+static struct rt_mutex bench_mutex;
+static rt_bool_t bench_using_rwlock;
+static volatile rt_bool_t bench_running;
+static volatile rt_uint32_t bench_exited;
+static rt_uint32_t bench_table[RWLOCK_BENCH_TABLE_SIZE];
+static rt_uint32_t bench_reads[RWLOCK_BENCH_READER_MAX], bench_writes, bench_inconsistent;
+
+static void rwlock_bench_lock(rt_bool_t write)
+{
+    if (!bench_using_rwlock)
+        rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+    else if (write)
+        rt_rwlock_take_write(&bench_rwlock, RT_WAITING_FOREVER);
+    else
+        rt_rwlock_take_read(&bench_rwlock, RT_WAITING_FOREVER);
+}
+
+static void rwlock_bench_unlock(void)
+{
+    if (bench_using_rwlock)
+        rt_rwlock_release(&bench_rwlock);
+    else
+        rt_mutex_release(&bench_mutex);
+}
+
+static void rwlock_bench_reader(void *parameter)
+{
+    rt_ubase_t id = (rt_ubase_t)parameter;
+    rt_uint32_t i, version;
+
+    while (bench_running)
+    {
+        rwlock_bench_lock(RT_FALSE);
+        version = bench_table[0];
+        for (i = 1; i < RWLOCK_BENCH_TABLE_SIZE; i++)
+        {
+            if (bench_table[i] != version)
+            {
+                bench_inconsistent ++;
+                break;
+            }
+            if (i % RWLOCK_BENCH_IRQ_WINDOW == 0)
+                rt_hw_interrupt_enable(rt_hw_interrupt_disable());
+        }
+        rwlock_bench_unlock();
+
+        bench_reads[id] ++;
+    }
+
+    bench_exited ++;
+}
+
+static void rwlock_bench_writer(void *parameter)
+{
+    rt_uint32_t i;
+
+    while (bench_running)
+    {
+        rwlock_bench_lock(RT_TRUE);
+        for (i = 0; i < RWLOCK_BENCH_TABLE_SIZE; i++)
+        {
+            bench_table[i] = bench_writes + 1;
+            if (i % RWLOCK_BENCH_IRQ_WINDOW == 0)
+                rt_hw_interrupt_enable(rt_hw_interrupt_disable());
+        }
+        bench_writes ++;
+        rwlock_bench_unlock();
+
+        rt_thread_delay(RWLOCK_BENCH_WRITE_PERIOD);
+    }
+
+    bench_exited ++;
+}
+
+static rt_uint32_t rwlock_bench_run(rt_bool_t using_rwlock, rt_uint32_t readers, rt_uint32_t seconds)
+{
+    rt_thread_t thread;
+    rt_uint32_t i, total = 0;
+
+    bench_using_rwlock = using_rwlock;
+    bench_running = RT_TRUE;
+    bench_exited = 0;
+    bench_writes = 0;
+    bench_inconsistent = 0;
+    rt_memset(bench_table, 0, sizeof(bench_table));
+    rt_memset(bench_reads, 0, sizeof(bench_reads));
+
+    for (i = 0; i < readers; i++)
+    {
+        thread = rt_thread_create("rwreader", rwlock_bench_reader, (void *)(rt_ubase_t)i, 1024,
+                                  RWLOCK_BENCH_READER_PRIORITY, 2);
+        RT_ASSERT(thread != RT_NULL);
+        rt_thread_startup(thread);
+    }
+    thread = rt_thread_create("rwwriter", rwlock_bench_writer, RT_NULL, 1024, RWLOCK_BENCH_WRITER_PRIORITY, 2);
+    RT_ASSERT(thread != RT_NULL);
+    rt_thread_startup(thread);
+
+    rt_thread_delay(rt_tick_from_millisecond(seconds * 1000));
+
+    bench_running = RT_FALSE;
+    while (bench_exited < readers + 1)
+        rt_thread_delay(RWLOCK_BENCH_WRITE_PERIOD);
+
+    for (i = 0; i < readers; i++)
+        total += bench_reads[i];
+
+    rt_kprintf("%-6s | %7d | %11d | %6d | %d\n", using_rwlock ? "rwlock" : "mutex", readers, total / seconds,
+               bench_writes, bench_inconsistent);
+
+    return total;
+}
+
+static void rwlock_bench_pi_low(void *parameter)
+{
+    rt_rwlock_take_write(&bench_rwlock, RT_WAITING_FOREVER);
+    rt_thread_delay(20);
+    rt_rwlock_release(&bench_rwlock);
+}
+
+static void rwlock_bench_pi_high(void *parameter)
+{
+    rt_rwlock_take_read(&bench_rwlock, RT_WAITING_FOREVER);
+    rt_rwlock_release(&bench_rwlock);
+}
+
+/* the low priority writer holds the lock, it inherits the priority of the high priority reader */
+static void rwlock_bench_pi(void)
+{
+    rt_thread_t low, high;
+    rt_uint8_t boosted, restored;
+
+    low = rt_thread_create("rwlow", rwlock_bench_pi_low, RT_NULL, 1024, 25, 2);
+    high = rt_thread_create("rwhigh", rwlock_bench_pi_high, RT_NULL, 1024, 10, 2);
+    RT_ASSERT(low != RT_NULL && high != RT_NULL);
+
+    rt_thread_startup(low);
+    rt_thread_delay(5);
+    rt_thread_startup(high);
+    rt_thread_delay(5);
+    boosted = low->current_priority;
+    /* the writer releases the lock after 20 ticks */
+    rt_thread_delay(20);
+    restored = low->current_priority;
+
+    rt_kprintf("priority inheritance: writer priority 25, boosted to %d by reader of priority 10, then %d\n",
+               boosted, restored);
+    rt_thread_delay(50);
+}
+
+static void rwlock_bench(int argc, char **argv)
+{
+    rt_uint32_t seconds = 1, readers;
+
+    if (argc > 1)
+        seconds = atoi(argv[1]);
+    if (seconds == 0)
+    {
+        rt_kprintf("Usage: rwlock_bench [seconds]\n");
+        return;
+    }
+
+    rt_rwlock_init(&bench_rwlock, "rwbench", RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&bench_mutex, "rwbench", RT_IPC_FLAG_PRIO);
+
+    rt_kprintf("Reader/writer lock bench, a writer updates the table every %d ticks, %d seconds for each.\n",
+               RWLOCK_BENCH_WRITE_PERIOD, seconds);
+    rt_kprintf("lock   | readers | reads (/s)  | writes | inconsistent\n");
+    rt_kprintf("------ | ------- | ----------- | ------ | ------------\n");
+    for (readers = 1; readers <= RWLOCK_BENCH_READER_MAX; readers *= 2)
+    {
+        rwlock_bench_run(RT_FALSE, readers, seconds);
+        rwlock_bench_run(RT_TRUE, readers, seconds);
+    }
+
+    rwlock_bench_pi();
+
+    rt_mutex_detach(&bench_mutex);
+    rt_rwlock_detach(&bench_rwlock);
+}
+MSH_CMD_EXPORT(rwlock_bench, Measure the read throughput of reader/writer lock and mutex with 1 to 8 readers);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_RWLOCK) && defined (RT_USING_MUTEX) */
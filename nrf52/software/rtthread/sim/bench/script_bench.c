@@ -0,0 +1,256 @@
+/*
+ * File      : script_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the script throughput of shell over simulated uart
+ * 2026-10-17     agent        add shell_rx_test, check the lines which are received in one chunk are all run
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <board.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (RT_USING_FINSH) && defined (FINSH_USING_SCRIPT) && defined (RT_USING_UART0)
+#include <finsh.h>
+
+#define SCRIPT_BENCH_LINE_SIZE         48
+/* the end of stream, the command releases the semaphore of bench */
+#define SCRIPT_BENCH_DONE              "__script_bench_done\n"
+
+enum script_bench_mode
+{
+    SCRIPT_BENCH_INTERACTIVE,
+    SCRIPT_BENCH_SCRIPT,
+};
+
+static char *bench_stream;
+static rt_size_t bench_stream_size;
+static struct rt_semaphore bench_done;
+static rt_uint32_t bench_lines, bench_baud;
+
+static rt_uint16_t script_bench_crc16(const char *data, rt_size_t size)
+{
+    rt_uint16_t crc = 0xFFFF;
+    rt_size_t i, bit;
+
+    for (i = 0; i < size; i++)
+    {
+        crc ^= (rt_uint16_t)((rt_uint8_t)data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (rt_uint16_t)((crc << 1) ^ 0x1021) : (rt_uint16_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+/* the configuration lines which are pasted to shell, the script mode lines are framed by CRC */
+static rt_size_t script_bench_build(char *stream, enum script_bench_mode mode)
+{
+    char line[SCRIPT_BENCH_LINE_SIZE];
+    rt_size_t size = 0, length;
+    rt_uint32_t i;
+
+    if (mode == SCRIPT_BENCH_SCRIPT)
+        size += rt_sprintf(&stream[size], "script begin\n");
+
+    for (i = 0; i < bench_lines; i++)
+    {
+        length = rt_snprintf(line, sizeof(line), "__nop cfg.key%d value-%08x", i, i * 2654435761u);
+        if (mode == SCRIPT_BENCH_SCRIPT)
+            size += rt_sprintf(&stream[size], "%s#%04X\n", line, script_bench_crc16(line, length));
+        else
+            size += rt_sprintf(&stream[size], "%s\n", line);
+    }
+
+    if (mode == SCRIPT_BENCH_SCRIPT)
+        size += rt_sprintf(&stream[size], "script end\n");
+    size += rt_sprintf(&stream[size], SCRIPT_BENCH_DONE);
+
+    return size;
+}
+
+/* the host thread is the terminal which pastes the stream */
+static void *script_bench_host_entry(void *parameter)
+{
+    rt_hw_sim_uart_inject(bench_stream, bench_stream_size);
+
+    return RT_NULL;
+}
+
+static void script_bench_run(const char *name, enum script_bench_mode mode, char *result, rt_size_t size)
+{
+    struct timespec start, end;
+    pthread_t host;
+    rt_size_t tx_bytes;
+    unsigned long long ns;
+
+    bench_stream_size = script_bench_build(bench_stream, mode);
+
+    tx_bytes = rt_hw_sim_uart_tx_bytes();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&host, RT_NULL, script_bench_host_entry, RT_NULL);
+    rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_join(host, RT_NULL);
+    tx_bytes = rt_hw_sim_uart_tx_bytes() - tx_bytes;
+
+    ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    rt_snprintf(result, size, "%-11s | %8d | %8d | %8d | %d\n", name, bench_lines,
+                (rt_uint32_t)(ns / 1000000), (rt_uint32_t)(bench_lines * 1000000000ULL / ns),
+                tx_bytes / bench_lines);
+}
+
+static void script_bench_entry(void *parameter)
+{
+    char interactive[80], script[80];
+
+    script_bench_run("interactive", SCRIPT_BENCH_INTERACTIVE, interactive, sizeof(interactive));
+    script_bench_run("script", SCRIPT_BENCH_SCRIPT, script, sizeof(script));
+
+    rt_hw_sim_uart_set_baud(0);
+    rt_free(bench_stream);
+    rt_sem_detach(&bench_done);
+
+    rt_kprintf("\nShell script bench, %d lines pasted at %d baud.\n", bench_lines, bench_baud);
+    rt_kprintf("mode        |    lines |  time ms |  lines/s | TX bytes / line\n");
+    rt_kprintf("----------- | -------- | -------- | -------- | ---------------\n");
+    rt_kprintf("%s", interactive);
+    rt_kprintf("%s", script);
+}
+
+static void script_bench_done(int argc, char **argv)
+{
+    rt_sem_release(&bench_done);
+}
+MSH_CMD_EXPORT_ALIAS(script_bench_done, __script_bench_done, Mark the end of the stream of script_bench);
+
+static void script_bench(int argc, char **argv)
+{
+    rt_thread_t thread;
+
+    bench_lines = 200;
+    bench_baud = 115200;
+    if (argc > 1)
+        bench_lines = atoi(argv[1]);
+    if (argc > 2)
+        bench_baud = atoi(argv[2]);
+    if (bench_lines == 0)
+    {
+        rt_kprintf("Usage: script_bench [lines] [baud rate, 0 is unlimited]\n");
+        return;
+    }
+
+    bench_stream = rt_malloc((bench_lines + 3) * SCRIPT_BENCH_LINE_SIZE);
+    if (bench_stream == RT_NULL)
+    {
+        rt_kprintf("No memory for %d lines.\n", bench_lines);
+        return;
+    }
+    rt_sem_init(&bench_done, "sbench", 0, RT_IPC_FLAG_FIFO);
+    rt_hw_sim_uart_set_baud(bench_baud);
+
+    /* the shell reads the pasted lines after this command is returned */
+    thread = rt_thread_create("sbench", script_bench_entry, RT_NULL, 2048, RT_THREAD_PRIORITY_MAX - 2, 10);
+    RT_ASSERT(thread != RT_NULL);
+    rt_thread_startup(thread);
+}
+MSH_CMD_EXPORT(script_bench, Measure the lines per second of pasted lines and script mode over simulated uart);
+
+/* the lines of shell_rx_test, the stream is shorter than the RX buffer of simulated uart, so it's one chunk */
+#define SHELL_RX_TEST_LINE             "__shell_rx_count\n"
+#define SHELL_RX_TEST_DONE             "__shell_rx_done\n"
+#define SHELL_RX_TEST_MAX_LINES        12
+
+static struct rt_semaphore shell_rx_done;
+static rt_uint32_t shell_rx_lines;
+static rt_bool_t shell_rx_running;
+
+static void *shell_rx_test_host_entry(void *parameter)
+{
+    rt_uint32_t lines = (rt_uint32_t)(rt_ubase_t)parameter, i;
+    char stream[SHELL_RX_TEST_MAX_LINES * (sizeof(SHELL_RX_TEST_LINE) - 1) + sizeof(SHELL_RX_TEST_DONE)];
+    rt_size_t size = 0;
+
+    for (i = 0; i < lines; i++)
+        size += rt_sprintf(&stream[size], SHELL_RX_TEST_LINE);
+    size += rt_sprintf(&stream[size], SHELL_RX_TEST_DONE);
+    rt_hw_sim_uart_inject(stream, size);
+
+    return RT_NULL;
+}
+
+static void shell_rx_test_entry(void *parameter)
+{
+    rt_uint32_t lines = (rt_uint32_t)(rt_ubase_t)parameter;
+    rt_device_t device = rt_device_find("uart0");
+    pthread_t host;
+    rt_err_t result;
+
+    /* wait for the shell is waiting for the input */
+    rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    pthread_create(&host, RT_NULL, shell_rx_test_host_entry, parameter);
+    result = rt_sem_take(&shell_rx_done, RT_TICK_PER_SECOND);
+    pthread_join(host, RT_NULL);
+    shell_rx_running = RT_FALSE;
+
+    rt_kprintf("\nShell RX test, %d lines in one chunk over %s RX: %d lines are run, %s.\n", lines,
+               (device->open_flag & RT_DEVICE_FLAG_DMA_RX) ? "DMA" : "interrupt", shell_rx_lines,
+               (result == RT_EOK && shell_rx_lines == lines) ? "PASS" : "FAIL");
+}
+
+static void shell_rx_count(int argc, char **argv)
+{
+    shell_rx_lines ++;
+}
+MSH_CMD_EXPORT_ALIAS(shell_rx_count, __shell_rx_count, Count the lines of shell_rx_test);
+
+static void shell_rx_test_done(int argc, char **argv)
+{
+    if (shell_rx_running)
+        rt_sem_release(&shell_rx_done);
+}
+MSH_CMD_EXPORT_ALIAS(shell_rx_test_done, __shell_rx_done, Mark the end of the lines of shell_rx_test);
+
+static void shell_rx_test(int argc, char **argv)
+{
+    static rt_bool_t inited = RT_FALSE;
+    rt_uint32_t lines = 8;
+    rt_thread_t thread;
+
+    if (argc > 1)
+        lines = atoi(argv[1]);
+    if (lines == 0 || lines > SHELL_RX_TEST_MAX_LINES || shell_rx_running)
+    {
+        rt_kprintf("Usage: shell_rx_test [lines, 1 ~ %d]\n", SHELL_RX_TEST_MAX_LINES);
+        return;
+    }
+
+    if (!inited)
+    {
+        rt_sem_init(&shell_rx_done, "shrxt", 0, RT_IPC_FLAG_FIFO);
+        inited = RT_TRUE;
+    }
+    rt_sem_control(&shell_rx_done, RT_IPC_CMD_RESET, 0);
+    shell_rx_lines = 0;
+    shell_rx_running = RT_TRUE;
+    rt_hw_sim_uart_set_baud(0);
+
+    /* the shell reads the lines after this command is returned */
+    thread = rt_thread_create("shrxt", shell_rx_test_entry, (void *)(rt_ubase_t)lines, 2048,
+                              RT_THREAD_PRIORITY_MAX - 2, 10);
+    RT_ASSERT(thread != RT_NULL);
+    rt_thread_startup(thread);
+}
+MSH_CMD_EXPORT(shell_rx_test, Check the shell runs all lines which are received in one chunk over simulated uart);
+#endif /* defined (RT_USING_FINSH) && defined (FINSH_USING_SCRIPT) && defined (RT_USING_UART0) */
@@ -0,0 +1,109 @@
+/*
+ * File      : timer_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the interrupt masked time of timer
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <cpuport.h>
+
+#include <stdlib.h>
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define TIMER_BENCH_COUNT_MAX          10000
+/* the periodic timers are started with the random timeout in this range */
+#define TIMER_BENCH_TIMEOUT_MIN        1000
+#define TIMER_BENCH_TIMEOUT_MAX        2000
+/* the ticks of timers running for each count */
+#define TIMER_BENCH_RUN_TICK           3000
+
+static struct rt_timer bench_timer[TIMER_BENCH_COUNT_MAX];
+static rt_uint32_t bench_timeout_count, bench_early_count, bench_late_count;
+
+static void timer_bench_timeout(void *parameter)
+{
+    struct rt_timer *timer = (struct rt_timer *)parameter;
+
+    bench_timeout_count ++;
+    /* the late timeout is caused by the host when the tickless sleep is woken up late */
+    if (rt_tick_get() - timer->timeout_tick >= RT_TICK_MAX / 2)
+        bench_early_count ++;
+    else if (rt_tick_get() != timer->timeout_tick)
+        bench_late_count ++;
+}
+
+static void timer_bench_run(rt_uint32_t count)
+{
+    rt_uint32_t i, start_max, check_max;
+
+    srand(count);
+    for (i = 0; i < count; i++)
+    {
+        rt_timer_init(&bench_timer[i], "bench", timer_bench_timeout, &bench_timer[i],
+                      TIMER_BENCH_TIMEOUT_MIN + rand() % (TIMER_BENCH_TIMEOUT_MAX - TIMER_BENCH_TIMEOUT_MIN),
+                      RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    }
+    bench_timeout_count = 0;
+    bench_early_count = 0;
+    bench_late_count = 0;
+
+    /* the longest interrupt masked time of starting timers */
+    rt_hw_sim_irqoff_measure(RT_TRUE);
+    for (i = 0; i < count; i++)
+    {
+        rt_timer_start(&bench_timer[i]);
+    }
+    start_max = rt_hw_sim_irqoff_max();
+
+    /* the longest interrupt masked time of tick interrupt, the timers are restarted in it */
+    rt_hw_sim_irqoff_measure(RT_TRUE);
+    rt_thread_delay(TIMER_BENCH_RUN_TICK);
+    check_max = rt_hw_sim_irqoff_max();
+    rt_hw_sim_irqoff_measure(RT_FALSE);
+
+    for (i = 0; i < count; i++)
+    {
+        rt_timer_detach(&bench_timer[i]);
+    }
+
+    rt_kprintf("%6d | %8d.%d | %7d.%d | %7d | %5d | %d\n", count, start_max / 1000, start_max % 1000 / 100,
+               check_max / 1000, check_max % 1000 / 100, bench_timeout_count, bench_early_count, bench_late_count);
+}
+
+static void timer_bench(int argc, char **argv)
+{
+    rt_uint32_t count, count_max = TIMER_BENCH_COUNT_MAX;
+
+    if (argc > 1)
+        count_max = atoi(argv[1]);
+    if (count_max == 0 || count_max > TIMER_BENCH_COUNT_MAX)
+    {
+        rt_kprintf("Usage: timer_bench [max count], the max count is %d.\n", TIMER_BENCH_COUNT_MAX);
+        return;
+    }
+
+#ifdef RT_USING_TIMER_WHEEL
+    rt_kprintf("Timer bench with timing wheel, %d ticks for each count.\n", TIMER_BENCH_RUN_TICK);
+#else
+    rt_kprintf("Timer bench with skip list, %d ticks for each count.\n", TIMER_BENCH_RUN_TICK);
+#endif
+    rt_kprintf("timers | start (us) | tick (us) | timeout | early | late\n");
+    rt_kprintf("------ | ---------- | --------- | ------- | ----- | ----\n");
+    for (count = 10; count <= count_max; count *= 10)
+    {
+        timer_bench_run(count);
+    }
+}
+MSH_CMD_EXPORT(timer_bench, Measure the longest interrupt masked time of timers);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,114 @@
+/*
+ * File      : trace_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, measure the cost of trace recorder
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <stdlib.h>
+#include <time.h>
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#define TRACE_BENCH_CYCLES()           __rdtsc()
+#else
+#define TRACE_BENCH_CYCLES()           0
+#endif
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_TRACE) && defined (RT_USING_SEMAPHORE) && defined (RT_USING_HEAP)
+#include <finsh.h>
+#include "trace.h"
+
+#define TRACE_BENCH_MALLOC_SIZE        32
+
+enum trace_bench_op
+{
+    TRACE_BENCH_RECORD,
+    TRACE_BENCH_SEM,
+    TRACE_BENCH_MALLOC,
+};
+
+static struct rt_semaphore bench_sem;
+
+static void trace_bench_op(enum trace_bench_op op, rt_uint32_t count)
+{
+    rt_uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        switch (op)
+        {
+        case TRACE_BENCH_RECORD:
+            rt_trace_record(RT_TRACE_USER, 0, i, 0);
+            break;
+        case TRACE_BENCH_SEM:
+            rt_sem_release(&bench_sem);
+            rt_sem_take(&bench_sem, 0);
+            break;
+        case TRACE_BENCH_MALLOC:
+            rt_free(rt_malloc(TRACE_BENCH_MALLOC_SIZE));
+            break;
+        }
+    }
+}
+
+static void trace_bench_run(const char *name, enum trace_bench_op op, rt_bool_t tracing, rt_uint32_t count)
+{
+    struct timespec start, end;
+    unsigned long long cycles, ns;
+
+    if (tracing)
+        rt_trace_start();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    cycles = TRACE_BENCH_CYCLES();
+    trace_bench_op(op, count);
+    cycles = TRACE_BENCH_CYCLES() - cycles;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (tracing)
+        rt_trace_stop();
+
+    ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    rt_kprintf("%-11s | %-5s | %7d | %8d | %d\n", name, tracing ? "on" : "off", count,
+               (rt_uint32_t)(ns / count), (rt_uint32_t)(cycles / count));
+}
+
+static void trace_bench(int argc, char **argv)
+{
+    rt_uint32_t count = 1000000;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (count == 0)
+    {
+        rt_kprintf("Usage: trace_bench [count]\n");
+        return;
+    }
+
+    rt_sem_init(&bench_sem, "trbench", 0, RT_IPC_FLAG_FIFO);
+
+    rt_kprintf("Trace recorder bench, %d events in ring buffer, %d bytes of each event.\n",
+               RT_TRACE_BUFFER_SIZE, sizeof(struct rt_trace_event));
+    rt_kprintf("operation   | trace |   count | ns / op  | cycles\n");
+    rt_kprintf("----------- | ----- | ------- | -------- | --------\n");
+    trace_bench_run("record", TRACE_BENCH_RECORD, RT_FALSE, count);
+    trace_bench_run("record", TRACE_BENCH_RECORD, RT_TRUE, count);
+    trace_bench_run("sem put/get", TRACE_BENCH_SEM, RT_FALSE, count);
+    trace_bench_run("sem put/get", TRACE_BENCH_SEM, RT_TRUE, count);
+    trace_bench_run("malloc/free", TRACE_BENCH_MALLOC, RT_FALSE, count);
+    trace_bench_run("malloc/free", TRACE_BENCH_MALLOC, RT_TRUE, count);
+
+    rt_sem_detach(&bench_sem);
+}
+MSH_CMD_EXPORT(trace_bench, Measure the cost of trace recorder on event and on semaphore and heap operations);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_TRACE) && defined (RT_USING_SEMAPHORE) && defined (RT_USING_HEAP) */
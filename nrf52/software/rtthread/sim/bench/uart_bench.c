@@ -0,0 +1,384 @@
+/*
+ * File      : uart_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version, check and measure the EasyDMA TX of nRF52 uart driver
+ * 2026-10-17     agent        add the RX bench of interrupt and EasyDMA mode with interrupt latency
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+/* the board.h of simulator, the board.h of nRF52 which is included by the driver has the same guard */
+#include <board.h>
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined (RT_USING_FINSH) && defined (RT_USING_SERIAL) && defined (RT_USING_UART0)
+#include <finsh.h>
+#include <nrf_drv_uart.h>
+
+/* The nRF52 uart driver is built with the UARTE model of stub, and it's registered as another serial
+ * device by the bench, so it isn't initialized by board and doesn't replace the uart0 of simulator. */
+#undef INIT_BOARD_EXPORT
+#define INIT_BOARD_EXPORT(fn)
+#define rt_hw_uart_init                uart_bench_hw_init
+#define uart0                          uart_bench_uart
+#define serial0                        uart_bench_serial
+#include "../../components/rtt_driver/uart.c"
+
+#define UART_BENCH_DEVICE_NAME         "nrfuart"
+#define UART_BENCH_TEXT                "The quick brown fox jumps over the lazy dog 0123456789.\n"
+/* the bytes of one write by putc, and the time to wait for the data is sent when the TX ringbuffer is full */
+#define UART_BENCH_WRITE_SIZE          64
+/* the wire is stopped when no byte is sent in this time */
+#define UART_BENCH_STALL_MS            200
+/* the RX data is sent in bursts with a gap, the gap is idle line */
+#define UART_BENCH_RX_BURST            4096
+#define UART_BENCH_RX_GAP_US           5000
+/* the RX is done when nothing is received in this ticks after all data is sent */
+#define UART_BENCH_RX_DONE_TICK        50
+/* the idle line time which the timeouts of idle line flush timer are counted in */
+#define UART_BENCH_RX_IDLE_TICK        RT_TICK_PER_SECOND
+
+/* the text in flash, it's copied to the bounce buffer of driver because EasyDMA can't read flash */
+static const char bench_flash_text[] =
+    UART_BENCH_TEXT UART_BENCH_TEXT UART_BENCH_TEXT UART_BENCH_TEXT
+    UART_BENCH_TEXT UART_BENCH_TEXT UART_BENCH_TEXT UART_BENCH_TEXT;
+#define UART_BENCH_BLOCK_SIZE          (sizeof(bench_flash_text) - 1)
+/* the text in RAM, it's sent by EasyDMA directly */
+static char bench_ram_text[UART_BENCH_BLOCK_SIZE];
+
+/* the sent bytes which are checked by the wire */
+static volatile rt_size_t bench_tx_bytes, bench_tx_errors;
+/* the max interrupt latency of RX runs in microsecond */
+static const rt_uint32_t bench_rx_latency[] = { 0, 50, 200, 1000 };
+static rt_size_t bench_rx_size;
+static volatile rt_bool_t bench_rx_sent;
+static volatile rt_uint32_t bench_rx_idle_timeouts;
+static rt_size_t (*bench_console_write)(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+
+static long long uart_bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/* the stream is the blocks of text in RAM (upper case) and in flash by turns */
+static char uart_bench_byte(rt_size_t n)
+{
+    char ch = bench_flash_text[n % UART_BENCH_BLOCK_SIZE];
+
+    return (n / UART_BENCH_BLOCK_SIZE) % 2 ? ch : toupper(ch);
+}
+
+/* the receiver on the other side of wire, it's invoked by the host thread of UARTE model */
+static void uart_bench_tx_handler(uint8_t byte)
+{
+    if (byte != (uint8_t)uart_bench_byte(bench_tx_bytes))
+        bench_tx_errors ++;
+    bench_tx_bytes ++;
+}
+
+static rt_device_t uart_bench_open(rt_uint16_t oflag, rt_uint32_t baud)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    struct nrf52_uart *uart = &uart_bench_uart;
+    rt_device_t dev;
+
+    dev = rt_device_find(UART_BENCH_DEVICE_NAME);
+    if (dev == RT_NULL)
+    {
+        uart_bench_serial.ops = &nrf52_uart_ops;
+        uart_bench_serial.config = config;
+        rt_ringbuffer_init(&uart->tx_rb, uart->tx_buffer, sizeof(uart->tx_buffer));
+        uart->rx_counter = UART0_DMA_RX_TIMER;
+        uart->rx_counter_irqn = UART0_DMA_RX_TIMER_IRQn;
+        uart->rx_counter_ppi_ch = UART0_DMA_RX_PPI_CH;
+        rt_hw_serial_register(&uart_bench_serial, UART_BENCH_DEVICE_NAME,
+                              RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX | RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX,
+                              uart);
+        dev = &uart_bench_serial.parent;
+    }
+
+    /* the baud rate is configured when it's opened, then it's opened again with the RX and TX mode */
+    config.baud_rate = baud;
+    if (rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+        return RT_NULL;
+    rt_device_control(dev, RT_DEVICE_CTRL_CONFIG, &config);
+    rt_device_close(dev);
+    if (rt_device_open(dev, oflag) != RT_EOK)
+        return RT_NULL;
+
+    return dev;
+}
+
+/* wait for the wire receives all sent bytes, it's stopped when no byte is sent for a while */
+static void uart_bench_tx_wait(rt_size_t size)
+{
+    rt_size_t bytes;
+    long long stall = uart_bench_now();
+
+    while (bench_tx_bytes < size)
+    {
+        bytes = bench_tx_bytes;
+        rt_thread_delay(1);
+        if (bytes != bench_tx_bytes)
+            stall = uart_bench_now();
+        else if (uart_bench_now() - stall > UART_BENCH_STALL_MS * 1000000LL)
+            break;
+    }
+}
+
+static void uart_bench_tx_run(const char *name, rt_bool_t dma, rt_uint32_t size, rt_uint32_t baud)
+{
+    struct nrf52_uart *uart = &uart_bench_uart;
+    char buf[UART_BENCH_WRITE_SIZE];
+    rt_device_t dev;
+    rt_uint32_t irq_count, i, len;
+    long long start, ns;
+
+    dev = uart_bench_open(RT_DEVICE_OFLAG_RDWR | (dma ? RT_DEVICE_FLAG_DMA_TX : 0), baud);
+    if (dev == RT_NULL)
+    {
+        rt_kprintf("Open %s device failed.\n", UART_BENCH_DEVICE_NAME);
+        return;
+    }
+
+    bench_tx_bytes = bench_tx_errors = 0;
+    irq_count = sim_uarte_irq_count();
+    start = uart_bench_now();
+    if (dma)
+    {
+        /* the queued blocks are sent by EasyDMA in 255 bytes transfers */
+        for (i = 0; i < size; i += UART_BENCH_BLOCK_SIZE)
+        {
+            if ((i / UART_BENCH_BLOCK_SIZE) % 2)
+                rt_device_write(dev, 0, bench_flash_text, UART_BENCH_BLOCK_SIZE);
+            else
+                rt_device_write(dev, 0, bench_ram_text, UART_BENCH_BLOCK_SIZE);
+        }
+        size = i;
+    }
+    else
+    {
+        /* the putc drops the byte when the TX ringbuffer is full, so it's written when there is space */
+        for (i = 0; i < size; i += len)
+        {
+            len = size - i < sizeof(buf) ? size - i : sizeof(buf);
+            while (rt_ringbuffer_space_len(&uart->tx_rb) < len)
+                rt_thread_delay(1);
+            for (len = 0; len < sizeof(buf) && i + len < size; len++)
+                buf[len] = uart_bench_byte(i + len);
+            rt_device_write(dev, 0, buf, len);
+        }
+    }
+    uart_bench_tx_wait(size);
+    ns = uart_bench_now() - start;
+    irq_count = sim_uarte_irq_count() - irq_count;
+    rt_device_close(dev);
+
+    rt_kprintf("%-6s | %8d | %10d | %6d | %13d.%d | %4d\n", name, size, bench_tx_bytes, bench_tx_errors + size - bench_tx_bytes,
+               irq_count * 1024 / size, irq_count * 10240 / size % 10, (rt_uint32_t)(size * 1000000000LL / 1024 / ns));
+}
+
+static void uart_bench_tx(int argc, char **argv)
+{
+    rt_uint32_t size = 64 * 1024, baud = 1000000, i;
+
+    if (argc > 2)
+        size = atoi(argv[2]) * 1024;
+    if (argc > 3)
+        baud = atoi(argv[3]);
+    if (size == 0 || baud == 0)
+    {
+        rt_kprintf("Usage: uart_bench tx [KB] [baud]\n");
+        return;
+    }
+
+    for (i = 0; i < UART_BENCH_BLOCK_SIZE; i++)
+        bench_ram_text[i] = toupper(bench_flash_text[i]);
+
+    sim_uarte_set_latency(0);
+    sim_uarte_set_tx_handler(uart_bench_tx_handler);
+    rt_kprintf("Uart TX bench, %d KB are sent at %d baud by the nRF52 uart driver over the UARTE model.\n",
+               size / 1024, baud);
+    rt_kprintf("mode   |    bytes | wire bytes | errors | interrupts / KB | KB/s\n");
+    rt_kprintf("------ | -------- | ---------- | ------ | --------------- | ----\n");
+    uart_bench_tx_run("putc", RT_FALSE, size, baud);
+    uart_bench_tx_run("DMA TX", RT_TRUE, size, baud);
+    sim_uarte_set_tx_handler(RT_NULL);
+}
+
+/* the error of every overrun is printed by the driver, it's dropped in the RX runs */
+static rt_size_t uart_bench_console_drop(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    return size;
+}
+
+static void uart_bench_capture(rt_bool_t enable)
+{
+    rt_device_t console = rt_console_get_device();
+
+    if (console == RT_NULL)
+        return;
+
+    if (enable)
+    {
+        bench_console_write = console->write;
+        console->write = uart_bench_console_drop;
+    }
+    else
+    {
+        console->write = bench_console_write;
+    }
+}
+
+static void uart_bench_timer_hook(struct rt_timer *timer)
+{
+    if (timer == &uart_bench_uart.rx_idle_timer)
+        bench_rx_idle_timeouts ++;
+}
+
+/* the host thread is the sender on the other side of wire, the byte is the low byte of its offset */
+static void *uart_bench_rx_host_entry(void *parameter)
+{
+    static uint8_t burst[UART_BENCH_RX_BURST];
+    rt_size_t sent, len, i;
+
+    for (sent = 0; sent < bench_rx_size; sent += len)
+    {
+        len = bench_rx_size - sent < sizeof(burst) ? bench_rx_size - sent : sizeof(burst);
+        for (i = 0; i < len; i++)
+            burst[i] = (uint8_t)(sent + i);
+        sim_uarte_rx_inject(burst, len);
+        usleep(UART_BENCH_RX_GAP_US);
+    }
+    bench_rx_sent = RT_TRUE;
+
+    return RT_NULL;
+}
+
+static void uart_bench_rx_run(const char *name, rt_uint16_t oflag, rt_uint32_t latency, rt_uint32_t baud)
+{
+    rt_uint8_t buf[256], expected = 0;
+    rt_device_t dev;
+    pthread_t host;
+    rt_size_t received = 0, gaps = 0, len, i;
+    rt_uint32_t irq_count, overrun_count, idle_timeouts, tick = 0;
+    long long start, last;
+
+    dev = uart_bench_open(RT_DEVICE_OFLAG_RDWR | oflag, baud);
+    if (dev == RT_NULL)
+    {
+        rt_kprintf("Open %s device failed.\n", UART_BENCH_DEVICE_NAME);
+        return;
+    }
+
+    uart_bench_capture(RT_TRUE);
+    sim_uarte_set_latency(latency);
+    bench_rx_sent = RT_FALSE;
+    irq_count = sim_uarte_irq_count();
+    overrun_count = sim_uarte_overrun_count();
+    start = last = uart_bench_now();
+    pthread_create(&host, RT_NULL, uart_bench_rx_host_entry, RT_NULL);
+    /* the consumer reads every tick, a gap is a byte which isn't the next byte of the last one */
+    while (!bench_rx_sent || tick < UART_BENCH_RX_DONE_TICK)
+    {
+        rt_thread_delay(1);
+        tick ++;
+        while ((len = rt_device_read(dev, 0, buf, sizeof(buf))) > 0)
+        {
+            for (i = 0; i < len; i++)
+            {
+                if (buf[i] != expected)
+                    gaps ++;
+                expected = buf[i] + 1;
+            }
+            received += len;
+            last = uart_bench_now();
+            tick = 0;
+        }
+    }
+    pthread_join(host, RT_NULL);
+    irq_count = sim_uarte_irq_count() - irq_count;
+    overrun_count = sim_uarte_overrun_count() - overrun_count;
+
+    /* the idle line flush timer isn't run when the line is idle */
+    bench_rx_idle_timeouts = 0;
+    rt_timer_timeout_sethook(uart_bench_timer_hook);
+    rt_thread_delay(UART_BENCH_RX_IDLE_TICK);
+    rt_timer_timeout_sethook(RT_NULL);
+    idle_timeouts = bench_rx_idle_timeouts;
+
+    sim_uarte_set_latency(0);
+    rt_device_close(dev);
+    uart_bench_capture(RT_FALSE);
+
+    rt_kprintf("%-6s | %10d | %8d | %8d | %3d%% | %6d | %8d | %15d | %4d | %d\n", name, latency, bench_rx_size, received,
+               (bench_rx_size - received) * 100 / bench_rx_size, gaps, overrun_count, irq_count * 1024 / bench_rx_size,
+               (rt_uint32_t)(received * 1000000000LL / 1024 / (last - start + 1)), idle_timeouts);
+}
+
+static void uart_bench_rx(int argc, char **argv)
+{
+    rt_uint32_t baud = 1000000, i;
+
+    bench_rx_size = 64 * 1024;
+    if (argc > 2)
+        bench_rx_size = atoi(argv[2]) * 1024;
+    if (argc > 3)
+        baud = atoi(argv[3]);
+    if (bench_rx_size == 0 || baud == 0)
+    {
+        rt_kprintf("Usage: uart_bench rx [KB] [baud]\n");
+        return;
+    }
+
+    rt_kprintf("Uart RX bench, %d KB are received at %d baud in %d bytes bursts by the nRF52 uart driver over the UARTE model,\n",
+               bench_rx_size / 1024, baud, UART_BENCH_RX_BURST);
+    rt_kprintf("the consumer reads every tick, and the UARTE interrupt is served after a random latency.\n");
+    rt_kprintf("mode   | latency us |     sent | received | lost |   gaps | overruns | interrupts / KB | KB/s | idle timeouts / s\n");
+    rt_kprintf("------ | ---------- | -------- | -------- | ---- | ------ | -------- | --------------- | ---- | -----------------\n");
+    for (i = 0; i < sizeof(bench_rx_latency) / sizeof(bench_rx_latency[0]); i++)
+        uart_bench_rx_run("INT RX", RT_DEVICE_FLAG_INT_RX, bench_rx_latency[i], baud);
+    for (i = 0; i < sizeof(bench_rx_latency) / sizeof(bench_rx_latency[0]); i++)
+        uart_bench_rx_run("DMA RX", RT_DEVICE_FLAG_DMA_RX, bench_rx_latency[i], baud);
+}
+
+static void uart_bench(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "";
+
+    if (!strcmp(mode, "tx"))
+    {
+        uart_bench_tx(argc, argv);
+        return;
+    }
+    if (!strcmp(mode, "rx"))
+    {
+        uart_bench_rx(argc, argv);
+        return;
+    }
+
+    rt_kprintf("Usage: uart_bench <mode> [options]\n");
+    rt_kprintf("  tx [KB] [baud]                 check and measure the TX by putc and DMA TX\n");
+    rt_kprintf("  rx [KB] [baud]                 check and measure the RX by interrupt and DMA RX with latency\n");
+}
+MSH_CMD_EXPORT(uart_bench, Check and measure the nRF52 uart driver over the UARTE model: tx rx);
+#endif /* defined (RT_USING_FINSH) && defined (RT_USING_SERIAL) && defined (RT_USING_UART0) */
@@ -0,0 +1,298 @@
+/*
+ * File      : board.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version for POSIX host simulator
+ * 2026-10-17     agent        add tickless sleep and the tick test command
+ * 2026-10-17     agent        add the trace timestamp by host monotonic clock
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "board.h"
+
+#define NSEC_PER_SEC                   1000000000L
+
+/* the simulated RAM for system heap */
+rt_uint8_t rt_hw_sim_sram[SIM_SRAM_SIZE];
+
+static pthread_t systick_thread;
+/* the count of tick interrupts and tickless sleep wakeups, it's shown by the tick_test command */
+static volatile rt_uint32_t systick_isr_count, tickless_wakeup_count;
+
+#ifdef RT_USING_TICKLESS
+/* the sleep which is shorter than it is waited with the periodic SysTick */
+#define TICKLESS_SLEEP_MIN_TICK        2
+
+static pthread_mutex_t systick_lock = PTHREAD_MUTEX_INITIALIZER;
+/* the tick is counted by the SysTick thread in sleep too, it's the RTC COUNTER on nRF52 */
+static rt_tick_t systick_counter;
+static rt_tick_t systick_compare;
+static rt_bool_t systick_stopped;
+#endif /* RT_USING_TICKLESS */
+
+void SysTick_Handler(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    systick_isr_count ++;
+    rt_tick_increase();
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/* the host thread which is the SysTick timer */
+static void *systick_thread_entry(void *parameter)
+{
+    struct timespec next, now;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (1)
+    {
+        next.tv_nsec += NSEC_PER_SEC / RT_TICK_PER_SECOND;
+        if (next.tv_nsec >= NSEC_PER_SEC)
+        {
+            next.tv_sec ++;
+            next.tv_nsec -= NSEC_PER_SEC;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, RT_NULL);
+
+        /* the lost ticks are not caught up when the host is too busy, like the single pending bit of SysTick */
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > next.tv_sec + 1)
+        {
+            next = now;
+        }
+
+#ifdef RT_USING_TICKLESS
+        pthread_mutex_lock(&systick_lock);
+        systick_counter ++;
+        if (!systick_stopped)
+        {
+            rt_hw_sim_interrupt_trigger(SIM_SYSTICK_IRQ);
+        }
+        else if (systick_counter == systick_compare)
+        {
+            rt_hw_sim_interrupt_trigger(SIM_RTC_IRQ);
+        }
+        pthread_mutex_unlock(&systick_lock);
+#else
+        rt_hw_sim_interrupt_trigger(SIM_SYSTICK_IRQ);
+#endif
+    }
+
+    return RT_NULL;
+}
+
+#ifdef RT_USING_TICKLESS
+/* the RTC compare interrupt is only used to wake up the CPU */
+static void RTC1_IRQHandler(void)
+{
+}
+
+/**
+ * This function will stop the SysTick interrupt and sleep until the RTC
+ * compare or other interrupt, it's invoked by idle thread with interrupt disabled.
+ *
+ * @param timeout the tick to the next timer timeout
+ *
+ * @return the tick which is passed in sleep
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t timeout)
+{
+    rt_tick_t start, passed;
+
+    if (timeout < TICKLESS_SLEEP_MIN_TICK)
+    {
+        rt_hw_sim_interrupt_wait();
+        return 0;
+    }
+
+    /* the pending tick before stop is counted by SysTick_Handler */
+    pthread_mutex_lock(&systick_lock);
+    systick_stopped = RT_TRUE;
+    start = systick_counter;
+    systick_compare = start + timeout;
+    pthread_mutex_unlock(&systick_lock);
+
+    /* the interrupt is masked, so it only waits for the wakeup */
+    rt_hw_sim_interrupt_wait();
+
+    pthread_mutex_lock(&systick_lock);
+    systick_stopped = RT_FALSE;
+    passed = systick_counter - start;
+    pthread_mutex_unlock(&systick_lock);
+
+    tickless_wakeup_count ++;
+
+    return passed;
+}
+#endif /* RT_USING_TICKLESS */
+
+#ifdef RT_USING_TRACE
+/* the trace timestamp is in 10ns, it's unwrapped as a 32-bit counter by the converter like the DWT cycle counter */
+#define TRACE_TIMESTAMP_FREQUENCY      100000000L
+
+/**
+ * This function will get the timestamp of trace event. It's the host monotonic
+ * clock, because the cycle counter (rt_hw_cycle_get) is the CPU time of each
+ * host thread in simulator.
+ *
+ * @return the timestamp
+ */
+rt_uint32_t rt_hw_trace_timestamp(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec * NSEC_PER_SEC + now.tv_nsec) / (NSEC_PER_SEC / TRACE_TIMESTAMP_FREQUENCY);
+}
+
+/**
+ * This function will get the frequency of trace timestamp.
+ *
+ * @return the frequency in Hz
+ */
+rt_uint32_t rt_hw_trace_frequency(void)
+{
+    return TRACE_TIMESTAMP_FREQUENCY;
+}
+#endif /* RT_USING_TRACE */
+
+/* wait for the interrupt on idle, so the simulator is not spinning on host */
+static void sim_idle_hook(void)
+{
+    fflush(stdout);
+#ifndef RT_USING_TICKLESS
+    rt_hw_sim_interrupt_wait();
+#endif
+}
+
+void rt_hw_board_init()
+{
+    /* configure the SysTick */
+    rt_hw_sim_interrupt_install(SIM_SYSTICK_IRQ, SysTick_Handler);
+#ifdef RT_USING_TICKLESS
+    rt_hw_sim_interrupt_install(SIM_RTC_IRQ, RTC1_IRQHandler);
+#endif
+    if (pthread_create(&systick_thread, RT_NULL, systick_thread_entry, RT_NULL) != 0)
+    {
+        perror("SysTick thread create");
+        exit(1);
+    }
+
+    rt_thread_idle_sethook(sim_idle_hook);
+
+    /* components init for board */
+    rt_components_board_init();
+
+#ifdef RT_USING_CONSOLE
+    rt_console_set_device(RT_CONSOLE_DEVICE_NAME);
+#endif
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+static void sim_exit(void)
+{
+    rt_hw_cpu_shutdown();
+}
+MSH_CMD_EXPORT_ALIAS(sim_exit, exit, Exit the simulator);
+
+#define TICK_TEST_TIMER_PERIOD         100
+
+struct tick_test
+{
+    struct timespec start;
+    rt_uint32_t count;
+    long max_error;
+};
+
+static long tick_test_elapsed_ms(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+/* measure the timeout error of the periodic timer by host clock */
+static void tick_test_timeout(void *parameter)
+{
+    struct tick_test *test = (struct tick_test *)parameter;
+    long error;
+
+    test->count ++;
+    error = tick_test_elapsed_ms(&test->start) - (long)test->count * TICK_TEST_TIMER_PERIOD;
+    if (error < 0)
+        error = -error;
+    if (error > test->max_error)
+        test->max_error = error;
+}
+
+static void tick_test(int argc, char **argv)
+{
+    struct tick_test test = { { 0 }, 0, 0 };
+    rt_timer_t timer;
+    rt_uint32_t seconds = 5, isr_count, wakeup_count;
+    rt_tick_t tick;
+    long elapsed;
+
+    if (argc > 1)
+        seconds = atoi(argv[1]);
+    if (seconds == 0)
+    {
+        rt_kprintf("Usage: tick_test [seconds]\n");
+        return;
+    }
+
+    timer = rt_timer_create("tktest", tick_test_timeout, &test,
+                            rt_tick_from_millisecond(TICK_TEST_TIMER_PERIOD), RT_TIMER_FLAG_PERIODIC);
+    if (timer == RT_NULL)
+    {
+        rt_kprintf("Create the test timer failed.\n");
+        return;
+    }
+
+    rt_kprintf("Tick test %d seconds with a %dms periodic timer...\n", seconds, TICK_TEST_TIMER_PERIOD);
+    isr_count = systick_isr_count;
+    wakeup_count = tickless_wakeup_count;
+    tick = rt_tick_get();
+    clock_gettime(CLOCK_MONOTONIC, &test.start);
+    rt_timer_start(timer);
+
+    /* the last timeout is in the middle of the timer period */
+    rt_thread_delay(rt_tick_from_millisecond(seconds * 1000 + TICK_TEST_TIMER_PERIOD / 2));
+
+    rt_timer_stop(timer);
+    elapsed = tick_test_elapsed_ms(&test.start);
+    isr_count = systick_isr_count - isr_count;
+    wakeup_count = tickless_wakeup_count - wakeup_count;
+    tick = rt_tick_get() - tick;
+    rt_timer_delete(timer);
+
+    rt_kprintf("tick interrupt  : %d (%d/s)\n", isr_count, isr_count / seconds);
+    rt_kprintf("tickless wakeup : %d (%d/s)\n", wakeup_count, wakeup_count / seconds);
+    rt_kprintf("system tick     : %d, host time: %dms\n", tick, elapsed);
+    rt_kprintf("timer timeout   : %d/%d, max error: %dms\n", test.count, seconds * 1000 / TICK_TEST_TIMER_PERIOD,
+               test.max_error);
+}
+MSH_CMD_EXPORT(tick_test, Count the tick interrupts and check the timer accuracy);
+#endif
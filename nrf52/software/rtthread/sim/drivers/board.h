@@ -0,0 +1,48 @@
+/*
+ * File      : board.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version for POSIX host simulator
+ * 2026-10-17     agent        the SysTick has the lowest interrupt priority like nRF52
+ * 2026-10-17     agent        leave the highest interrupt priorities for zero-latency interrupts
+ * 2026-10-17     agent        add the baud rate model and the input injection of uart
+ */
+
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+#include <rtthread.h>
+#include <cpuport.h>
+
+/* the heap size is same as the nRF52832 RAM size */
+#define SIM_SRAM_SIZE        (64*1024)
+
+extern rt_uint8_t rt_hw_sim_sram[SIM_SRAM_SIZE];
+#define NRF_SRAM_BEGIN       (rt_hw_sim_sram)
+#define NRF_SRAM_END         (rt_hw_sim_sram + SIM_SRAM_SIZE)
+
+/* the simulated interrupt number, the SysTick has the lowest priority, so it's preempted by others.
+ * The 0 and 1 are left for the zero-latency interrupts of RT_USING_BASEPRI, which can't call kernel. */
+#define SIM_UART0_IRQ        2
+#define SIM_RTC_IRQ          3
+#define SIM_SYSTICK_IRQ      4
+/* the UARTE0 and TIMER1 of the nRF52 uart driver, they are modeled by the stub for uart_bench */
+#define SIM_UARTE0_IRQ       6
+#define SIM_TIMER1_IRQ       7
+
+#define RT_USING_UART0
+
+void rt_hw_board_init(void);
+
+void rt_hw_sim_uart_set_baud(rt_uint32_t baud_rate);
+void rt_hw_sim_uart_inject(const void *buf, rt_size_t size);
+rt_size_t rt_hw_sim_uart_tx_bytes(void);
+
+#endif
@@ -0,0 +1,467 @@
+/*
+ * File      : uart.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2017, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version for POSIX host simulator, uart0 is the stdin and stdout
+ * 2026-10-17     agent        add the baud rate model, the input injection and the TX byte counter
+ * 2026-10-17     agent        add DMA RX mode, all received bytes are moved to serial device RX fifo by one event
+ */
+
+#include <rthw.h>
+#include <rtdevice.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "board.h"
+
+/* the RX buffer between stdin reading thread and uart0 interrupt, it's the RX FIFO of uart */
+#define UART_SIM_RX_BUF_SIZE           256
+/* the interval of retry the interrupt when the serial device RX fifo is full */
+#define UART_SIM_RX_RETRY_MS           1
+/* the host thread sleeps when it's ahead of the baud rate by this time, the sleep of every byte is too coarse */
+#define UART_SIM_PACE_NS               200000LL
+
+struct sim_uart
+{
+    int irq;
+    rt_bool_t rx_int_enabled;
+    /* the received bytes are moved to RX fifo by the RX interrupt in DMA RX mode */
+    rt_bool_t rx_dma_enabled;
+
+    rt_bool_t rx_started;
+    /* the byte which can be read by current RX interrupt */
+    rt_bool_t rx_ready;
+    pthread_t rx_thread;
+    pthread_mutex_t rx_lock;
+    pthread_cond_t rx_space;
+    rt_uint8_t rx_buf[UART_SIM_RX_BUF_SIZE];
+    rt_size_t rx_get, rx_put;
+    /* the host time of the end of last byte by the baud rate in nanosecond */
+    long long rx_due, tx_due;
+    rt_size_t tx_bytes;
+};
+
+#if defined(RT_USING_UART0)
+static struct sim_uart uart0 =
+{
+    SIM_UART0_IRQ,
+    RT_FALSE,
+    RT_FALSE,
+    RT_FALSE,
+    RT_FALSE,
+    0,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+};
+struct rt_serial_device serial0;
+#endif /* RT_USING_UART0 */
+
+static struct termios stdin_termios;
+static rt_bool_t stdin_raw;
+/* the nanoseconds of one byte (10 bits) by the simulated baud rate, 0: as fast as stdio */
+static long long uart_byte_ns;
+
+static long long uart_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/* the time of transferring one byte, it returns how long the caller is ahead of the baud rate */
+static long long uart_pace(long long *due)
+{
+    long long now;
+
+    if (uart_byte_ns == 0)
+        return 0;
+
+    now = uart_now();
+    if (*due < now)
+        *due = now;
+    *due += uart_byte_ns;
+
+    return *due - now;
+}
+
+static void uart_sleep(long long ns)
+{
+    struct timespec interval;
+
+    interval.tv_sec = ns / 1000000000LL;
+    interval.tv_nsec = ns % 1000000000LL;
+    while (nanosleep(&interval, &interval) != 0 && errno == EINTR);
+}
+
+static void stdin_restore(void)
+{
+    if (stdin_raw)
+    {
+        tcsetattr(STDIN_FILENO, TCSANOW, &stdin_termios);
+        stdin_raw = RT_FALSE;
+    }
+}
+
+static void stdin_restore_on_signal(int sig)
+{
+    stdin_restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+/* the terminal is a raw serial port for finsh, it will echo and edit the line by itself */
+static void stdin_set_raw(void)
+{
+    struct termios raw;
+
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &stdin_termios) != 0)
+        return;
+
+    raw = stdin_termios;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_iflag &= ~(ICRNL | IXON);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0)
+    {
+        stdin_raw = RT_TRUE;
+        atexit(stdin_restore);
+        signal(SIGINT, stdin_restore_on_signal);
+        signal(SIGTERM, stdin_restore_on_signal);
+    }
+}
+
+/* free space of the serial device RX fifo, the uart will stop receiving when it's full like RTS/CTS */
+static rt_size_t serial_rx_fifo_space(struct rt_serial_device *serial)
+{
+    struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *)serial->serial_rx;
+
+    if (rx_fifo == RT_NULL)
+        return 0;
+
+    return (rx_fifo->get_index + serial->config.bufsz - rx_fifo->put_index - 1) % serial->config.bufsz;
+}
+
+/* wait for the RX buffer is read by interrupt, it's retried when the serial device RX fifo is full */
+static void uart_rx_wait(struct sim_uart *uart, rt_size_t used)
+{
+    struct timespec timeout;
+
+    while (uart->rx_put - uart->rx_get > used)
+    {
+        clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_nsec += UART_SIM_RX_RETRY_MS * 1000000L;
+        if (timeout.tv_nsec >= 1000000000L)
+        {
+            timeout.tv_sec ++;
+            timeout.tv_nsec -= 1000000000L;
+        }
+        if (pthread_cond_timedwait(&uart->rx_space, &uart->rx_lock, &timeout) == ETIMEDOUT
+                && uart->rx_int_enabled)
+        {
+            rt_hw_sim_interrupt_trigger(uart->irq);
+        }
+    }
+}
+
+/* receive the data in host thread, it's paced by the baud rate */
+static void uart_rx_push(struct sim_uart *uart, const rt_uint8_t *buf, rt_size_t len)
+{
+    long long ahead;
+    rt_size_t i;
+
+    pthread_mutex_lock(&uart->rx_lock);
+    for (i = 0; i < len; i++)
+    {
+        uart_rx_wait(uart, UART_SIM_RX_BUF_SIZE - 1);
+        uart->rx_buf[uart->rx_put++ % UART_SIM_RX_BUF_SIZE] = buf[i];
+
+        ahead = uart_pace(&uart->rx_due);
+        if (ahead > UART_SIM_PACE_NS)
+        {
+            /* the received bytes are reported while the next is on the wire */
+            if (uart->rx_int_enabled)
+            {
+                rt_hw_sim_interrupt_trigger(uart->irq);
+            }
+            pthread_mutex_unlock(&uart->rx_lock);
+            uart_sleep(ahead);
+            pthread_mutex_lock(&uart->rx_lock);
+        }
+    }
+    if (uart->rx_int_enabled)
+    {
+        rt_hw_sim_interrupt_trigger(uart->irq);
+    }
+    /* all received data is moved to serial device before next reading */
+    uart_rx_wait(uart, 0);
+    pthread_mutex_unlock(&uart->rx_lock);
+}
+
+/* the host thread which is the uart receiver */
+static void *uart_rx_thread_entry(void *parameter)
+{
+    struct sim_uart *uart = (struct sim_uart *)parameter;
+    rt_uint8_t buf[64];
+    ssize_t len;
+
+    while (1)
+    {
+        len = read(STDIN_FILENO, buf, sizeof(buf));
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0)
+            break;
+
+        uart_rx_push(uart, buf, len);
+    }
+
+    return RT_NULL;
+}
+
+/* move all received bytes to the serial device RX fifo and report them by one event like a DMA block */
+static void uart_dma_rx_isr(struct rt_serial_device *serial, struct sim_uart *uart)
+{
+    struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *)serial->serial_rx;
+    rt_size_t len, i, put_index;
+
+    pthread_mutex_lock(&uart->rx_lock);
+    len = uart->rx_put - uart->rx_get;
+    if (len > serial_rx_fifo_space(serial))
+        len = serial_rx_fifo_space(serial);
+    put_index = rx_fifo->put_index;
+    for (i = 0; i < len; i++)
+    {
+        rx_fifo->buffer[put_index] = uart->rx_buf[uart->rx_get++ % UART_SIM_RX_BUF_SIZE];
+        put_index = (put_index + 1) % serial->config.bufsz;
+    }
+    if (len > 0)
+        pthread_cond_signal(&uart->rx_space);
+    pthread_mutex_unlock(&uart->rx_lock);
+
+    if (len > 0)
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_DMADONE | (len << 8));
+}
+
+static void uart_rx_isr(struct rt_serial_device *serial, struct sim_uart *uart)
+{
+    rt_bool_t ready;
+
+    if (uart->rx_dma_enabled)
+    {
+        uart_dma_rx_isr(serial, uart);
+        return;
+    }
+
+    /* every byte is reported by one RX interrupt like the uart hardware */
+    while (1)
+    {
+        pthread_mutex_lock(&uart->rx_lock);
+        ready = uart->rx_get != uart->rx_put && serial_rx_fifo_space(serial) > 0;
+        uart->rx_ready = ready;
+        pthread_mutex_unlock(&uart->rx_lock);
+        if (!ready)
+            break;
+
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+    }
+}
+
+#if defined(RT_USING_UART0)
+static void uart0_irq_handler(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    uart_rx_isr(&serial0, &uart0);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+#endif /* RT_USING_UART0 */
+
+static rt_err_t sim_configure(struct rt_serial_device *serial, struct serial_configure *cfg)
+{
+    struct sim_uart *uart = (struct sim_uart *)serial->parent.user_data;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(uart != RT_NULL);
+    RT_ASSERT(cfg != RT_NULL);
+
+    /* the baud rate and data format are nonsense for stdio */
+    if (!uart->rx_started)
+    {
+        uart->rx_started = RT_TRUE;
+        stdin_set_raw();
+        if (pthread_create(&uart->rx_thread, RT_NULL, uart_rx_thread_entry, uart) != 0)
+        {
+            return -RT_ERROR;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t sim_control(struct rt_serial_device *serial, int cmd, void *arg)
+{
+    struct sim_uart *uart = (struct sim_uart *)serial->parent.user_data;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(uart != RT_NULL);
+
+    switch (cmd)
+    {
+    case RT_DEVICE_CTRL_CLR_INT:
+        uart->rx_int_enabled = RT_FALSE;
+        uart->rx_dma_enabled = RT_FALSE;
+        break;
+    case RT_DEVICE_CTRL_SET_INT:
+        uart->rx_int_enabled = RT_TRUE;
+        /* the data which is received before open */
+        rt_hw_sim_interrupt_trigger(uart->irq);
+        break;
+    case RT_DEVICE_CTRL_CONFIG:
+        /* the RX fifo has been created by serial device */
+        if ((rt_uint32_t) arg == RT_DEVICE_FLAG_DMA_RX)
+        {
+            uart->rx_dma_enabled = RT_TRUE;
+            uart->rx_int_enabled = RT_TRUE;
+            rt_hw_sim_interrupt_trigger(uart->irq);
+        }
+        break;
+    }
+
+    return RT_EOK;
+}
+
+static int sim_putc(struct rt_serial_device *serial, char ch)
+{
+    struct sim_uart *uart = (struct sim_uart *)serial->parent.user_data;
+    long long ahead;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    putchar(ch);
+    /* the output is also flushed on idle */
+    if (ch == '\n')
+    {
+        fflush(stdout);
+    }
+
+    /* the putc is polling until the byte is sent like the uart hardware */
+    uart->tx_bytes ++;
+    ahead = uart_pace(&uart->tx_due);
+    if (ahead > UART_SIM_PACE_NS)
+    {
+        uart_sleep(ahead);
+    }
+
+    return 1;
+}
+
+static int sim_getc(struct rt_serial_device *serial)
+{
+    struct sim_uart *uart = (struct sim_uart *)serial->parent.user_data;
+    int ch = -1;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(uart != RT_NULL);
+
+    pthread_mutex_lock(&uart->rx_lock);
+    if (uart->rx_ready)
+    {
+        uart->rx_ready = RT_FALSE;
+        ch = uart->rx_buf[uart->rx_get++ % UART_SIM_RX_BUF_SIZE];
+        pthread_cond_signal(&uart->rx_space);
+    }
+    pthread_mutex_unlock(&uart->rx_lock);
+
+    return ch;
+}
+
+static const struct rt_uart_ops sim_uart_ops =
+{
+    sim_configure,
+    sim_control,
+    sim_putc,
+    sim_getc,
+    RT_NULL,
+};
+
+int rt_hw_uart_init(void)
+{
+    struct sim_uart *uart;
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    rt_uint32_t flag;
+
+#ifdef RT_USING_UART0
+    uart = &uart0;
+
+    serial0.ops    = &sim_uart_ops;
+    serial0.config = config;
+
+    rt_hw_sim_interrupt_install(uart->irq, uart0_irq_handler);
+
+    flag = RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX;
+#ifdef RT_USING_UART0_DMA_RX
+    flag |= RT_DEVICE_FLAG_DMA_RX;
+#endif
+
+    /* register UART0 device */
+    rt_hw_serial_register(&serial0, "uart0", flag, uart);
+#endif /* RT_USING_UART0 */
+
+    return 0;
+}
+INIT_BOARD_EXPORT(rt_hw_uart_init);
+
+/**
+ * This function will set the simulated baud rate of uart, the RX and TX are
+ * paced by it (10 bits per byte).
+ *
+ * @param baud_rate the baud rate, 0 is as fast as stdio
+ */
+void rt_hw_sim_uart_set_baud(rt_uint32_t baud_rate)
+{
+    uart_byte_ns = baud_rate ? 10 * 1000000000LL / baud_rate : 0;
+}
+
+#if defined(RT_USING_UART0)
+/**
+ * This function will inject the data to uart0 RX like the stdin, it shall be
+ * invoked by a host thread, it returns when the data is moved to serial device.
+ *
+ * @param buf the data
+ * @param size the size of data
+ */
+void rt_hw_sim_uart_inject(const void *buf, rt_size_t size)
+{
+    uart_rx_push(&uart0, (const rt_uint8_t *)buf, size);
+}
+
+/**
+ * This function will return the bytes sent by uart0.
+ *
+ * @return the bytes sent by uart0
+ */
+rt_size_t rt_hw_sim_uart_tx_bytes(void)
+{
+    return uart0.tx_bytes;
+}
+#endif /* RT_USING_UART0 */
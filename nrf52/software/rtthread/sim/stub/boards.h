@@ -0,0 +1,16 @@
+/*
+ * The boards.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ */
+
+#ifndef SIM_BOARDS_H
+#define SIM_BOARDS_H
+
+#include <stdint.h>
+
+#define LEDS_NUMBER    4
+
+void bsp_board_leds_init(void);
+void bsp_board_led_invert(uint32_t led_idx);
+uint32_t bsp_board_led_state_get(uint32_t led_idx);
+
+#endif /* SIM_BOARDS_H */
@@ -0,0 +1,19 @@
+/*
+ * The cm_backtrace.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ */
+
+#ifndef SIM_CM_BACKTRACE_H
+#define SIM_CM_BACKTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* it returns a fake exception stack frame on host */
+uintptr_t cmb_get_sp(void);
+
+void cm_backtrace_init(const char *firmware_name, const char *hardware_ver, const char *software_ver);
+void cm_backtrace_firmware_info(void);
+void cm_backtrace_assert(uintptr_t sp);
+void cm_backtrace_fault(uint32_t fault_handler_lr, uintptr_t fault_handler_sp);
+
+#endif /* SIM_CM_BACKTRACE_H */
@@ -0,0 +1,10 @@
+/*
+ * The nordic_common.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ */
+
+#ifndef SIM_NORDIC_COMMON_H
+#define SIM_NORDIC_COMMON_H
+
+#include <stdint.h>
+
+#endif /* SIM_NORDIC_COMMON_H */
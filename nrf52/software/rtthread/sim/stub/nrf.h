@@ -0,0 +1,102 @@
+/*
+ * The nrf.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ *
+ * The UARTE0, TIMER1 and PPI registers which are used by the nRF52 uart driver are modeled by
+ * nrf_drv_uart.c of the stub, the other peripherals are not simulated.
+ */
+
+#ifndef SIM_NRF_H
+#define SIM_NRF_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    UARTE0_UART0_IRQn = 2,
+    TIMER1_IRQn       = 9,
+} IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t TASKS_COUNT;
+    volatile uint32_t TASKS_CLEAR;
+    volatile uint32_t TASKS_SHUTDOWN;
+    volatile uint32_t TASKS_CAPTURE[6];
+    volatile uint32_t EVENTS_COMPARE[6];
+    volatile uint32_t SHORTS;
+    volatile uint32_t INTENSET;
+    volatile uint32_t INTENCLR;
+    volatile uint32_t MODE;
+    volatile uint32_t BITMODE;
+    volatile uint32_t PRESCALER;
+    volatile uint32_t CC[6];
+} NRF_TIMER_Type;
+
+typedef struct
+{
+    volatile uint32_t EEP;
+    volatile uint32_t TEP;
+} PPI_CH_Type;
+
+typedef struct
+{
+    volatile uint32_t CHEN;
+    volatile uint32_t CHENSET;
+    volatile uint32_t CHENCLR;
+    PPI_CH_Type CH[20];
+} NRF_PPI_Type;
+
+typedef struct
+{
+    volatile uint32_t EVENTS_RXDRDY;
+    volatile uint32_t EVENTS_ENDRX;
+    volatile uint32_t EVENTS_ENDTX;
+    volatile uint32_t EVENTS_ERROR;
+    volatile uint32_t ERRORSRC;
+    volatile uint32_t BAUDRATE;
+} NRF_UARTE_Type;
+
+extern NRF_TIMER_Type sim_nrf_timer1;
+extern NRF_PPI_Type sim_nrf_ppi;
+extern NRF_UARTE_Type sim_nrf_uarte0;
+
+#define NRF_TIMER1                             (&sim_nrf_timer1)
+#define NRF_PPI                                (&sim_nrf_ppi)
+#define NRF_UARTE0                             (&sim_nrf_uarte0)
+
+#define TIMER_INTENSET_COMPARE1_Msk            (0x1UL << 17)
+#define TIMER_INTENCLR_COMPARE1_Msk            (0x1UL << 17)
+#define TIMER_MODE_MODE_Pos                    0
+#define TIMER_MODE_MODE_Timer                  0
+#define TIMER_MODE_MODE_Counter                1
+#define TIMER_BITMODE_BITMODE_Pos              0
+#define TIMER_BITMODE_BITMODE_32Bit            3
+
+#define UARTE_ERRORSRC_OVERRUN_Msk             (0x1UL << 0)
+
+#define UART_CONFIG_HWFC_Disabled              0
+#define UART_CONFIG_HWFC_Enabled               1
+
+/* the register value is the baud rate * 2^32 / 16MHz */
+#define UARTE_BAUDRATE_BAUDRATE_Baud1200       0x0004F000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud2400       0x0009D000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud4800       0x0013B000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud9600       0x00275000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud14400      0x003AF000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud19200      0x004EA000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud28800      0x0075C000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud31250      0x00800000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud38400      0x009D0000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud56000      0x00E50000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud57600      0x00EB0000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud76800      0x013A9000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud115200     0x01D60000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud230400     0x03B00000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud250000     0x04000000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud460800     0x07400000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud921600     0x0F000000UL
+#define UARTE_BAUDRATE_BAUDRATE_Baud1M         0x10000000UL
+
+#endif /* SIM_NRF_H */
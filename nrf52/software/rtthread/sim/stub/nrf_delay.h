@@ -0,0 +1,13 @@
+/*
+ * The nrf_delay.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ */
+
+#ifndef SIM_NRF_DELAY_H
+#define SIM_NRF_DELAY_H
+
+#include <stdint.h>
+
+void nrf_delay_us(uint32_t number_of_us);
+void nrf_delay_ms(uint32_t number_of_ms);
+
+#endif /* SIM_NRF_DELAY_H */
@@ -0,0 +1,19 @@
+/*
+ * The nrf_drv_common.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ */
+
+#ifndef SIM_NRF_DRV_COMMON_H
+#define SIM_NRF_DRV_COMMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "nrf.h"
+
+/* the code and constant data of simulator is the flash, which can't be read by EasyDMA */
+bool nrf_drv_is_in_RAM(void const *p_object);
+
+void nrf_drv_common_irq_enable(IRQn_Type IRQn, uint8_t priority);
+void nrf_drv_common_irq_disable(IRQn_Type IRQn);
+
+#endif /* SIM_NRF_DRV_COMMON_H */
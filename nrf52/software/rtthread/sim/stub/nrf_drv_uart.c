@@ -0,0 +1,670 @@
+/*
+ * The nRF5 SDK UART driver stub for RT-Thread POSIX host simulator. It's a model of the EasyDMA UARTE,
+ * and the TIMER and PPI which count the received bytes by the RXDRDY event.
+ *
+ * The wire is run by a host thread in the byte time of baud rate. The EasyDMA reads the TX data and
+ * writes the RX data in the byte time, so the buffers must be kept in RAM until the transfer is done
+ * like the hardware. The interrupt is triggered after a random latency of 0 to sim_uarte_set_latency
+ * of the wire time, and the wire waits until it's served, so the result doesn't depend on the host.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "board.h"
+#include "nrf_drv_common.h"
+#include "nrf_drv_uart.h"
+
+/* the bytes which are received when there is no EasyDMA buffer, then the next byte is overrun */
+#define SIM_UARTE_RX_FIFO_SIZE         4
+#define SIM_UARTE_EVENT_MAX            16
+/* the wire sleeps when it's ahead of the host time by this time, the sleep of every byte is too coarse */
+#define SIM_UARTE_PACE_NS              200000LL
+/* the wire doesn't catch up the host time which is lost when the host is busy */
+#define SIM_UARTE_LAG_NS               1000000LL
+/* the wire goes on when the interrupt isn't served in this time, it's masked by a long critical section */
+#define SIM_UARTE_SERVE_TIMEOUT_MS     20
+/* the PPI channels and TIMER compare registers of model */
+#define SIM_PPI_CH_NUM                 20
+#define SIM_TIMER_CC_NUM               6
+#define SIM_TIMER_INTEN_COMPARE_Pos    16
+
+NRF_TIMER_Type sim_nrf_timer1;
+NRF_PPI_Type sim_nrf_ppi;
+NRF_UARTE_Type sim_nrf_uarte0;
+
+/* the handler of TIMER1 interrupt is defined by the driver which uses it */
+void TIMER1_IRQHandler(void) __attribute__((weak));
+
+struct sim_irq
+{
+    int irq;
+    rt_bool_t enabled;
+    /* the interrupt is raised, it's triggered at the due time of wire */
+    rt_bool_t pending;
+    long long due;
+    rt_uint32_t served;
+};
+
+struct sim_uarte
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wakeup;
+    pthread_cond_t served;
+    pthread_t thread;
+    rt_bool_t started;
+
+    nrf_uart_event_handler_t handler;
+    void *context;
+    /* the time of wire and the time of one byte (10 bits) in nanosecond */
+    long long now;
+    long long byte_ns;
+    rt_uint32_t latency_ns;
+    rt_uint32_t seed;
+
+    const uint8_t *tx_buf;
+    rt_size_t tx_len, tx_pos;
+    void (*tx_handler)(uint8_t byte);
+
+    /* the primary and secondary EasyDMA buffer, the secondary is started by ENDRX like the ENDRX_STARTRX short */
+    uint8_t *rx_buf[2];
+    rt_size_t rx_len[2];
+    rt_size_t rx_amount;
+    uint8_t *rx_last;
+    uint8_t rx_fifo[SIM_UARTE_RX_FIFO_SIZE];
+    rt_size_t rx_fifo_len;
+    /* the injected data which is on the wire */
+    const uint8_t *rx_wire;
+    rt_size_t rx_wire_len;
+
+    /* the events which are reported by the next UARTE interrupt */
+    nrf_drv_uart_event_t event[SIM_UARTE_EVENT_MAX];
+    rt_size_t event_get, event_put;
+    /* the ERROR event is reported once for the overrun bytes before the interrupt */
+    rt_bool_t error_reported;
+    struct sim_irq uarte_irq, timer_irq;
+
+    rt_uint32_t timer_count, timer_inten, ppi_chen;
+    rt_bool_t timer_running;
+
+    rt_uint32_t irq_count, overrun_count;
+};
+
+static struct sim_uarte uarte0 =
+{
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+};
+
+static long long sim_uarte_host_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/* the wire time which is behind the host time is moved to the host time */
+static void sim_uarte_sync(struct sim_uarte *uarte)
+{
+    long long host = sim_uarte_host_now();
+
+    if (uarte->now < host - SIM_UARTE_LAG_NS)
+        uarte->now = host;
+}
+
+static void sim_irq_raise(struct sim_uarte *uarte, struct sim_irq *irq)
+{
+    if (!irq->enabled || irq->pending)
+        return;
+
+    irq->pending = RT_TRUE;
+    irq->due = uarte->now;
+    if (uarte->latency_ns)
+    {
+        uarte->seed = uarte->seed * 1103515245 + 12345;
+        irq->due += (uarte->seed >> 8) % (uarte->latency_ns + 1);
+    }
+    pthread_cond_broadcast(&uarte->wakeup);
+}
+
+/* trigger the interrupt which is due, and wait for it is served */
+static void sim_irq_serve(struct sim_uarte *uarte, struct sim_irq *irq)
+{
+    struct timespec timeout;
+    rt_uint32_t served;
+
+    if (!irq->pending || irq->due > uarte->now)
+        return;
+
+    irq->pending = RT_FALSE;
+    served = irq->served;
+    rt_hw_sim_interrupt_trigger(irq->irq);
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_nsec += SIM_UARTE_SERVE_TIMEOUT_MS * 1000000L;
+    if (timeout.tv_nsec >= 1000000000L)
+    {
+        timeout.tv_sec ++;
+        timeout.tv_nsec -= 1000000000L;
+    }
+    while (irq->served == served)
+    {
+        if (pthread_cond_timedwait(&uarte->served, &uarte->lock, &timeout) == ETIMEDOUT)
+            break;
+    }
+}
+
+static void sim_uarte_event(struct sim_uarte *uarte, nrf_drv_uart_evt_type_t type, uint8_t *p_data, rt_size_t bytes)
+{
+    nrf_drv_uart_event_t *event;
+
+    if (type == NRF_DRV_UART_EVT_ERROR)
+    {
+        if (uarte->error_reported)
+            return;
+        uarte->error_reported = RT_TRUE;
+    }
+    RT_ASSERT(uarte->event_put - uarte->event_get < SIM_UARTE_EVENT_MAX);
+
+    event = &uarte->event[uarte->event_put++ % SIM_UARTE_EVENT_MAX];
+    event->type = type;
+    event->data.rxtx.p_data = p_data;
+    event->data.rxtx.bytes = bytes;
+    if (type == NRF_DRV_UART_EVT_ERROR)
+        event->data.error.error_mask = UARTE_ERRORSRC_OVERRUN_Msk;
+    sim_irq_raise(uarte, &uarte->uarte_irq);
+}
+
+/* the SDK ignores the ENDRX of the transfers which are aborted by the error */
+static void sim_uarte_drop_rx_done(struct sim_uarte *uarte)
+{
+    rt_size_t get, put = uarte->event_get;
+
+    for (get = uarte->event_get; get != uarte->event_put; get++)
+    {
+        if (uarte->event[get % SIM_UARTE_EVENT_MAX].type != NRF_DRV_UART_EVT_RX_DONE)
+            uarte->event[put++ % SIM_UARTE_EVENT_MAX] = uarte->event[get % SIM_UARTE_EVENT_MAX];
+    }
+    uarte->event_put = put;
+}
+
+/* The tasks and INTENSET/INTENCLR of TIMER and CHENSET/CHENCLR of PPI are run by the model when the next
+ * byte is on the wire or the driver calls the model. The CAPTURE task can't be run by writing the register
+ * on host, so the counter is always captured to CC[0]. */
+static void sim_timer_run_tasks(struct sim_uarte *uarte)
+{
+    NRF_TIMER_Type *timer = NRF_TIMER1;
+    rt_uint32_t set, clr;
+
+    if (__atomic_exchange_n(&timer->TASKS_STOP, 0, __ATOMIC_ACQ_REL))
+        uarte->timer_running = RT_FALSE;
+    if (__atomic_exchange_n(&timer->TASKS_CLEAR, 0, __ATOMIC_ACQ_REL))
+    {
+        uarte->timer_count = 0;
+        timer->CC[0] = 0;
+    }
+    if (__atomic_exchange_n(&timer->TASKS_START, 0, __ATOMIC_ACQ_REL))
+        uarte->timer_running = RT_TRUE;
+
+    clr = __atomic_exchange_n(&timer->INTENCLR, 0, __ATOMIC_ACQ_REL);
+    set = __atomic_exchange_n(&timer->INTENSET, 0, __ATOMIC_ACQ_REL);
+    uarte->timer_inten = (uarte->timer_inten & ~clr) | set;
+
+    clr = __atomic_exchange_n(&NRF_PPI->CHENCLR, 0, __ATOMIC_ACQ_REL);
+    set = __atomic_exchange_n(&NRF_PPI->CHENSET, 0, __ATOMIC_ACQ_REL);
+    uarte->ppi_chen = (uarte->ppi_chen & ~clr) | set;
+    NRF_PPI->CHEN = uarte->ppi_chen;
+}
+
+static void sim_timer_count(struct sim_uarte *uarte)
+{
+    NRF_TIMER_Type *timer = NRF_TIMER1;
+    int i;
+
+    if (!uarte->timer_running || timer->MODE != TIMER_MODE_MODE_Counter)
+        return;
+
+    timer->CC[0] = ++ uarte->timer_count;
+    for (i = 1; i < SIM_TIMER_CC_NUM; i++)
+    {
+        if (timer->CC[i] == uarte->timer_count)
+        {
+            timer->EVENTS_COMPARE[i] = 1;
+            if (uarte->timer_inten & (1UL << (SIM_TIMER_INTEN_COMPARE_Pos + i)))
+                sim_irq_raise(uarte, &uarte->timer_irq);
+        }
+    }
+}
+
+/* the RXDRDY event, it's connected to the COUNT task of TIMER1 by PPI */
+static void sim_uarte_rxdrdy(struct sim_uarte *uarte)
+{
+    int ch;
+
+    NRF_UARTE0->EVENTS_RXDRDY = 1;
+    for (ch = 0; ch < SIM_PPI_CH_NUM; ch++)
+    {
+        if ((uarte->ppi_chen & (1UL << ch))
+                && NRF_PPI->CH[ch].EEP == (uint32_t)(rt_ubase_t)&NRF_UARTE0->EVENTS_RXDRDY
+                && NRF_PPI->CH[ch].TEP == (uint32_t)(rt_ubase_t)&NRF_TIMER1->TASKS_COUNT)
+        {
+            sim_timer_count(uarte);
+        }
+    }
+}
+
+/* the primary buffer is full, the secondary buffer is started and the RX FIFO is moved to it */
+static void sim_uarte_rx_fill(struct sim_uarte *uarte)
+{
+    rt_size_t i;
+
+    while (uarte->rx_len[0])
+    {
+        while (uarte->rx_fifo_len && uarte->rx_amount < uarte->rx_len[0])
+        {
+            uarte->rx_buf[0][uarte->rx_amount++] = uarte->rx_fifo[0];
+            uarte->rx_fifo_len --;
+            for (i = 0; i < uarte->rx_fifo_len; i++)
+                uarte->rx_fifo[i] = uarte->rx_fifo[i + 1];
+        }
+        if (uarte->rx_amount < uarte->rx_len[0])
+            break;
+
+        NRF_UARTE0->EVENTS_ENDRX = 1;
+        sim_uarte_event(uarte, NRF_DRV_UART_EVT_RX_DONE, uarte->rx_buf[0], uarte->rx_amount);
+        uarte->rx_buf[0] = uarte->rx_buf[1];
+        uarte->rx_len[0] = uarte->rx_len[1];
+        uarte->rx_len[1] = 0;
+        uarte->rx_amount = 0;
+        if (uarte->rx_len[0])
+            uarte->rx_last = uarte->rx_buf[0];
+    }
+}
+
+static void sim_uarte_rx_byte(struct sim_uarte *uarte)
+{
+    uint8_t byte;
+
+    if (uarte->rx_wire_len == 0)
+        return;
+
+    byte = *uarte->rx_wire++;
+    if (-- uarte->rx_wire_len == 0)
+        pthread_cond_broadcast(&uarte->wakeup);
+
+    if (uarte->rx_fifo_len < SIM_UARTE_RX_FIFO_SIZE)
+    {
+        uarte->rx_fifo[uarte->rx_fifo_len++] = byte;
+        sim_uarte_rxdrdy(uarte);
+        sim_uarte_rx_fill(uarte);
+    }
+    else
+    {
+        /* the byte is lost, the error event reports the current buffer and aborts it like the SDK */
+        uarte->overrun_count ++;
+        NRF_UARTE0->EVENTS_ERROR = 1;
+        NRF_UARTE0->ERRORSRC |= UARTE_ERRORSRC_OVERRUN_Msk;
+        sim_uarte_event(uarte, NRF_DRV_UART_EVT_ERROR, RT_NULL, 0);
+    }
+}
+
+static void sim_uarte_tx_byte(struct sim_uarte *uarte)
+{
+    if (uarte->tx_len == 0)
+        return;
+
+    /* the EasyDMA reads the data when it's sent */
+    if (uarte->tx_handler)
+        uarte->tx_handler(uarte->tx_buf[uarte->tx_pos]);
+    if (++ uarte->tx_pos == uarte->tx_len)
+    {
+        NRF_UARTE0->EVENTS_ENDTX = 1;
+        sim_uarte_event(uarte, NRF_DRV_UART_EVT_TX_DONE, (uint8_t *)uarte->tx_buf, uarte->tx_len);
+        uarte->tx_len = 0;
+    }
+}
+
+/* the host thread which is the wire */
+static void *sim_uarte_thread_entry(void *parameter)
+{
+    struct sim_uarte *uarte = (struct sim_uarte *)parameter;
+    struct timespec interval;
+    long long ahead;
+
+    pthread_mutex_lock(&uarte->lock);
+    while (1)
+    {
+        while (uarte->tx_len == 0 && uarte->rx_wire_len == 0
+                && !uarte->uarte_irq.pending && !uarte->timer_irq.pending)
+        {
+            pthread_cond_wait(&uarte->wakeup, &uarte->lock);
+        }
+
+        sim_uarte_sync(uarte);
+        if (uarte->tx_len || uarte->rx_wire_len)
+        {
+            uarte->now += uarte->byte_ns;
+            sim_timer_run_tasks(uarte);
+            sim_uarte_tx_byte(uarte);
+            sim_uarte_rx_byte(uarte);
+        }
+        else
+        {
+            /* the line is idle, the time goes to the next interrupt */
+            if (uarte->uarte_irq.pending && uarte->uarte_irq.due > uarte->now)
+                uarte->now = uarte->uarte_irq.due;
+            if (uarte->timer_irq.pending && uarte->timer_irq.due > uarte->now)
+                uarte->now = uarte->timer_irq.due;
+        }
+
+        /* the interrupts which are due are served before the next byte */
+        sim_irq_serve(uarte, &uarte->uarte_irq);
+        sim_irq_serve(uarte, &uarte->timer_irq);
+
+        ahead = uarte->now - sim_uarte_host_now();
+        if (ahead > SIM_UARTE_PACE_NS)
+        {
+            pthread_mutex_unlock(&uarte->lock);
+            interval.tv_sec = ahead / 1000000000LL;
+            interval.tv_nsec = ahead % 1000000000LL;
+            while (nanosleep(&interval, &interval) != 0 && errno == EINTR);
+            pthread_mutex_lock(&uarte->lock);
+        }
+    }
+
+    return RT_NULL;
+}
+
+static void sim_uarte_isr(void)
+{
+    struct sim_uarte *uarte = &uarte0;
+    nrf_drv_uart_event_t event;
+
+    pthread_mutex_lock(&uarte->lock);
+    if (uarte->event_get != uarte->event_put)
+        uarte->irq_count ++;
+    while (uarte->event_get != uarte->event_put)
+    {
+        event = uarte->event[uarte->event_get++ % SIM_UARTE_EVENT_MAX];
+        if (event.type == NRF_DRV_UART_EVT_ERROR)
+        {
+            /* the SDK reports the current buffer with the error, and aborts the transfer */
+            uarte->error_reported = RT_FALSE;
+            event.data.error.rxtx.p_data = uarte->rx_last;
+            event.data.error.rxtx.bytes = uarte->rx_amount;
+            uarte->rx_len[0] = uarte->rx_len[1] = 0;
+            uarte->rx_amount = 0;
+            NRF_UARTE0->ERRORSRC = 0;
+            sim_uarte_drop_rx_done(uarte);
+        }
+        pthread_mutex_unlock(&uarte->lock);
+        if (uarte->handler)
+            uarte->handler(&event, uarte->context);
+        pthread_mutex_lock(&uarte->lock);
+    }
+    uarte->uarte_irq.served ++;
+    pthread_cond_broadcast(&uarte->served);
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+static void sim_timer1_isr(void)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    if (TIMER1_IRQHandler)
+        TIMER1_IRQHandler();
+
+    pthread_mutex_lock(&uarte->lock);
+    uarte->irq_count ++;
+    uarte->timer_irq.served ++;
+    pthread_cond_broadcast(&uarte->served);
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+bool nrf_drv_is_in_RAM(void const *p_object)
+{
+    extern char __executable_start[], __data_start[];
+
+    return (const char *)p_object < __executable_start || (const char *)p_object >= __data_start;
+}
+
+void nrf_drv_common_irq_enable(IRQn_Type IRQn, uint8_t priority)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    sim_timer_run_tasks(uarte);
+    if (IRQn == TIMER1_IRQn)
+        uarte->timer_irq.enabled = RT_TRUE;
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+void nrf_drv_common_irq_disable(IRQn_Type IRQn)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    sim_timer_run_tasks(uarte);
+    if (IRQn == TIMER1_IRQn)
+    {
+        uarte->timer_irq.enabled = RT_FALSE;
+        uarte->timer_irq.pending = RT_FALSE;
+    }
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+ret_code_t nrf_drv_uart_init(nrf_drv_uart_t const *p_instance, nrf_drv_uart_config_t const *p_config,
+                             nrf_uart_event_handler_t event_handler)
+{
+    struct sim_uarte *uarte = &uarte0;
+    ret_code_t result = NRF_SUCCESS;
+
+    pthread_mutex_lock(&uarte->lock);
+    if (uarte->handler)
+    {
+        result = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        uarte->handler = event_handler;
+        uarte->context = p_config->p_context;
+        NRF_UARTE0->BAUDRATE = p_config->baudrate;
+        /* the baud rate is the register value * 16MHz / 2^32 */
+        uarte->byte_ns = 10 * 1000000000LL / (((unsigned long long)p_config->baudrate * 16000000) >> 32);
+        uarte->uarte_irq.irq = SIM_UARTE0_IRQ;
+        uarte->uarte_irq.enabled = RT_TRUE;
+        uarte->timer_irq.irq = SIM_TIMER1_IRQ;
+        rt_hw_sim_interrupt_install(SIM_UARTE0_IRQ, sim_uarte_isr);
+        rt_hw_sim_interrupt_install(SIM_TIMER1_IRQ, sim_timer1_isr);
+        if (!uarte->started && pthread_create(&uarte->thread, RT_NULL, sim_uarte_thread_entry, uarte) == 0)
+            uarte->started = RT_TRUE;
+    }
+    pthread_mutex_unlock(&uarte->lock);
+
+    return result;
+}
+
+void nrf_drv_uart_uninit(nrf_drv_uart_t const *p_instance)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    uarte->handler = RT_NULL;
+    uarte->tx_len = 0;
+    uarte->rx_len[0] = uarte->rx_len[1] = 0;
+    uarte->rx_amount = 0;
+    uarte->rx_fifo_len = 0;
+    uarte->event_get = uarte->event_put;
+    uarte->error_reported = RT_FALSE;
+    uarte->uarte_irq.enabled = RT_FALSE;
+    uarte->uarte_irq.pending = RT_FALSE;
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+ret_code_t nrf_drv_uart_tx(nrf_drv_uart_t const *p_instance, uint8_t const * const p_data, uint8_t length)
+{
+    struct sim_uarte *uarte = &uarte0;
+    ret_code_t result = NRF_SUCCESS;
+
+    if (!nrf_drv_is_in_RAM(p_data))
+        return NRF_ERROR_INVALID_ADDR;
+
+    pthread_mutex_lock(&uarte->lock);
+    if (uarte->tx_len)
+    {
+        result = NRF_ERROR_BUSY;
+    }
+    else if (length)
+    {
+        uarte->tx_buf = p_data;
+        uarte->tx_len = length;
+        uarte->tx_pos = 0;
+        pthread_cond_broadcast(&uarte->wakeup);
+    }
+    pthread_mutex_unlock(&uarte->lock);
+
+    return result;
+}
+
+bool nrf_drv_uart_tx_in_progress(nrf_drv_uart_t const *p_instance)
+{
+    return uarte0.tx_len != 0;
+}
+
+ret_code_t nrf_drv_uart_rx(nrf_drv_uart_t const *p_instance, uint8_t *p_data, uint8_t length)
+{
+    struct sim_uarte *uarte = &uarte0;
+    ret_code_t result = NRF_SUCCESS;
+
+    if (!nrf_drv_is_in_RAM(p_data))
+        return NRF_ERROR_INVALID_ADDR;
+
+    pthread_mutex_lock(&uarte->lock);
+    sim_uarte_sync(uarte);
+    sim_timer_run_tasks(uarte);
+    if (uarte->rx_len[0] == 0)
+    {
+        uarte->rx_buf[0] = p_data;
+        uarte->rx_len[0] = length;
+        uarte->rx_amount = 0;
+        uarte->rx_last = p_data;
+        sim_uarte_rx_fill(uarte);
+    }
+    else if (uarte->rx_len[1] == 0)
+    {
+        uarte->rx_buf[1] = p_data;
+        uarte->rx_len[1] = length;
+    }
+    else
+    {
+        result = NRF_ERROR_BUSY;
+    }
+    pthread_mutex_unlock(&uarte->lock);
+
+    return result;
+}
+
+void nrf_drv_uart_rx_enable(nrf_drv_uart_t const *p_instance)
+{
+    /* the EasyDMA UARTE receives when the buffer is set */
+}
+
+void nrf_drv_uart_rx_disable(nrf_drv_uart_t const *p_instance)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    uarte->rx_len[0] = uarte->rx_len[1] = 0;
+    uarte->rx_amount = 0;
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+void nrf_drv_uart_rx_abort(nrf_drv_uart_t const *p_instance)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    sim_uarte_sync(uarte);
+    sim_timer_run_tasks(uarte);
+    /* the received data of current buffer is reported by the RXTO event */
+    if (uarte->rx_len[0])
+        sim_uarte_event(uarte, NRF_DRV_UART_EVT_RX_DONE, uarte->rx_buf[0], uarte->rx_amount);
+    uarte->rx_len[0] = uarte->rx_len[1] = 0;
+    uarte->rx_amount = 0;
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+/**
+ * This function will set the handler of the bytes which are sent by UARTE, it's invoked by the wire thread.
+ *
+ * @param handler the handler, RT_NULL: the sent bytes are dropped
+ */
+void sim_uarte_set_tx_handler(void (*handler)(uint8_t byte))
+{
+    pthread_mutex_lock(&uarte0.lock);
+    uarte0.tx_handler = handler;
+    pthread_mutex_unlock(&uarte0.lock);
+}
+
+/**
+ * This function will set the max latency of UARTE and TIMER interrupts, the latency of every
+ * interrupt is random, and the wire goes on in the latency.
+ *
+ * @param max_us the max latency in microsecond
+ */
+void sim_uarte_set_latency(uint32_t max_us)
+{
+    pthread_mutex_lock(&uarte0.lock);
+    uarte0.latency_ns = max_us * 1000;
+    uarte0.seed = 1;
+    pthread_mutex_unlock(&uarte0.lock);
+}
+
+/**
+ * This function will send the data to UARTE RX on the wire, it shall be invoked by a host thread,
+ * and it returns when the data is received.
+ *
+ * @param buf the data
+ * @param size the size of data
+ */
+void sim_uarte_rx_inject(const void *buf, size_t size)
+{
+    struct sim_uarte *uarte = &uarte0;
+
+    pthread_mutex_lock(&uarte->lock);
+    while (uarte->rx_wire_len)
+        pthread_cond_wait(&uarte->wakeup, &uarte->lock);
+    uarte->rx_wire = (const uint8_t *)buf;
+    uarte->rx_wire_len = size;
+    pthread_cond_broadcast(&uarte->wakeup);
+    while (uarte->rx_wire_len)
+        pthread_cond_wait(&uarte->wakeup, &uarte->lock);
+    pthread_mutex_unlock(&uarte->lock);
+}
+
+/**
+ * This function will return the count of UARTE and TIMER interrupts.
+ *
+ * @return the count of interrupts
+ */
+uint32_t sim_uarte_irq_count(void)
+{
+    return uarte0.irq_count;
+}
+
+/**
+ * This function will return the bytes which are lost by the RX overrun.
+ *
+ * @return the lost bytes
+ */
+uint32_t sim_uarte_overrun_count(void)
+{
+    return uarte0.overrun_count;
+}
@@ -0,0 +1,112 @@
+/*
+ * The nrf_drv_uart.h stub for RT-Thread POSIX host simulator, the nRF5 SDK and CmBacktrace is not built on host.
+ *
+ * The UART driver of nRF5 SDK is modeled with the EasyDMA UARTE by nrf_drv_uart.c of the stub, the other
+ * side of the wire is a host thread of bench, see the sim_uarte_* functions.
+ */
+
+#ifndef SIM_NRF_DRV_UART_H
+#define SIM_NRF_DRV_UART_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nrf.h"
+
+typedef uint32_t ret_code_t;
+
+#define NRF_SUCCESS                            0
+#define NRF_ERROR_INVALID_STATE                8
+#define NRF_ERROR_INVALID_ADDR                 16
+#define NRF_ERROR_BUSY                         17
+
+#define NRF_UART_PSEL_DISCONNECTED             0xFFFFFFFF
+/* the lowest application interrupt priority of nRF52 */
+#define UART_DEFAULT_CONFIG_IRQ_PRIORITY       7
+
+typedef struct
+{
+    NRF_UARTE_Type *p_uarte;
+    uint8_t drv_inst_idx;
+} nrf_drv_uart_t;
+
+#define NRF_DRV_UART_INSTANCE(id)              { NRF_UARTE0, id }
+
+typedef struct
+{
+    uint32_t pseltxd;
+    uint32_t pselrxd;
+    uint32_t pselcts;
+    uint32_t pselrts;
+    void *p_context;
+    uint32_t hwfc;
+    uint32_t parity;
+    uint32_t baudrate;
+    uint8_t interrupt_priority;
+    bool use_easy_dma;
+} nrf_drv_uart_config_t;
+
+#define NRF_DRV_UART_DEFAULT_CONFIG                            \
+    {                                                          \
+        .pseltxd            = NRF_UART_PSEL_DISCONNECTED,      \
+        .pselrxd            = NRF_UART_PSEL_DISCONNECTED,      \
+        .pselcts            = NRF_UART_PSEL_DISCONNECTED,      \
+        .pselrts            = NRF_UART_PSEL_DISCONNECTED,      \
+        .p_context          = NULL,                            \
+        .hwfc               = UART_CONFIG_HWFC_Disabled,       \
+        .parity             = 0,                               \
+        .baudrate           = UARTE_BAUDRATE_BAUDRATE_Baud115200, \
+        .interrupt_priority = UART_DEFAULT_CONFIG_IRQ_PRIORITY, \
+        .use_easy_dma       = true,                            \
+    }
+
+typedef enum
+{
+    NRF_DRV_UART_EVT_TX_DONE,
+    NRF_DRV_UART_EVT_RX_DONE,
+    NRF_DRV_UART_EVT_ERROR,
+} nrf_drv_uart_evt_type_t;
+
+typedef struct
+{
+    uint8_t *p_data;
+    uint8_t bytes;
+} nrf_drv_uart_xfer_evt_t;
+
+typedef struct
+{
+    nrf_drv_uart_xfer_evt_t rxtx;
+    uint32_t error_mask;
+} nrf_drv_uart_error_evt_t;
+
+typedef struct
+{
+    nrf_drv_uart_evt_type_t type;
+    union
+    {
+        nrf_drv_uart_xfer_evt_t rxtx;
+        nrf_drv_uart_error_evt_t error;
+    } data;
+} nrf_drv_uart_event_t;
+
+typedef void (*nrf_uart_event_handler_t)(nrf_drv_uart_event_t *p_event, void *p_context);
+
+ret_code_t nrf_drv_uart_init(nrf_drv_uart_t const *p_instance, nrf_drv_uart_config_t const *p_config,
+                             nrf_uart_event_handler_t event_handler);
+void nrf_drv_uart_uninit(nrf_drv_uart_t const *p_instance);
+ret_code_t nrf_drv_uart_tx(nrf_drv_uart_t const *p_instance, uint8_t const * const p_data, uint8_t length);
+bool nrf_drv_uart_tx_in_progress(nrf_drv_uart_t const *p_instance);
+ret_code_t nrf_drv_uart_rx(nrf_drv_uart_t const *p_instance, uint8_t *p_data, uint8_t length);
+void nrf_drv_uart_rx_enable(nrf_drv_uart_t const *p_instance);
+void nrf_drv_uart_rx_disable(nrf_drv_uart_t const *p_instance);
+void nrf_drv_uart_rx_abort(nrf_drv_uart_t const *p_instance);
+
+/* the simulator only functions of the UARTE model */
+void sim_uarte_set_tx_handler(void (*handler)(uint8_t byte));
+void sim_uarte_set_latency(uint32_t max_us);
+void sim_uarte_rx_inject(const void *buf, size_t size);
+uint32_t sim_uarte_irq_count(void);
+uint32_t sim_uarte_overrun_count(void);
+
+#endif /* SIM_NRF_DRV_UART_H */
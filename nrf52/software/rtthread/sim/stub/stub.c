@@ -0,0 +1,90 @@
+/*
+ * The nRF5 SDK board support and CmBacktrace stub for RT-Thread POSIX host simulator.
+ */
+
+#include <rtthread.h>
+
+#include <execinfo.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "boards.h"
+#include "cm_backtrace.h"
+#include "nrf_delay.h"
+
+#define CMB_CALL_STACK_MAX_DEPTH       32
+
+static uint8_t led_state[LEDS_NUMBER];
+static const char *fw_name, *hw_ver, *sw_ver;
+
+void bsp_board_leds_init(void)
+{
+}
+
+void bsp_board_led_invert(uint32_t led_idx)
+{
+    if (led_idx < LEDS_NUMBER)
+    {
+        led_state[led_idx] = !led_state[led_idx];
+    }
+}
+
+uint32_t bsp_board_led_state_get(uint32_t led_idx)
+{
+    return led_idx < LEDS_NUMBER ? led_state[led_idx] : 0;
+}
+
+void nrf_delay_us(uint32_t number_of_us)
+{
+    usleep(number_of_us);
+}
+
+void nrf_delay_ms(uint32_t number_of_ms)
+{
+    usleep(number_of_ms * 1000);
+}
+
+uintptr_t cmb_get_sp(void)
+{
+    /* r0-r3, r12, lr, pc, psr and the stacked registers by fault handler */
+    static uint32_t exception_stack_frame[16];
+
+    return (uintptr_t)exception_stack_frame;
+}
+
+void cm_backtrace_init(const char *firmware_name, const char *hardware_ver, const char *software_ver)
+{
+    fw_name = firmware_name;
+    hw_ver = hardware_ver;
+    sw_ver = software_ver;
+}
+
+void cm_backtrace_firmware_info(void)
+{
+    rt_kprintf("Firmware name: %s, hardware version: %s, software version: %s\n", fw_name, hw_ver, sw_ver);
+}
+
+static void cm_backtrace_call_stack(void)
+{
+    void *call_stack[CMB_CALL_STACK_MAX_DEPTH];
+    int depth;
+
+    rt_kprintf("Call stack of the simulator:\n");
+    fflush(stdout);
+    depth = backtrace(call_stack, CMB_CALL_STACK_MAX_DEPTH);
+    backtrace_symbols_fd(call_stack, depth, STDOUT_FILENO);
+}
+
+void cm_backtrace_assert(uintptr_t sp)
+{
+    cm_backtrace_firmware_info();
+    rt_kprintf("Assert on thread %s\n", rt_thread_self()->name);
+    cm_backtrace_call_stack();
+}
+
+void cm_backtrace_fault(uint32_t fault_handler_lr, uintptr_t fault_handler_sp)
+{
+    cm_backtrace_firmware_info();
+    rt_kprintf("Fault on thread %s\n", rt_thread_self()->name);
+    cm_backtrace_call_stack();
+}